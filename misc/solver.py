@@ -76,13 +76,16 @@ for group_index in range(0, len(groups), cpu_cores):
         input_file = group["input_file"]
         output_file = group["output_file"]
 
-        # Ensure the output file does not exist
+        # Build the solver arguments
+        arguments = [solver_file, input_file, output_file]
+
+        # Improve on the existing output (It is only overwritten if the new cut is strictly smaller)
         if output_file.is_file():
-            print(f"Output file {output_file} already exists")
-            continue
+            print(f"Output file {output_file} already exists, improving on it")
+            arguments += ["--initial", output_file]
 
         # Spawn the solver process
-        process = Popen([solver_file, input_file, output_file], stdout=PIPE, stderr=PIPE)
+        process = Popen(arguments, stdout=PIPE, stderr=PIPE)
 
         # Update the group
         group["solver_process"] = process
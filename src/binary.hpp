@@ -0,0 +1,163 @@
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Little-endian binary data builder
+ */
+struct binary_writer_s
+{
+  /**
+   * @brief The data
+   */
+  std::vector<uint8_t> bytes;
+
+  /**
+   * @brief Append an integer
+   * @param value The integer
+   * @param width The number of bytes
+   */
+  void add(const uint64_t value, const std::size_t width)
+  {
+    for (std::size_t byte = 0; byte < width; byte++)
+    {
+      bytes.push_back((uint8_t)(value >> (8 * byte)));
+    }
+  }
+
+  /**
+   * @brief Append a double
+   * @param value The double
+   */
+  void add_double(const double value)
+  {
+    add(std::bit_cast<uint64_t>(value), 8);
+  }
+
+  /**
+   * @brief Append a length-prefixed string
+   * @param value The string
+   */
+  void add_string(const std::string &value)
+  {
+    add(value.size(), 8);
+    bytes.insert(bytes.end(), value.begin(), value.end());
+  }
+
+  /**
+   * @brief Append a length-prefixed vector of integers
+   * @tparam T The integer type (Written with its own width)
+   * @param values The integers
+   */
+  template <typename T>
+  void add_vector(const std::vector<T> &values)
+  {
+    add(values.size(), 8);
+    bytes.reserve(bytes.size() + values.size() * sizeof(T));
+    for (const auto value : values)
+    {
+      add((uint64_t)value, sizeof(T));
+    }
+  }
+};
+
+/**
+ * @brief Little-endian binary data parser (Throws std::runtime_error on truncated or oversized fields)
+ */
+struct binary_reader_s
+{
+  /**
+   * @brief The data
+   */
+  const std::vector<uint8_t> &bytes;
+
+  /**
+   * @brief The position of the next unread byte
+   */
+  std::size_t position = 0;
+
+  /**
+   * @brief Read an integer
+   * @param width The number of bytes
+   * @return The integer
+   */
+  uint64_t take(const std::size_t width)
+  {
+    if (bytes.size() - position < width)
+    {
+      throw std::runtime_error("Malformed binary data");
+    }
+
+    uint64_t value = 0;
+    for (std::size_t byte = 0; byte < width; byte++)
+    {
+      value |= (uint64_t)bytes[position++] << (8 * byte);
+    }
+
+    return value;
+  }
+
+  /**
+   * @brief Read a double
+   * @return The double
+   */
+  double take_double()
+  {
+    return std::bit_cast<double>(take(8));
+  }
+
+  /**
+   * @brief Read a length-prefixed string
+   * @return The string
+   */
+  std::string take_string()
+  {
+    const auto size = take(8);
+    if (bytes.size() - position < size)
+    {
+      throw std::runtime_error("Malformed binary data");
+    }
+
+    std::string value(bytes.begin() + (std::ptrdiff_t)position, bytes.begin() + (std::ptrdiff_t)(position + size));
+    position += size;
+    return value;
+  }
+
+  /**
+   * @brief Read a length-prefixed vector of integers
+   * @tparam T The integer type (Read with its own width)
+   * @return The integers
+   */
+  template <typename T>
+  std::vector<T> take_vector()
+  {
+    const auto size = take(8);
+    if ((bytes.size() - position) / sizeof(T) < size)
+    {
+      throw std::runtime_error("Malformed binary data");
+    }
+
+    std::vector<T> values(size);
+    for (auto &value : values)
+    {
+      value = (T)take(sizeof(T));
+    }
+
+    return values;
+  }
+
+  /**
+   * @brief Check that all the data was read
+   */
+  void finish() const
+  {
+    if (position != bytes.size())
+    {
+      throw std::runtime_error("Malformed binary data");
+    }
+  }
+};
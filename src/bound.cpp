@@ -0,0 +1,134 @@
+#include <algorithm>
+#include <vector>
+
+#include "bound.hpp"
+
+/**
+ * @brief Check if a graph has an edge
+ * @param graph The graph
+ * @param source The source vertex
+ * @param target The target vertex
+ * @return True if the edge exists, false otherwise
+ */
+static bool has_edge(const csr_graph_s &graph, const csr_index_t source, const csr_index_t target)
+{
+  const auto first = graph.out_targets.begin() + graph.out_offsets[source];
+  const auto last = graph.out_targets.begin() + graph.out_offsets[source + 1];
+  return std::binary_search(first, last, target);
+}
+
+std::size_t cycle_packing_bound(const csr_graph_s &graph)
+{
+  const auto numVertices = graph.num_vertices();
+
+  // Vertices which are packed, or on no remaining cycle
+  std::vector<uint8_t> used(numVertices, 0);
+  std::size_t cycles = 0;
+
+  // Pack self-loops and 2-cycles
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    if (has_edge(graph, vertex, vertex))
+    {
+      used[vertex] = 1;
+      cycles++;
+    }
+  }
+
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1] && !used[vertex]; edge++)
+    {
+      const auto target = graph.out_targets[edge];
+      if (!used[target] && has_edge(graph, target, vertex))
+      {
+        used[vertex] = 1;
+        used[target] = 1;
+        cycles++;
+      }
+    }
+  }
+
+  // Pack triangles
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1] && !used[vertex]; edge++)
+    {
+      const auto middle = graph.out_targets[edge];
+      if (used[middle])
+      {
+        continue;
+      }
+
+      for (auto middleEdge = graph.out_offsets[middle]; middleEdge < graph.out_offsets[middle + 1]; middleEdge++)
+      {
+        const auto last = graph.out_targets[middleEdge];
+        if (!used[last] && has_edge(graph, last, vertex))
+        {
+          used[vertex] = 1;
+          used[middle] = 1;
+          used[last] = 1;
+          cycles++;
+          break;
+        }
+      }
+    }
+  }
+
+  // Pack the shortest remaining cycle through each vertex
+  std::vector<csr_index_t> parent(numVertices);
+  std::vector<std::size_t> visited(numVertices, 0);
+  std::vector<csr_index_t> queue;
+  queue.reserve(numVertices);
+
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    if (used[vertex])
+    {
+      continue;
+    }
+
+    // Breadth-first search over the unused vertices until an edge returns to the vertex
+    const auto stamp = (std::size_t)vertex + 1;
+    queue.assign(1, vertex);
+    visited[vertex] = stamp;
+
+    bool found = false;
+    csr_index_t closing = vertex;
+    for (std::size_t head = 0; head < queue.size() && !found; head++)
+    {
+      const auto current = queue[head];
+      for (auto edge = graph.out_offsets[current]; edge < graph.out_offsets[current + 1]; edge++)
+      {
+        const auto target = graph.out_targets[edge];
+        if (target == vertex)
+        {
+          found = true;
+          closing = current;
+          break;
+        }
+
+        if (!used[target] && visited[target] != stamp)
+        {
+          visited[target] = stamp;
+          parent[target] = current;
+          queue.push_back(target);
+        }
+      }
+    }
+
+    // Pack the cycle, or retire the vertex if it is on no remaining cycle
+    used[vertex] = 1;
+    if (found)
+    {
+      for (auto member = closing; member != vertex; member = parent[member])
+      {
+        used[member] = 1;
+      }
+
+      cycles++;
+    }
+  }
+
+  return cycles;
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstddef>
+
+#include "csr.hpp"
+
+/**
+ * @brief Compute a lower bound on the size of a feedback vertex set by greedily packing vertex-disjoint cycles
+ * @param graph The graph
+ * @return The number of packed cycles (Every feedback vertex set cuts at least one vertex of each)
+ * @note Packs self-loops, then 2-cycles, then triangles, then the shortest remaining cycle through each vertex found
+ * with a breadth-first search. A vertex whose search finds no cycle is never searched through again, since the
+ * remaining graph only shrinks
+ */
+std::size_t cycle_packing_bound(const csr_graph_s &graph);
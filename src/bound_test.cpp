@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "bound.hpp"
+#include "exact.hpp"
+#include "test_graphs.hpp"
+
+TEST(cycle_packing_bound, sample)
+{
+  // Assert both cycles share vertex 1
+  ASSERT_EQ(cycle_packing_bound(build_sample_csr()), 1);
+}
+
+TEST(cycle_packing_bound, disjoint_cycles)
+{
+  // Build a self-loop, a 2-cycle, a triangle and a 5-cycle, linked by one-way edges
+  const auto graph = build_graph(11, {{1, 1}, {1, 2}, {2, 3}, {3, 2}, {3, 4}, {4, 5}, {5, 6}, {6, 4}, {6, 7}, {7, 8}, {8, 9}, {9, 10}, {10, 11}, {11, 7}});
+
+  // Assert every cycle is packed
+  ASSERT_EQ(cycle_packing_bound(graph), 4);
+}
+
+TEST(cycle_packing_bound, complete)
+{
+  // Build a complete graph
+  std::vector<std::pair<std::size_t, std::size_t>> edges;
+  for (std::size_t source = 1; source <= 5; source++)
+  {
+    for (std::size_t target = 1; target <= 5; target++)
+    {
+      if (source != target)
+      {
+        edges.emplace_back(source, target);
+      }
+    }
+  }
+
+  // Assert two 2-cycles fit
+  ASSERT_EQ(cycle_packing_bound(build_graph(5, edges)), 2);
+}
+
+TEST(cycle_packing_bound, below_optimum)
+{
+  for (uint64_t seed = 0; seed < 20; seed++)
+  {
+    // Build a random graph
+    const auto graph = build_random(40, 120, seed);
+
+    // Assert the bound never exceeds the optimum
+    const auto optimum = solve_exact(graph, 1000000);
+    ASSERT_TRUE(optimum.has_value());
+    ASSERT_LE(cycle_packing_bound(graph), optimum->size());
+  }
+}
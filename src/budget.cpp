@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <cstdint>
+
+#include "budget.hpp"
+
+std::size_t budget_planner_s::weight(const std::size_t size, const std::size_t edges) const
+{
+  return size <= cheap_threshold ? 0 : size + edges;
+}
+
+std::size_t budget_planner_s::available_steps() const
+{
+  if (seconds == 0)
+  {
+    return remaining_steps;
+  }
+
+  // Set aside the work outside the simulations of the components left, then convert the seconds left at the simulation rate observed so far
+  const auto overhead = recorded_weight == 0 ? 0.0 : overhead_seconds * ((double)remaining_weight / (double)recorded_weight);
+  const auto rate = observed_seconds == 0 ? BUDGET_INITIAL_RATE : (double)observed_steps / observed_seconds;
+  const auto secondsSteps = std::max(seconds - elapsed_seconds - overhead, 0.0) * rate;
+
+  return secondsSteps < (double)remaining_steps ? (std::size_t)secondsSteps : remaining_steps;
+}
+
+solver_options_s budget_planner_s::plan(const std::size_t size, const std::size_t weight, const solver_options_s &options) const
+{
+  auto planned = options;
+
+  // Hand small components to the degree engine
+  if (size <= cheap_threshold)
+  {
+    planned.traffic_engine = traffic_engine_e::degree;
+    return planned;
+  }
+
+  // Take the component's share of the remaining budget
+  const auto available = available_steps();
+  const auto share = remaining_weight <= weight ? (double)available : (double)available * ((double)weight / (double)remaining_weight);
+
+  // Walk at most one agent per vertex, and as many batches as the share allows
+  planned.simulation.agents = std::clamp<std::size_t>(size, 1, std::max<std::size_t>(options.simulation.agents, 1));
+  const auto batchSteps = (double)planned.simulation.agents * (double)std::max<std::size_t>(options.simulation.steps, 1);
+  planned.simulation.batches = std::max<std::size_t>((std::size_t)std::min(share / batchSteps, (double)SIZE_MAX / 2), 1);
+
+  return planned;
+}
+
+void budget_planner_s::record(const std::size_t weight, const std::size_t steps, const double walk_duration, const double duration)
+{
+  remaining_weight -= std::min(weight, remaining_weight);
+  elapsed_seconds += duration;
+
+  // Only budgeted components tell the cost of the work outside the simulations
+  if (weight != 0)
+  {
+    recorded_weight += weight;
+    overhead_seconds += std::max(duration - walk_duration, 0.0);
+  }
+
+  if (remaining_steps != SIZE_MAX)
+  {
+    remaining_steps -= std::min(steps, remaining_steps);
+  }
+
+  // Only simulated components tell the rate
+  if (steps != 0)
+  {
+    observed_steps += steps;
+    observed_seconds += walk_duration;
+  }
+}
+
+budget_planner_s make_budget_planner(const std::size_t steps, const double seconds, const std::size_t total_weight, const std::size_t cheap_threshold)
+{
+  return budget_planner_s{steps == 0 ? SIZE_MAX : steps, seconds, 0, total_weight, cheap_threshold, 0, 0, 0, 0};
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstddef>
+
+#include "solve.hpp"
+
+/**
+ * @brief The number of counted random walk steps per second assumed before any simulation has been timed
+ */
+#define BUDGET_INITIAL_RATE 50000000.0
+
+/**
+ * @brief Splits a global random walk budget across the components as they are solved
+ */
+struct budget_planner_s
+{
+  /**
+   * @brief The number of counted steps left (SIZE_MAX if only the time is limited)
+   */
+  std::size_t remaining_steps;
+
+  /**
+   * @brief The total number of seconds (0 if only the steps are limited)
+   */
+  double seconds;
+
+  /**
+   * @brief The number of seconds spent on the recorded components
+   */
+  double elapsed_seconds;
+
+  /**
+   * @brief The summed weight of the budgeted components which are not recorded yet
+   */
+  std::size_t remaining_weight;
+
+  /**
+   * @brief The number of vertices at or below which a component takes the degree engine instead of a share of the budget
+   */
+  std::size_t cheap_threshold;
+
+  /**
+   * @brief The number of counted steps simulated so far
+   */
+  std::size_t observed_steps;
+
+  /**
+   * @brief The number of seconds the simulations of the simulated components took
+   */
+  double observed_seconds;
+
+  /**
+   * @brief The summed weight of the recorded budgeted components
+   */
+  std::size_t recorded_weight;
+
+  /**
+   * @brief The number of seconds the recorded budgeted components spent outside their simulations (The bound, the
+   * degree cut and the filter)
+   */
+  double overhead_seconds;
+
+  /**
+   * @brief Get the weight of a component
+   * @param size The number of vertices
+   * @param edges The number of edges within the component
+   * @return The weight (0 if the component takes the degree engine)
+   */
+  std::size_t weight(const std::size_t size, const std::size_t edges) const;
+
+  /**
+   * @brief Get the number of counted steps the rest of the budget allows (Seconds are converted at the observed
+   * simulation rate, after setting aside the work outside the simulations at its observed cost per weight)
+   * @return The number of steps
+   */
+  std::size_t available_steps() const;
+
+  /**
+   * @brief Size the simulation of a component from its share of the remaining budget
+   * @param size The number of vertices
+   * @param weight The weight
+   * @param options The solver options (The agents and steps are upper bounds; the batches are ignored)
+   * @return The solver options for the component (The degree engine if the component is at most cheap_threshold
+   * vertices; otherwise at most one agent per vertex and as many batches as the share allows, at least one)
+   */
+  solver_options_s plan(const std::size_t size, const std::size_t weight, const solver_options_s &options) const;
+
+  /**
+   * @brief Record a solved component, returning its unused share to the components after it
+   * @param weight The weight
+   * @param steps The number of counted steps its simulation took (Fewer than planned if it terminated early)
+   * @param walk_duration The number of seconds its simulation took
+   * @param duration The number of seconds it took in total
+   */
+  void record(const std::size_t weight, const std::size_t steps, const double walk_duration, const double duration);
+};
+
+/**
+ * @brief Create a budget planner
+ * @param steps The total number of counted steps (0 to only limit the time)
+ * @param seconds The total number of seconds (0 to only limit the steps)
+ * @param total_weight The summed weight of the components
+ * @param cheap_threshold The number of vertices at or below which a component takes the degree engine
+ * @return The planner
+ */
+budget_planner_s make_budget_planner(const std::size_t steps, const double seconds, const std::size_t total_weight, const std::size_t cheap_threshold);
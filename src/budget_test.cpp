@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "budget.hpp"
+#include "test_graphs.hpp"
+
+TEST(budget_planner, steps)
+{
+  // Build a planner for 1000000 steps over components of weight 300 and 100
+  auto planner = make_budget_planner(1000000, 0, 0, 16);
+  const auto options = solver_options_s{simulation_options_s{100, 100, 250, 0.0, 0, 0, 1}, 0, 1000};
+  const auto largeWeight = planner.weight(100, 200);
+  const auto smallWeight = planner.weight(50, 50);
+  planner.remaining_weight = largeWeight + smallWeight;
+
+  // Assert small components take the degree engine and weigh nothing
+  ASSERT_EQ(planner.weight(16, 40), 0);
+  ASSERT_EQ(planner.plan(16, 0, options).traffic_engine, traffic_engine_e::degree);
+
+  // Assert the budget is split by weight (750000 steps of 100 agents x 100 steps)
+  const auto large = planner.plan(100, largeWeight, options);
+  ASSERT_EQ(large.traffic_engine, traffic_engine_e::walk);
+  ASSERT_EQ(large.simulation.agents, 100);
+  ASSERT_EQ(large.simulation.steps, 100);
+  ASSERT_EQ(large.simulation.batches, 75);
+
+  // Assert the steps the large component leaves unused go to the small one (At most one agent per vertex)
+  planner.record(largeWeight, 250000, 1, 1);
+  const auto small = planner.plan(50, smallWeight, options);
+  ASSERT_EQ(small.simulation.agents, 50);
+  ASSERT_EQ(small.simulation.batches, 150);
+
+  // Assert an exhausted budget still simulates one batch
+  planner.record(smallWeight, 750000, 1, 1);
+  ASSERT_EQ(planner.available_steps(), 0);
+  ASSERT_EQ(planner.plan(50, smallWeight, options).simulation.batches, 1);
+}
+
+TEST(budget_planner, seconds)
+{
+  // Build a planner for 10 seconds
+  auto planner = make_budget_planner(0, 10, 100, 0);
+
+  // Assert the initial rate is assumed until a simulation is timed
+  ASSERT_EQ(planner.available_steps(), (std::size_t)(10 * BUDGET_INITIAL_RATE));
+
+  // Assert the seconds left are converted at the simulation rate after setting aside the work outside the simulations
+  // of the components left (1 second per weight of 50), and components which were not simulated only spend time
+  planner.record(0, 0, 0, 1);
+  planner.record(50, 2000, 1, 2);
+  ASSERT_EQ(planner.available_steps(), 12000);
+  ASSERT_EQ(planner.plan(10, 50, solver_options_s{simulation_options_s{10, 10, 250, 0.0, 0, 0, 1}, 0, 1000}).simulation.batches, 120);
+
+  // Assert a step limit caps the seconds
+  auto capped = make_budget_planner(500, 10, 100, 0);
+  capped.record(50, 100, 1, 1);
+  ASSERT_EQ(capped.available_steps(), 400);
+}
+
+TEST(budget_planner, walk_steps)
+{
+  // Solve a large component with its planned share
+  const auto component = build_random_component(600, 2400, 4);
+  ASSERT_LT(200, component.num_vertices());
+
+  auto planner = make_budget_planner(100000, 0, 0, 16);
+  const auto weight = planner.weight(component.num_vertices(), component.num_edges());
+  planner.remaining_weight = weight;
+  const auto options = planner.plan(component.num_vertices(), weight, solver_options_s{simulation_options_s{32, 64, 250, 0.0, 0, 0, 2}, 0, 1000});
+  const auto solution = solve_component(component, options, std::nullopt);
+
+  // Assert the simulation counted exactly the planned steps (No early termination at a change threshold of 0)
+  ASSERT_EQ(options.simulation.batches, 48);
+  ASSERT_EQ(solution.walk_steps, 100000 / (32 * 64) * 32 * 64);
+  ASSERT_LT(0, solution.walk_seconds);
+}
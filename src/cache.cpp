@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <bit>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <unistd.h>
+
+#include "cache.hpp"
+#include "filter.hpp"
+
+/**
+ * @brief Add the local edge structure of a component to a hash
+ * @param hash The hash
+ * @param component The component
+ */
+static void add_structure(cache_hash_s &hash, const csr_graph_s &component)
+{
+  hash.add(component.num_vertices());
+  hash.add(component.num_edges());
+  for (const auto offset : component.out_offsets)
+  {
+    hash.add(offset);
+  }
+
+  for (const auto target : component.out_targets)
+  {
+    hash.add(target);
+  }
+}
+
+uint64_t structure_hash(const csr_graph_s &component)
+{
+  cache_hash_s hash;
+  add_structure(hash, component);
+
+  return hash.lanes[0];
+}
+
+std::string cache_key(const csr_graph_s &component, const solver_options_s &options)
+{
+  cache_hash_s hash;
+  hash.add(CACHE_VERSION);
+
+  // Hash the options
+  const auto &simulation = options.simulation;
+  hash.add(simulation.agents);
+  hash.add(simulation.steps);
+  hash.add(simulation.batches);
+  hash.add(std::bit_cast<uint64_t>(simulation.change_threshold));
+  hash.add(simulation.seed);
+  hash.add((uint64_t)simulation.stop_mode);
+  hash.add(std::bit_cast<uint64_t>(simulation.rank_correlation));
+  hash.add(simulation.stable_batches);
+  hash.add((uint64_t)simulation.start_mode);
+  hash.add(simulation.burn_in);
+  hash.add(std::bit_cast<uint64_t>(simulation.teleport));
+  hash.add(simulation.antithetic);
+  hash.add(options.exact_threshold);
+  hash.add(options.exact_node_limit);
+  hash.add((uint64_t)options.traffic_engine);
+  hash.add(options.cycle_samples);
+  hash.add((uint64_t)options.degree_score);
+  hash.add((uint64_t)options.strategy);
+  hash.add(options.divide_threshold);
+  hash.add(std::bit_cast<uint64_t>(options.divide_fraction));
+
+  // Hash the structure
+  add_structure(hash, component);
+
+  return hash.hex();
+}
+
+/**
+ * @brief Read local indices from a cache entry
+ * @param input The entry
+ * @param count The number of indices
+ * @param numVertices The number of vertices
+ * @return The indices, or nothing if one is missing or out of range
+ */
+static std::optional<std::vector<csr_index_t>> read_indices(std::istream &input, const std::size_t count, const std::size_t numVertices)
+{
+  std::vector<csr_index_t> indices(count);
+  for (auto &vertex : indices)
+  {
+    std::size_t index;
+    if (!(input >> index) || numVertices <= index)
+    {
+      return std::nullopt;
+    }
+
+    vertex = (csr_index_t)index;
+  }
+
+  return indices;
+}
+
+std::optional<cache_entry_s> load_cached_cut(const std::filesystem::path &directory, const std::string &key, const csr_graph_s &component)
+{
+  std::ifstream input(directory / (key + ".txt"));
+  if (!input.is_open())
+  {
+    return std::nullopt;
+  }
+
+  // Read the shape (Guards against hash collisions)
+  std::size_t numVertices;
+  std::size_t numEdges;
+  std::size_t numCut;
+  std::size_t lowerBound;
+  std::size_t numOrder;
+  if (!(input >> numVertices >> numEdges >> numCut >> lowerBound >> numOrder) || numVertices != component.num_vertices() || numEdges != component.num_edges() || numVertices < numCut || numCut < lowerBound || (numOrder != 0 && numOrder != numVertices))
+  {
+    return std::nullopt;
+  }
+
+  // Read the cut and the order
+  auto cut = read_indices(input, numCut, numVertices);
+  auto order = read_indices(input, numOrder, numVertices);
+  if (!cut || !order)
+  {
+    return std::nullopt;
+  }
+
+  // Verify the cut
+  if (!std::is_sorted(cut->begin(), cut->end()) || std::adjacent_find(cut->begin(), cut->end()) != cut->end() || !is_acyclic_without(component, *cut))
+  {
+    return std::nullopt;
+  }
+
+  // Verify the order visits every vertex once
+  std::vector<uint8_t> seen(numVertices, 0);
+  for (const auto vertex : *order)
+  {
+    if (seen[vertex]++)
+    {
+      return std::nullopt;
+    }
+  }
+
+  return cache_entry_s{std::move(*cut), std::move(*order), lowerBound};
+}
+
+bool store_cached_cut(const std::filesystem::path &directory, const std::string &key, const csr_graph_s &component, const cache_entry_s &entry)
+{
+  // Write to a temporary file unique to this process and thread
+  std::ostringstream temporaryName;
+  temporaryName << key << "." << getpid() << "." << std::hash<std::thread::id>()(std::this_thread::get_id()) << ".tmp";
+  const auto temporaryPath = directory / temporaryName.str();
+
+  try
+  {
+    {
+      std::ofstream output(temporaryPath);
+      output << component.num_vertices() << " " << component.num_edges() << " " << entry.cut.size() << " " << entry.lower_bound << " " << entry.order.size() << std::endl;
+      for (const auto *indices : {&entry.cut, &entry.order})
+      {
+        for (std::size_t index = 0; index < indices->size(); index++)
+        {
+          output << (*indices)[index] << (index + 1 < indices->size() ? " " : "");
+        }
+
+        output << std::endl;
+      }
+
+      if (!output)
+      {
+        throw std::runtime_error("Failed to write the cache entry: " + temporaryPath.string());
+      }
+    }
+
+    // Publish the entry
+    std::filesystem::rename(temporaryPath, directory / (key + ".txt"));
+  }
+  catch (const std::exception &error)
+  {
+    // Leave the cache as it was (The cut is still returned to the caller)
+    std::cerr << "Warning: " << error.what() << std::endl;
+
+    std::error_code removeError;
+    std::filesystem::remove(temporaryPath, removeError);
+    return false;
+  }
+
+  return true;
+}
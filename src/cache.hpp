@@ -0,0 +1,131 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <filesystem>
+#include <iomanip>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "csr.hpp"
+#include "solve.hpp"
+
+/**
+ * @brief The cache format version (Mixed into every key, so bumping it invalidates old entries)
+ */
+#define CACHE_VERSION 5
+
+/**
+ * @brief Two-lane 128-bit hash of a word sequence
+ */
+struct cache_hash_s
+{
+  /**
+   * @brief The lanes
+   */
+  std::array<uint64_t, 2> lanes = {0x243f6a8885a308d3, 0x13198a2e03707344};
+
+  /**
+   * @brief Finalize a word (SplitMix64)
+   * @param value The word
+   * @return The mixed word
+   */
+  static uint64_t mix(uint64_t value)
+  {
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+    return value ^ (value >> 31);
+  }
+
+  /**
+   * @brief Add a word to the hash
+   * @param word The word
+   */
+  void add(const uint64_t word)
+  {
+    lanes[0] = mix(lanes[0] + word);
+    lanes[1] = mix(lanes[1] ^ (word * 0x9e3779b97f4a7c15));
+  }
+
+  /**
+   * @brief Format the hash
+   * @return The lanes as 32 hexadecimal digits
+   */
+  std::string hex() const
+  {
+    std::ostringstream digits;
+    digits << std::hex << std::setfill('0') << std::setw(16) << lanes[0] << std::setw(16) << lanes[1];
+    return digits.str();
+  }
+};
+
+/**
+ * @brief A cached component cut with the lower bound and traffic order it was found with
+ */
+struct cache_entry_s
+{
+  /**
+   * @brief The local indices of the vertices to cut in ascending order
+   */
+  std::vector<csr_index_t> cut;
+
+  /**
+   * @brief The local indices of the vertices in ascending traffic order (Used to warm start other cuts the same way as
+   * when the entry was stored; empty if the engine did not run)
+   */
+  std::vector<csr_index_t> order;
+
+  /**
+   * @brief The cycle packing lower bound of the component
+   */
+  std::size_t lower_bound = 0;
+
+  /**
+   * @brief Compare two entries
+   * @param other The other entry
+   * @return True if the cuts and orders are equal, false otherwise
+   */
+  bool operator==(const cache_entry_s &other) const = default;
+};
+
+/**
+ * @brief Hash the local edge structure of a component
+ * @param component The component
+ * @return The hash (Independent of the vertex numbers)
+ */
+uint64_t structure_hash(const csr_graph_s &component);
+
+/**
+ * @brief Compute the cache key of a component
+ * @param component The component
+ * @param options The solver options (Every option which affects the cut, but not the number of threads)
+ * @return The key (32 hexadecimal digits)
+ * @note The key hashes the local edge structure (Vertices in ascending number order), not the vertex numbers, so the
+ * same structure found in another input shares the entry (Its random streams are keyed by structure_hash, so the entry
+ * matches an uncached solve)
+ */
+std::string cache_key(const csr_graph_s &component, const solver_options_s &options);
+
+/**
+ * @brief Load a cut from the cache
+ * @param directory The cache directory
+ * @param key The cache key
+ * @param component The component
+ * @return The entry, or nothing if the entry is missing or malformed, its cut does not leave the component acyclic or is
+ * smaller than its lower bound, or its order is neither empty nor a permutation of the vertices
+ */
+std::optional<cache_entry_s> load_cached_cut(const std::filesystem::path &directory, const std::string &key, const csr_graph_s &component);
+
+/**
+ * @brief Store a cut in the cache (Written to a temporary file and renamed, so concurrent readers never see a partial
+ * entry)
+ * @param directory The cache directory
+ * @param key The cache key
+ * @param component The component
+ * @param entry The cut, lower bound and traffic order
+ * @return True if the entry was stored, false if it could not be written (A warning is printed and the temporary file
+ * is removed; the cache is best-effort, so the solve continues)
+ */
+bool store_cached_cut(const std::filesystem::path &directory, const std::string &key, const csr_graph_s &component, const cache_entry_s &entry);
@@ -0,0 +1,116 @@
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "cache.hpp"
+#include "test_graphs.hpp"
+
+/**
+ * @brief Create an empty cache directory
+ * @param name The test name
+ * @return The directory
+ */
+static std::filesystem::path make_directory(const std::string &name)
+{
+  const auto directory = std::filesystem::temp_directory_path() / ("algobowl-cache-test-" + name);
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+
+  return directory;
+}
+
+/**
+ * @brief Build solver options
+ * @param seed The random seed
+ * @return The solver options
+ */
+static solver_options_s build_options(const uint64_t seed)
+{
+  return solver_options_s{simulation_options_s{16, 16, 4, 0.0, seed, 0, 1}, 0, 1000};
+}
+
+TEST(cache_key, distinguishes)
+{
+  // Build the graph and a copy with a reversed edge
+  const auto graph = build_sample_csr();
+  auto other = graph;
+  other.out_targets[0] = 0;
+
+  // Assert the key depends on the structure and the options, but not the number of threads
+  const auto key = cache_key(graph, build_options(0));
+  ASSERT_EQ(key.size(), 32);
+  ASSERT_EQ(cache_key(graph, build_options(0)), key);
+  ASSERT_NE(cache_key(graph, build_options(1)), key);
+  ASSERT_NE(cache_key(other, build_options(0)), key);
+
+  auto threaded = build_options(0);
+  threaded.simulation.threads = 8;
+  ASSERT_EQ(cache_key(graph, threaded), key);
+}
+
+TEST(cached_cut, round_trip)
+{
+  // Build the graph
+  const auto directory = make_directory("round-trip");
+  const auto graph = build_sample_csr();
+  const auto key = cache_key(graph, build_options(0));
+
+  // Assert the entry is missing, then store and load it
+  ASSERT_FALSE(load_cached_cut(directory, key, graph).has_value());
+
+  const cache_entry_s entry{{0}, {4, 2, 0, 1, 3}, 1};
+  ASSERT_TRUE(store_cached_cut(directory, key, graph, entry));
+  ASSERT_EQ(load_cached_cut(directory, key, graph), entry);
+
+  // Assert an entry without an order (The engine did not run) round-trips too
+  const cache_entry_s unordered{{0}, {}, 1};
+  ASSERT_TRUE(store_cached_cut(directory, key, graph, unordered));
+  ASSERT_EQ(load_cached_cut(directory, key, graph), unordered);
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST(cached_cut, write_failure)
+{
+  // Build the graph
+  const auto directory = make_directory("write-failure");
+  const auto graph = build_sample_csr();
+  const auto key = cache_key(graph, build_options(0));
+
+  // Assert a missing directory is reported without throwing
+  ASSERT_FALSE(store_cached_cut(directory / "missing", key, graph, cache_entry_s{{0}, {0, 1, 2, 3, 4}}));
+
+  // Assert a failed rename is reported without throwing, and the temporary file is removed
+  std::filesystem::create_directories(directory / (key + ".txt") / "blocked");
+  ASSERT_FALSE(store_cached_cut(directory, key, graph, cache_entry_s{{0}, {0, 1, 2, 3, 4}}));
+  ASSERT_EQ(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()), 1);
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST(cached_cut, rejects_infeasible)
+{
+  // Build the graph
+  const auto directory = make_directory("rejects-infeasible");
+  const auto graph = build_sample_csr();
+  const auto key = cache_key(graph, build_options(0));
+
+  // Assert a cut which leaves a cycle is rejected
+  store_cached_cut(directory, key, graph, cache_entry_s{{1}, {0, 1, 2, 3, 4}});
+  ASSERT_FALSE(load_cached_cut(directory, key, graph).has_value());
+
+  // Assert an order which repeats a vertex is rejected
+  store_cached_cut(directory, key, graph, cache_entry_s{{0}, {0, 1, 2, 3, 3}});
+  ASSERT_FALSE(load_cached_cut(directory, key, graph).has_value());
+
+  // Assert a lower bound above the cut size is rejected
+  store_cached_cut(directory, key, graph, cache_entry_s{{0}, {0, 1, 2, 3, 4}, 2});
+  ASSERT_FALSE(load_cached_cut(directory, key, graph).has_value());
+
+  // Assert a malformed entry is rejected
+  std::ofstream(directory / (key + ".txt")) << "5 6 1 1 5\n9\n";
+  ASSERT_FALSE(load_cached_cut(directory, key, graph).has_value());
+
+  std::filesystem::remove_all(directory);
+}
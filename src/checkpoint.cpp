@@ -0,0 +1,119 @@
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+#include "binary.hpp"
+#include "cache.hpp"
+#include "checkpoint.hpp"
+
+std::string checkpoint_fingerprint(const csr_graph_s &graph, const solver_options_s &options, const std::vector<uint8_t> &initial)
+{
+  cache_hash_s hash;
+
+  // Hash the vertex numbers and the initial cut, which the cache key leaves out
+  hash.add(graph.numbers.size());
+  for (const auto number : graph.numbers)
+  {
+    hash.add(number);
+  }
+
+  hash.add(initial.size());
+  for (std::size_t index = 0; index < initial.size(); index++)
+  {
+    if (initial[index])
+    {
+      hash.add(index);
+    }
+  }
+
+  return cache_key(graph, options) + hash.hex();
+}
+
+bool save_checkpoint(const std::filesystem::path &path, const checkpoint_s &checkpoint)
+{
+  binary_writer_s writer;
+  writer.add(CHECKPOINT_MAGIC, 8);
+  writer.add(CHECKPOINT_VERSION, 4);
+  writer.add_string(checkpoint.fingerprint);
+  writer.add(checkpoint.components, 8);
+  writer.add(checkpoint.lower_bound, 8);
+  writer.add_vector(checkpoint.cut);
+  writer.add(checkpoint.simulation.has_value(), 1);
+
+  if (checkpoint.simulation)
+  {
+    const auto &simulation = *checkpoint.simulation;
+    writer.add(simulation.component, 8);
+    writer.add(simulation.batch, 8);
+    writer.add_vector(simulation.traffic);
+    writer.add_vector(simulation.order);
+    writer.add(simulation.stable_batches, 8);
+  }
+
+  // Write to a temporary file, then replace the checkpoint
+  auto temporaryPath = path;
+  temporaryPath += ".tmp";
+
+  try
+  {
+    {
+      std::ofstream output(temporaryPath, std::ios::binary);
+      output.write((const char *)writer.bytes.data(), (std::streamsize)writer.bytes.size());
+      if (!output)
+      {
+        throw std::runtime_error("Failed to write the checkpoint: " + temporaryPath.string());
+      }
+    }
+
+    std::filesystem::rename(temporaryPath, path);
+  }
+  catch (const std::exception &error)
+  {
+    // Keep the previous checkpoint (The run continues, so a full disk only costs progress)
+    std::cerr << "Warning: " << error.what() << std::endl;
+
+    std::error_code removeError;
+    std::filesystem::remove(temporaryPath, removeError);
+    return false;
+  }
+
+  return true;
+}
+
+checkpoint_s load_checkpoint(const std::filesystem::path &path)
+{
+  std::ifstream input(path, std::ios::binary);
+  if (!input.is_open())
+  {
+    throw std::runtime_error("Failed to open the checkpoint: " + path.string());
+  }
+
+  const std::vector<uint8_t> bytes{std::istreambuf_iterator<char>(input), std::istreambuf_iterator<char>()};
+  binary_reader_s reader{bytes};
+
+  if (reader.take(8) != CHECKPOINT_MAGIC || reader.take(4) != CHECKPOINT_VERSION)
+  {
+    throw std::runtime_error("Not a checkpoint of this version: " + path.string());
+  }
+
+  checkpoint_s checkpoint;
+  checkpoint.fingerprint = reader.take_string();
+  checkpoint.components = reader.take(8);
+  checkpoint.lower_bound = reader.take(8);
+  checkpoint.cut = reader.take_vector<std::size_t>();
+
+  if (reader.take(1) != 0)
+  {
+    simulation_checkpoint_s simulation;
+    simulation.component = reader.take(8);
+    simulation.batch = reader.take(8);
+    simulation.traffic = reader.take_vector<std::size_t>();
+    simulation.order = reader.take_vector<std::size_t>();
+    simulation.stable_batches = reader.take(8);
+    checkpoint.simulation = std::move(simulation);
+  }
+
+  reader.finish();
+  return checkpoint;
+}
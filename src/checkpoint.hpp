@@ -0,0 +1,78 @@
+#pragma once
+
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "csr.hpp"
+#include "simulation.hpp"
+#include "solve.hpp"
+
+/**
+ * @brief The checkpoint file signature
+ */
+#define CHECKPOINT_MAGIC 0x31544e494f504b43
+
+/**
+ * @brief The checkpoint format version
+ */
+#define CHECKPOINT_VERSION 2
+
+/**
+ * @brief Progress of a solver run
+ */
+struct checkpoint_s
+{
+  /**
+   * @brief The fingerprint of the input and options (A resumed run must match it)
+   */
+  std::string fingerprint;
+
+  /**
+   * @brief The number of components solved (In decomposition order)
+   */
+  std::size_t components;
+
+  /**
+   * @brief The sum of the solved components' lower bounds
+   */
+  std::size_t lower_bound;
+
+  /**
+   * @brief The numbers of the vertices cut from the solved components
+   */
+  std::vector<std::size_t> cut;
+
+  /**
+   * @brief The progress of the next component's simulation, if it was interrupted
+   */
+  std::optional<simulation_checkpoint_s> simulation;
+};
+
+/**
+ * @brief Compute the fingerprint of a solver run
+ * @param graph The whole graph
+ * @param options The solver options
+ * @param initial The initial cut flag of each index (Empty if there is no initial cut)
+ * @return The fingerprint (The cache key of the graph followed by a hash of the vertex numbers and the initial cut, so a
+ * relabeled input or another initial cut does not match)
+ */
+std::string checkpoint_fingerprint(const csr_graph_s &graph, const solver_options_s &options, const std::vector<uint8_t> &initial);
+
+/**
+ * @brief Save a checkpoint (Written to a temporary file and renamed, so an interrupted write keeps the previous checkpoint)
+ * @param path The checkpoint file
+ * @param checkpoint The checkpoint
+ * @return True if the checkpoint was saved, false if it could not be written (A warning is printed and the temporary
+ * file is removed; the previous checkpoint is kept, so the solve continues)
+ */
+bool save_checkpoint(const std::filesystem::path &path, const checkpoint_s &checkpoint);
+
+/**
+ * @brief Load a checkpoint
+ * @param path The checkpoint file
+ * @return The checkpoint
+ * @note Throws std::runtime_error if the file is missing, was written by another version or is malformed
+ */
+checkpoint_s load_checkpoint(const std::filesystem::path &path);
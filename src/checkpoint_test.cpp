@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <filesystem>
+#include <fstream>
+#include <unistd.h>
+
+#include "checkpoint.hpp"
+#include "test_graphs.hpp"
+
+TEST(checkpoint, round_trip)
+{
+  // Save a checkpoint
+  const auto path = std::filesystem::temp_directory_path() / ("checkpoint-test-" + std::to_string(::getpid()));
+  const checkpoint_s expected{"0123456789abcdef", 7, 3, {4, 9, 12}, simulation_checkpoint_s{4, 2, {5, 0, 7}, {1, 0, 2}, 1}};
+  ASSERT_TRUE(save_checkpoint(path, expected));
+
+  // Load it back
+  const auto checkpoint = load_checkpoint(path);
+  std::filesystem::remove(path);
+
+  // Assert the checkpoint
+  ASSERT_EQ(checkpoint.fingerprint, expected.fingerprint);
+  ASSERT_EQ(checkpoint.components, expected.components);
+  ASSERT_EQ(checkpoint.lower_bound, expected.lower_bound);
+  ASSERT_EQ(checkpoint.cut, expected.cut);
+  ASSERT_TRUE(checkpoint.simulation);
+  ASSERT_EQ(checkpoint.simulation->component, 4);
+  ASSERT_EQ(checkpoint.simulation->batch, 2);
+  ASSERT_EQ(checkpoint.simulation->traffic, expected.simulation->traffic);
+  ASSERT_EQ(checkpoint.simulation->order, expected.simulation->order);
+  ASSERT_EQ(checkpoint.simulation->stable_batches, 1);
+}
+
+TEST(checkpoint, write_failure)
+{
+  // Build a checkpoint path whose directory is missing, and one blocked by a directory
+  const auto directory = std::filesystem::temp_directory_path() / ("checkpoint-test-write-failure-" + std::to_string(::getpid()));
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory / "blocked" / "entry");
+  const checkpoint_s checkpoint{"0123456789abcdef", 1, 0, {}, std::nullopt};
+
+  // Assert both failures are reported without throwing, and the temporary file is removed
+  ASSERT_FALSE(save_checkpoint(directory / "missing" / "checkpoint", checkpoint));
+  ASSERT_FALSE(save_checkpoint(directory / "blocked", checkpoint));
+  ASSERT_EQ(std::distance(std::filesystem::directory_iterator(directory), std::filesystem::directory_iterator()), 1);
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST(checkpoint, malformed)
+{
+  // Write a file which is not a checkpoint
+  const auto path = std::filesystem::temp_directory_path() / ("checkpoint-test-malformed-" + std::to_string(::getpid()));
+  {
+    std::ofstream output(path);
+    output << "not a checkpoint";
+  }
+
+  // Assert it is rejected, as is a missing file
+  ASSERT_THROW(load_checkpoint(path), std::runtime_error);
+  std::filesystem::remove(path);
+  ASSERT_THROW(load_checkpoint(path), std::runtime_error);
+}
+
+TEST(checkpoint, fingerprint)
+{
+  // Build a graph, a copy at other vertex numbers and a copy of the options with more threads
+  const auto graph = build_graph(3, {{1, 2}, {2, 3}, {3, 1}});
+  auto renumbered = graph;
+  renumbered.numbers = {1, 2, 4};
+
+  const auto options = solver_options_s{simulation_options_s{4, 8, 2, 0.0, 0, 0, 1}, 0, 1000};
+  auto threaded = options;
+  threaded.simulation.threads = 8;
+
+  // Assert the fingerprint tells the vertex numbers and the initial cut apart, but not the threads
+  const auto fingerprint = checkpoint_fingerprint(graph, options, {});
+  ASSERT_EQ(checkpoint_fingerprint(graph, threaded, {}), fingerprint);
+  ASSERT_NE(checkpoint_fingerprint(renumbered, options, {}), fingerprint);
+  ASSERT_NE(checkpoint_fingerprint(graph, options, {1, 0, 0}), fingerprint);
+  ASSERT_NE(checkpoint_fingerprint(graph, options, {0, 1, 0}), checkpoint_fingerprint(graph, options, {1, 0, 0}));
+}
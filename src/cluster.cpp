@@ -0,0 +1,924 @@
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <numeric>
+#include <poll.h>
+#include <signal.h>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+#include "binary.hpp"
+#include "cluster.hpp"
+#include "filter.hpp"
+
+/**
+ * @brief The poll timeout of the coordinator, in milliseconds (How often it checks whether its local workers exited)
+ */
+#define CLUSTER_POLL_MS 100
+
+/**
+ * @brief The number of bytes a frame's buffer grows by while it is received (So a forged header cannot reserve
+ * CLUSTER_MAX_FRAME bytes up front)
+ */
+#define CLUSTER_RECEIVE_CHUNK ((std::size_t)1 << 20)
+
+/**
+ * @brief The type of a frame
+ */
+enum class frame_type_e : uint32_t
+{
+  /**
+   * @brief Coordinator to worker: the protocol version and the solver options
+   */
+  options = 1,
+
+  /**
+   * @brief Coordinator to worker: a component to solve
+   */
+  task = 2,
+
+  /**
+   * @brief Worker to coordinator: the solution of the last component
+   */
+  result = 3,
+
+  /**
+   * @brief Coordinator to worker: no more components
+   */
+  shutdown = 4,
+};
+
+/**
+ * @brief A received frame
+ */
+struct frame_s
+{
+  /**
+   * @brief The type
+   */
+  frame_type_e type;
+
+  /**
+   * @brief The payload
+   */
+  std::vector<uint8_t> payload;
+};
+
+/**
+ * @brief A parsed socket address
+ */
+struct address_s
+{
+  /**
+   * @brief Whether this is a Unix domain socket (Else TCP)
+   */
+  bool unix_domain;
+
+  /**
+   * @brief The socket path (Unix domain sockets only)
+   */
+  std::string path;
+
+  /**
+   * @brief The host (TCP only, empty for any interface)
+   */
+  std::string host;
+
+  /**
+   * @brief The port (TCP only)
+   */
+  std::string port;
+};
+
+/**
+ * @brief A worker connected to the coordinator
+ */
+struct connection_s
+{
+  /**
+   * @brief The socket (-1 once closed)
+   */
+  int socket;
+
+  /**
+   * @brief The component the worker is solving
+   */
+  std::optional<std::size_t> task;
+
+  /**
+   * @brief The graph of the component the worker is solving (Kept from dispatch to validate the result)
+   */
+  csr_graph_s component;
+};
+
+/**
+ * @brief Parse an address
+ * @param address The address (unix:PATH or tcp:HOST:PORT)
+ * @return The parsed address
+ */
+static address_s parse_address(const std::string &address)
+{
+  if (address.starts_with("unix:") && address.size() > 5)
+  {
+    return address_s{true, address.substr(5), "", ""};
+  }
+
+  const auto colon = address.rfind(':');
+  if (address.starts_with("tcp:") && colon != std::string::npos && 4 <= colon && colon + 1 < address.size())
+  {
+    return address_s{false, "", address.substr(4, colon - 4), address.substr(colon + 1)};
+  }
+
+  throw std::invalid_argument("Invalid address (Expected unix:PATH or tcp:HOST:PORT): " + address);
+}
+
+/**
+ * @brief Fill a Unix domain socket address
+ * @param path The socket path
+ * @return The socket address
+ */
+static sockaddr_un unix_address(const std::string &path)
+{
+  sockaddr_un socketAddress{};
+  socketAddress.sun_family = AF_UNIX;
+
+  if (sizeof(socketAddress.sun_path) <= path.size())
+  {
+    throw std::invalid_argument("Socket path is too long: " + path);
+  }
+
+  std::copy(path.begin(), path.end(), socketAddress.sun_path);
+  return socketAddress;
+}
+
+/**
+ * @brief Listen on an address
+ * @param address The address
+ * @return The listening socket
+ */
+static int listen_on(const address_s &address)
+{
+  if (address.unix_domain)
+  {
+    const auto socketAddress = unix_address(address.path);
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+    // Replace a stale socket file
+    ::unlink(address.path.c_str());
+
+    if (listener < 0 || ::bind(listener, (const sockaddr *)&socketAddress, sizeof(socketAddress)) != 0 || ::listen(listener, SOMAXCONN) != 0)
+    {
+      const auto error = std::string(std::strerror(errno));
+      if (0 <= listener)
+      {
+        ::close(listener);
+      }
+
+      throw std::runtime_error("Failed to listen on unix:" + address.path + ": " + error);
+    }
+
+    return listener;
+  }
+
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+  hints.ai_flags = AI_PASSIVE;
+
+  addrinfo *results = nullptr;
+  if (::getaddrinfo(address.host.empty() ? nullptr : address.host.c_str(), address.port.c_str(), &hints, &results) != 0)
+  {
+    throw std::runtime_error("Failed to resolve tcp:" + address.host + ":" + address.port);
+  }
+
+  // Listen on the first resolved address which accepts
+  int listener = -1;
+  for (auto *result = results; result != nullptr && listener < 0; result = result->ai_next)
+  {
+    listener = ::socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    if (listener < 0)
+    {
+      continue;
+    }
+
+    const int reuse = 1;
+    ::setsockopt(listener, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+    if (::bind(listener, result->ai_addr, result->ai_addrlen) != 0 || ::listen(listener, SOMAXCONN) != 0)
+    {
+      ::close(listener);
+      listener = -1;
+    }
+  }
+
+  ::freeaddrinfo(results);
+
+  if (listener < 0)
+  {
+    throw std::runtime_error("Failed to listen on tcp:" + address.host + ":" + address.port);
+  }
+
+  return listener;
+}
+
+/**
+ * @brief Connect to an address once
+ * @param address The address
+ * @return The connected socket, or -1 on failure
+ */
+static int connect_to(const address_s &address)
+{
+  if (address.unix_domain)
+  {
+    const auto socketAddress = unix_address(address.path);
+    const int connection = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+    if (0 <= connection && ::connect(connection, (const sockaddr *)&socketAddress, sizeof(socketAddress)) != 0)
+    {
+      ::close(connection);
+      return -1;
+    }
+
+    return connection;
+  }
+
+  addrinfo hints{};
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+
+  addrinfo *results = nullptr;
+  if (::getaddrinfo(address.host.empty() ? "localhost" : address.host.c_str(), address.port.c_str(), &hints, &results) != 0)
+  {
+    return -1;
+  }
+
+  int connection = -1;
+  for (auto *result = results; result != nullptr && connection < 0; result = result->ai_next)
+  {
+    connection = ::socket(result->ai_family, result->ai_socktype, result->ai_protocol);
+    if (0 <= connection && ::connect(connection, result->ai_addr, result->ai_addrlen) != 0)
+    {
+      ::close(connection);
+      connection = -1;
+    }
+  }
+
+  ::freeaddrinfo(results);
+
+  // Send small frames immediately
+  if (0 <= connection)
+  {
+    const int noDelay = 1;
+    ::setsockopt(connection, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+  }
+
+  return connection;
+}
+
+/**
+ * @brief Send a buffer completely
+ * @param socket The socket
+ * @param data The buffer
+ * @param size The number of bytes
+ */
+static void send_all(const int socket, const uint8_t *data, std::size_t size)
+{
+  while (0 < size)
+  {
+    const auto sent = ::send(socket, data, size, MSG_NOSIGNAL);
+    if (sent < 0 && errno == EINTR)
+    {
+      continue;
+    }
+
+    if (sent <= 0)
+    {
+      throw std::runtime_error("Failed to send frame: " + std::string(std::strerror(errno)));
+    }
+
+    data += sent;
+    size -= (std::size_t)sent;
+  }
+}
+
+/**
+ * @brief Receive a buffer completely
+ * @param socket The socket
+ * @param data The buffer
+ * @param size The number of bytes
+ * @return True if the buffer was filled, false if the connection was closed or failed first
+ */
+static bool receive_all(const int socket, uint8_t *data, std::size_t size)
+{
+  while (0 < size)
+  {
+    const auto received = ::recv(socket, data, size, 0);
+    if (received < 0 && errno == EINTR)
+    {
+      continue;
+    }
+
+    if (received <= 0)
+    {
+      return false;
+    }
+
+    data += received;
+    size -= (std::size_t)received;
+  }
+
+  return true;
+}
+
+/**
+ * @brief Send a frame
+ * @param socket The socket
+ * @param type The frame type
+ * @param payload The payload
+ */
+static void send_frame(const int socket, const frame_type_e type, const std::vector<uint8_t> &payload)
+{
+  binary_writer_s header;
+  header.add((uint64_t)type, 4);
+  header.add(payload.size(), 8);
+
+  send_all(socket, header.bytes.data(), header.bytes.size());
+  send_all(socket, payload.data(), payload.size());
+}
+
+/**
+ * @brief Receive a frame
+ * @param socket The socket
+ * @return The frame, or nothing if the connection was closed or failed
+ */
+static std::optional<frame_s> receive_frame(const int socket)
+{
+  std::vector<uint8_t> header(12);
+  if (!receive_all(socket, header.data(), header.size()))
+  {
+    return std::nullopt;
+  }
+
+  binary_reader_s reader{header};
+  const auto type = (frame_type_e)reader.take(4);
+  const auto size = reader.take(8);
+
+  if (CLUSTER_MAX_FRAME < size)
+  {
+    throw std::runtime_error("Frame is too large");
+  }
+
+  // Grow the payload as its bytes arrive
+  frame_s frame{type, {}};
+  while (frame.payload.size() < size)
+  {
+    const auto offset = frame.payload.size();
+    frame.payload.resize(offset + std::min<std::size_t>(size - offset, CLUSTER_RECEIVE_CHUNK));
+
+    if (!receive_all(socket, frame.payload.data() + offset, frame.payload.size() - offset))
+    {
+      return std::nullopt;
+    }
+  }
+
+  return frame;
+}
+
+/**
+ * @brief Encode the solver options (Every field but the number of threads)
+ * @param options The solver options
+ * @return The payload
+ */
+static std::vector<uint8_t> encode_options(const solver_options_s &options)
+{
+  binary_writer_s writer;
+  writer.add(CLUSTER_PROTOCOL_VERSION, 4);
+
+  const auto &simulation = options.simulation;
+  writer.add(simulation.agents, 8);
+  writer.add(simulation.steps, 8);
+  writer.add(simulation.batches, 8);
+  writer.add_double(simulation.change_threshold);
+  writer.add(simulation.seed, 8);
+  writer.add((uint64_t)simulation.stop_mode, 4);
+  writer.add_double(simulation.rank_correlation);
+  writer.add(simulation.stable_batches, 8);
+  writer.add((uint64_t)simulation.start_mode, 4);
+  writer.add(simulation.burn_in, 8);
+  writer.add_double(simulation.teleport);
+  writer.add(simulation.antithetic, 1);
+
+  writer.add(options.exact_threshold, 8);
+  writer.add(options.exact_node_limit, 8);
+  writer.add_string(options.cache_directory);
+  writer.add((uint64_t)options.traffic_engine, 4);
+  writer.add(options.cycle_samples, 8);
+  writer.add((uint64_t)options.degree_score, 4);
+  writer.add((uint64_t)options.strategy, 4);
+  writer.add(options.divide_threshold, 8);
+  writer.add_double(options.divide_fraction);
+  writer.add((uint64_t)options.reorder, 4);
+
+  return writer.bytes;
+}
+
+/**
+ * @brief Decode the solver options
+ * @param payload The payload
+ * @return The solver options (With the default number of threads)
+ */
+static solver_options_s decode_options(const std::vector<uint8_t> &payload)
+{
+  binary_reader_s reader{payload};
+  if (reader.take(4) != CLUSTER_PROTOCOL_VERSION)
+  {
+    throw std::runtime_error("Coordinator uses a different protocol version");
+  }
+
+  solver_options_s options;
+  auto &simulation = options.simulation;
+  simulation.agents = reader.take(8);
+  simulation.steps = reader.take(8);
+  simulation.batches = reader.take(8);
+  simulation.change_threshold = reader.take_double();
+  simulation.seed = reader.take(8);
+  simulation.stop_mode = (stop_mode_e)reader.take(4);
+  simulation.rank_correlation = reader.take_double();
+  simulation.stable_batches = reader.take(8);
+  simulation.start_mode = (start_mode_e)reader.take(4);
+  simulation.burn_in = reader.take(8);
+  simulation.teleport = reader.take_double();
+  simulation.antithetic = reader.take(1) != 0;
+
+  options.exact_threshold = reader.take(8);
+  options.exact_node_limit = reader.take(8);
+  options.cache_directory = reader.take_string();
+  options.traffic_engine = (traffic_engine_e)reader.take(4);
+  options.cycle_samples = reader.take(8);
+  options.degree_score = (degree_score_e)reader.take(4);
+  options.strategy = (solve_strategy_e)reader.take(4);
+  options.divide_threshold = reader.take(8);
+  options.divide_fraction = reader.take_double();
+  options.reorder = (reorder_e)reader.take(4);
+
+  reader.finish();
+  return options;
+}
+
+/**
+ * @brief Encode a task
+ * @param id The component
+ * @param task The task
+ * @return The payload
+ */
+static std::vector<uint8_t> encode_task(const std::size_t id, const cluster_task_s &task)
+{
+  binary_writer_s writer;
+  writer.add(id, 8);
+  writer.add_vector(task.component.numbers);
+  writer.add_vector(task.component.out_offsets);
+  writer.add_vector(task.component.out_targets);
+  writer.add_vector(task.component.in_offsets);
+  writer.add_vector(task.component.in_sources);
+  writer.add(task.initial.has_value(), 1);
+
+  if (task.initial)
+  {
+    writer.add_vector(*task.initial);
+  }
+
+  return writer.bytes;
+}
+
+/**
+ * @brief Check that an adjacency array is consistent with the number of vertices
+ * @param offsets The offsets (One per vertex, plus the end)
+ * @param vertices The adjacent vertices
+ * @param numVertices The number of vertices
+ */
+static void validate_adjacency(const std::vector<csr_index_t> &offsets, const std::vector<csr_index_t> &vertices, const std::size_t numVertices)
+{
+  if (offsets.size() != numVertices + 1 || offsets.front() != 0 || offsets.back() != vertices.size() || !std::is_sorted(offsets.begin(), offsets.end()) ||
+      std::any_of(vertices.begin(), vertices.end(), [numVertices](const csr_index_t vertex)
+                  { return numVertices <= vertex; }))
+  {
+    throw std::runtime_error("Malformed frame");
+  }
+}
+
+/**
+ * @brief Decode a task
+ * @param payload The payload
+ * @param id The component
+ * @return The task
+ */
+static cluster_task_s decode_task(const std::vector<uint8_t> &payload, std::size_t &id)
+{
+  binary_reader_s reader{payload};
+  id = reader.take(8);
+
+  cluster_task_s task;
+  task.component.numbers = reader.take_vector<std::size_t>();
+  task.component.out_offsets = reader.take_vector<csr_index_t>();
+  task.component.out_targets = reader.take_vector<csr_index_t>();
+  task.component.in_offsets = reader.take_vector<csr_index_t>();
+  task.component.in_sources = reader.take_vector<csr_index_t>();
+
+  if (reader.take(1) != 0)
+  {
+    task.initial = reader.take_vector<csr_index_t>();
+  }
+
+  reader.finish();
+
+  const auto numVertices = task.component.numbers.size();
+  validate_adjacency(task.component.out_offsets, task.component.out_targets, numVertices);
+  validate_adjacency(task.component.in_offsets, task.component.in_sources, numVertices);
+
+  if (task.initial && std::any_of(task.initial->begin(), task.initial->end(), [numVertices](const csr_index_t vertex)
+                                  { return numVertices <= vertex; }))
+  {
+    throw std::runtime_error("Malformed frame");
+  }
+
+  return task;
+}
+
+/**
+ * @brief Encode a result
+ * @param id The component
+ * @param solution The solution
+ * @return The payload
+ */
+static std::vector<uint8_t> encode_result(const std::size_t id, const component_solution_s &solution)
+{
+  binary_writer_s writer;
+  writer.add(id, 8);
+  writer.add(solution.lower_bound, 8);
+  writer.add_vector(solution.cut);
+
+  return writer.bytes;
+}
+
+/**
+ * @brief Decode a result
+ * @param payload The payload
+ * @param id The component
+ * @return The solution
+ */
+static component_solution_s decode_result(const std::vector<uint8_t> &payload, std::size_t &id)
+{
+  binary_reader_s reader{payload};
+  id = reader.take(8);
+
+  component_solution_s solution;
+  solution.lower_bound = reader.take(8);
+  solution.cut = reader.take_vector<csr_index_t>();
+
+  reader.finish();
+  return solution;
+}
+
+/**
+ * @brief Check that a worker's solution is a feasible cut of a component
+ * @param solution The solution
+ * @param component The component
+ * @return True if the cut is ascending without duplicates, every index is a vertex of the component, the lower bound
+ * does not exceed the cut and the cut leaves the component acyclic, false otherwise
+ */
+static bool is_valid_solution(const component_solution_s &solution, const csr_graph_s &component)
+{
+  for (std::size_t index = 0; index < solution.cut.size(); index++)
+  {
+    if (component.num_vertices() <= solution.cut[index] || (0 < index && solution.cut[index] <= solution.cut[index - 1]))
+    {
+      return false;
+    }
+  }
+
+  return solution.lower_bound <= solution.cut.size() && is_acyclic_without(component, solution.cut);
+}
+
+/**
+ * @brief Start local worker processes
+ * @param executable The solver executable
+ * @param address The coordinator's address
+ * @param count The number of workers
+ * @param threads The number of threads per worker
+ * @return The process IDs
+ */
+static std::vector<pid_t> spawn_workers(const std::string &executable, const std::string &address, const std::size_t count, const std::size_t threads)
+{
+  // Build the arguments before forking (Only async-signal-safe calls are allowed in the child)
+  std::vector<std::string> arguments{executable, "--worker", address, "--threads", std::to_string(threads)};
+  std::vector<char *> argumentPointers;
+  for (auto &argument : arguments)
+  {
+    argumentPointers.push_back(argument.data());
+  }
+  argumentPointers.push_back(nullptr);
+
+  std::vector<pid_t> children;
+  for (std::size_t worker = 0; worker < count; worker++)
+  {
+    const auto child = ::fork();
+    if (child < 0)
+    {
+      throw std::runtime_error("Failed to start worker: " + std::string(std::strerror(errno)));
+    }
+
+    if (child == 0)
+    {
+      ::execvp(argumentPointers[0], argumentPointers.data());
+      ::_exit(127);
+    }
+
+    children.push_back(child);
+  }
+
+  return children;
+}
+
+std::vector<component_solution_s> coordinate(const std::string &address, const solver_options_s &options, const std::vector<std::size_t> &sizes, const std::function<cluster_task_s(std::size_t)> &build_task, const std::string &executable, const std::size_t local_workers, const std::size_t threads)
+{
+  const auto parsedAddress = parse_address(address);
+  const int listener = listen_on(parsedAddress);
+
+  // Hand out the largest components first (The next component is at the back)
+  std::vector<std::size_t> pending(sizes.size());
+  std::iota(pending.begin(), pending.end(), 0);
+  std::stable_sort(pending.begin(), pending.end(), [&sizes](const std::size_t a, const std::size_t b)
+                   { return sizes[a] < sizes[b]; });
+
+  std::vector<component_solution_s> solutions(sizes.size());
+  std::size_t remaining = sizes.size();
+
+  std::vector<pid_t> children;
+  std::vector<connection_s> connections;
+  const auto optionsPayload = encode_options(options);
+
+  // Shut the workers down and release the sockets
+  const auto shutdown = [&]()
+  {
+    for (auto &connection : connections)
+    {
+      try
+      {
+        send_frame(connection.socket, frame_type_e::shutdown, {});
+      }
+      catch (const std::runtime_error &)
+      {
+      }
+
+      ::close(connection.socket);
+    }
+
+    ::close(listener);
+    if (parsedAddress.unix_domain)
+    {
+      ::unlink(parsedAddress.path.c_str());
+    }
+
+    // Local workers which have not connected yet would keep retrying
+    for (const auto child : children)
+    {
+      ::kill(child, SIGTERM);
+      ::waitpid(child, nullptr, 0);
+    }
+  };
+
+  // Send a worker the next component
+  const auto dispatch = [&](connection_s &connection)
+  {
+    if (pending.empty())
+    {
+      return;
+    }
+
+    connection.task = pending.back();
+    pending.pop_back();
+
+    auto task = build_task(*connection.task);
+    send_frame(connection.socket, frame_type_e::task, encode_task(*connection.task, task));
+    connection.component = std::move(task.component);
+  };
+
+  // Close a worker's connection and hand its component out again (Unless it failed too often, which is reported once
+  // the connections are handled)
+  std::vector<std::size_t> failures(sizes.size(), 0);
+  std::optional<std::size_t> exhausted;
+  const auto drop = [&](connection_s &connection)
+  {
+    if (connection.task)
+    {
+      if (++failures[*connection.task] < CLUSTER_MAX_ATTEMPTS)
+      {
+        pending.push_back(*connection.task);
+      }
+      else
+      {
+        exhausted = *connection.task;
+      }
+
+      connection.task.reset();
+      connection.component = csr_graph_s{};
+    }
+
+    ::close(connection.socket);
+    connection.socket = -1;
+  };
+
+  try
+  {
+    children = spawn_workers(executable, address, remaining == 0 ? 0 : local_workers, std::max<std::size_t>(1, threads / std::max<std::size_t>(1, local_workers)));
+
+    while (0 < remaining)
+    {
+      std::vector<pollfd> descriptors{pollfd{listener, POLLIN, 0}};
+      for (const auto &connection : connections)
+      {
+        descriptors.push_back(pollfd{connection.socket, POLLIN, 0});
+      }
+
+      if (::poll(descriptors.data(), descriptors.size(), CLUSTER_POLL_MS) < 0 && errno != EINTR)
+      {
+        throw std::runtime_error("Failed to poll: " + std::string(std::strerror(errno)));
+      }
+
+      // Collect the results and hand out the next components
+      for (std::size_t index = 1; index < descriptors.size(); index++)
+      {
+        auto &connection = connections[index - 1];
+        if (!(descriptors[index].revents & (POLLIN | POLLHUP | POLLERR)))
+        {
+          continue;
+        }
+
+        try
+        {
+          const auto frame = receive_frame(connection.socket);
+          if (!frame || frame->type != frame_type_e::result || !connection.task)
+          {
+            drop(connection);
+            continue;
+          }
+
+          std::size_t id;
+          auto solution = decode_result(frame->payload, id);
+          if (id != *connection.task || !is_valid_solution(solution, connection.component))
+          {
+            drop(connection);
+            continue;
+          }
+
+          solutions[id] = std::move(solution);
+          connection.task.reset();
+          connection.component = csr_graph_s{};
+          remaining--;
+        }
+        catch (const std::exception &)
+        {
+          drop(connection);
+        }
+      }
+
+      // Accept a worker and send it the options
+      if (descriptors[0].revents & POLLIN)
+      {
+        const int socket = ::accept(listener, nullptr, nullptr);
+        if (0 <= socket)
+        {
+          connections.push_back(connection_s{socket, std::nullopt, {}});
+
+          try
+          {
+            send_frame(socket, frame_type_e::options, optionsPayload);
+          }
+          catch (const std::exception &)
+          {
+            drop(connections.back());
+          }
+        }
+      }
+
+      // Hand out the next components to idle workers (Including components of dropped workers)
+      for (auto &connection : connections)
+      {
+        if (0 <= connection.socket && !connection.task)
+        {
+          try
+          {
+            dispatch(connection);
+          }
+          catch (const std::exception &)
+          {
+            drop(connection);
+          }
+        }
+      }
+
+      std::erase_if(connections, [](const connection_s &connection)
+                    { return connection.socket < 0; });
+
+      // Give up on a component which no worker could solve
+      if (exhausted)
+      {
+        throw std::runtime_error("Component " + std::to_string(*exhausted) + " was not solved after " + std::to_string(CLUSTER_MAX_ATTEMPTS) + " attempts");
+      }
+
+      // Give up once every local worker has exited without a connected worker left
+      if (connections.empty() && !children.empty() && 0 < remaining)
+      {
+        std::erase_if(children, [](const pid_t child)
+                      { return ::waitpid(child, nullptr, WNOHANG) == child; });
+
+        if (children.empty())
+        {
+          throw std::runtime_error("Every local worker exited before the components were solved");
+        }
+      }
+    }
+  }
+  catch (...)
+  {
+    shutdown();
+    throw;
+  }
+
+  shutdown();
+  return solutions;
+}
+
+void run_worker(const std::string &address, const std::size_t threads)
+{
+  const auto parsedAddress = parse_address(address);
+
+  // Connect, retrying while the coordinator starts
+  int socket = -1;
+  for (std::size_t attempt = 0; attempt < CLUSTER_CONNECT_ATTEMPTS && socket < 0; attempt++)
+  {
+    socket = connect_to(parsedAddress);
+    if (socket < 0)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(CLUSTER_CONNECT_DELAY_MS));
+    }
+  }
+
+  if (socket < 0)
+  {
+    throw std::runtime_error("Failed to connect to " + address);
+  }
+
+  try
+  {
+    // Receive the options
+    const auto optionsFrame = receive_frame(socket);
+    if (!optionsFrame || optionsFrame->type != frame_type_e::options)
+    {
+      throw std::runtime_error("Coordinator did not send the options");
+    }
+
+    auto options = decode_options(optionsFrame->payload);
+    options.simulation.threads = threads;
+
+    // Solve components until shut down
+    while (true)
+    {
+      const auto frame = receive_frame(socket);
+      if (!frame)
+      {
+        throw std::runtime_error("Coordinator closed the connection");
+      }
+
+      if (frame->type == frame_type_e::shutdown)
+      {
+        break;
+      }
+
+      if (frame->type != frame_type_e::task)
+      {
+        throw std::runtime_error("Malformed frame");
+      }
+
+      std::size_t id;
+      const auto task = decode_task(frame->payload, id);
+      const auto solution = solve_component(task.component, options, task.initial);
+      send_frame(socket, frame_type_e::result, encode_result(id, solution));
+    }
+  }
+  catch (...)
+  {
+    ::close(socket);
+    throw;
+  }
+
+  ::close(socket);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "csr.hpp"
+#include "solve.hpp"
+
+/**
+ * @brief The protocol version (Sent with the options, so mismatched workers fail fast)
+ */
+#define CLUSTER_PROTOCOL_VERSION 3
+
+/**
+ * @brief The largest frame payload accepted, in bytes
+ */
+#define CLUSTER_MAX_FRAME ((uint64_t)1 << 34)
+
+/**
+ * @brief The number of times a worker tries to connect before giving up (CLUSTER_CONNECT_DELAY_MS apart)
+ */
+#define CLUSTER_CONNECT_ATTEMPTS 100
+
+/**
+ * @brief The delay between connection attempts, in milliseconds
+ */
+#define CLUSTER_CONNECT_DELAY_MS 100
+
+/**
+ * @brief The number of times a component may be handed out without a feasible cut coming back (Its workers dropped or
+ * answered with an invalid cut) before the coordinator gives up
+ */
+#define CLUSTER_MAX_ATTEMPTS 3
+
+/**
+ * @brief A component to solve remotely
+ */
+struct cluster_task_s
+{
+  /**
+   * @brief The component
+   */
+  csr_graph_s component;
+
+  /**
+   * @brief The local indices of a known cut of the component to improve on
+   */
+  std::optional<std::vector<csr_index_t>> initial;
+};
+
+/**
+ * @brief Solve components on worker processes
+ * @param address The address to listen on (unix:PATH or tcp:HOST:PORT)
+ * @param options The solver options (Workers use their own number of threads)
+ * @param sizes The number of vertices of each component
+ * @param build_task Build the task of a component (Called once per dispatch and once per result, so a component is
+ * only materialized while it is being sent or its cut checked)
+ * @param executable The solver executable to start local workers with
+ * @param local_workers The number of local workers to start (0 to wait for external workers only)
+ * @param threads The number of threads split between the local workers
+ * @return The solution of each component
+ * @note Components are handed out largest first, one at a time, to whichever worker is idle; the component of a worker
+ * whose connection drops, or whose solution is not a feasible cut of its component, is handed out again, at most
+ * CLUSTER_MAX_ATTEMPTS times in all before a std::runtime_error is thrown. Frames are a 4-byte type and an 8-byte
+ * payload length followed by the payload, with every integer little-endian and vertex indices 4 bytes wide
+ */
+std::vector<component_solution_s> coordinate(const std::string &address, const solver_options_s &options, const std::vector<std::size_t> &sizes, const std::function<cluster_task_s(std::size_t)> &build_task, const std::string &executable, const std::size_t local_workers, const std::size_t threads);
+
+/**
+ * @brief Solve components sent by a coordinator until it shuts the worker down
+ * @param address The coordinator's address (unix:PATH or tcp:HOST:PORT)
+ * @param threads The number of threads
+ */
+void run_worker(const std::string &address, const std::size_t threads);
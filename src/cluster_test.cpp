@@ -0,0 +1,267 @@
+#include <gtest/gtest.h>
+#include <cstring>
+#include <filesystem>
+#include <functional>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "binary.hpp"
+#include "cluster.hpp"
+#include "scc.hpp"
+#include "test_graphs.hpp"
+
+/**
+ * @brief Build the components with more than one vertex of a random graph
+ * @param numVertices The number of vertices
+ * @param numEdges The number of edges
+ * @param seed The random seed
+ * @return The compressed sparse row graphs of the components
+ */
+static std::vector<csr_graph_s> build_random_components(const std::size_t numVertices, const std::size_t numEdges, const uint64_t seed)
+{
+  const auto csr = build_random(numVertices, numEdges, seed);
+  const auto decomposition = decompose(csr, 1, nullptr);
+
+  std::vector<csr_graph_s> components;
+  for (std::size_t component = 0; component < decomposition.num_components(); component++)
+  {
+    const component_view_s view{csr, decomposition, component};
+    if (1 < view.size())
+    {
+      components.push_back(view.build_csr());
+    }
+  }
+
+  return components;
+}
+
+TEST(coordinate, matches_local)
+{
+  // Build the components
+  auto components = build_random_components(400, 500, 3);
+  const auto more = build_random_components(300, 900, 4);
+  components.insert(components.end(), more.begin(), more.end());
+  ASSERT_LT(2, components.size());
+
+  std::vector<std::size_t> sizes;
+  for (const auto &component : components)
+  {
+    sizes.push_back(component.num_vertices());
+  }
+
+  // Solve the components on two workers connected over a Unix domain socket
+  const solver_options_s options{simulation_options_s{16, 16, 4, 0.0, 0, 0, 1}, 8, 1000};
+  const auto address = "unix:" + (std::filesystem::temp_directory_path() / ("cluster-test-" + std::to_string(::getpid()))).string();
+
+  std::vector<component_solution_s> solutions;
+  std::thread coordinator([&]()
+                          { solutions = coordinate(
+                                address, options, sizes, [&components](const std::size_t task)
+                                { return cluster_task_s{components[task], std::nullopt}; },
+                                "", 0, 1); });
+
+  // Start the workers once the coordinator listens (One of them may connect after the other solved every component,
+  // and then fails to receive the options)
+  while (!std::filesystem::exists(address.substr(5)))
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  std::vector<std::thread> workers;
+  for (std::size_t worker = 0; worker < 2; worker++)
+  {
+    workers.emplace_back([&address]()
+                         {
+                           try
+                           {
+                             run_worker(address, 1);
+                           }
+                           catch (const std::runtime_error &)
+                           {
+                           } });
+  }
+
+  coordinator.join();
+  for (auto &worker : workers)
+  {
+    worker.join();
+  }
+
+  // Assert each solution matches the local one
+  ASSERT_EQ(solutions.size(), components.size());
+  for (std::size_t component = 0; component < components.size(); component++)
+  {
+    const auto local = solve_component(components[component], options, std::nullopt);
+    ASSERT_EQ(solutions[component].cut, local.cut);
+    ASSERT_EQ(solutions[component].lower_bound, local.lower_bound);
+  }
+}
+
+/**
+ * @brief Receive a frame from the coordinator
+ * @param socket The socket
+ * @return The payload (Empty if the connection was closed)
+ */
+static std::vector<uint8_t> receive_payload(const int socket)
+{
+  std::vector<uint8_t> header(12);
+  if (::recv(socket, header.data(), header.size(), MSG_WAITALL) != (ssize_t)header.size())
+  {
+    return {};
+  }
+
+  binary_reader_s reader{header};
+  reader.take(4);
+  std::vector<uint8_t> payload(reader.take(8));
+  ::recv(socket, payload.data(), payload.size(), MSG_WAITALL);
+
+  return payload;
+}
+
+/**
+ * @brief Connect to a coordinator, answer the first task with a bad cut and wait to be dropped
+ * @param path The coordinator's Unix domain socket path
+ * @param bad_cut Build the bad cut of a component from its identifier
+ */
+static void answer_bad_cut(const std::string &path, const std::function<std::vector<csr_index_t>(std::size_t)> &bad_cut)
+{
+  sockaddr_un socketAddress{};
+  socketAddress.sun_family = AF_UNIX;
+  std::strncpy(socketAddress.sun_path, path.c_str(), sizeof(socketAddress.sun_path) - 1);
+
+  const int socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+  while (::connect(socket, (const sockaddr *)&socketAddress, sizeof(socketAddress)) != 0)
+  {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  receive_payload(socket);
+  const auto task = receive_payload(socket);
+  binary_reader_s reader{task};
+  const auto id = reader.take(8);
+
+  binary_writer_s result;
+  result.add(id, 8);
+  result.add(0, 8);
+  result.add_vector(bad_cut(id));
+
+  binary_writer_s header;
+  header.add(3, 4);
+  header.add(result.bytes.size(), 8);
+  ::send(socket, header.bytes.data(), header.bytes.size(), MSG_NOSIGNAL);
+  ::send(socket, result.bytes.data(), result.bytes.size(), MSG_NOSIGNAL);
+
+  // Wait for the coordinator to drop the connection
+  receive_payload(socket);
+  ::close(socket);
+}
+
+/**
+ * @brief Answer the first task with a bad cut, then work normally
+ * @param path The coordinator's Unix domain socket path
+ * @param bad_cut Build the bad cut of a component from its identifier
+ */
+static void run_bad_worker(const std::string &path, const std::function<std::vector<csr_index_t>(std::size_t)> &bad_cut)
+{
+  answer_bad_cut(path, bad_cut);
+  run_worker("unix:" + path, 1);
+}
+
+/**
+ * @brief Solve components with a worker which answers its first task with a bad cut
+ * @param name The name of the socket
+ * @param components The components
+ * @param bad_cut Build the bad cut of a component from its identifier
+ */
+static void expect_bad_cut_resolved(const std::string &name, const std::vector<csr_graph_s> &components, const std::function<std::vector<csr_index_t>(std::size_t)> &bad_cut)
+{
+  std::vector<std::size_t> sizes;
+  for (const auto &component : components)
+  {
+    sizes.push_back(component.num_vertices());
+  }
+
+  const solver_options_s options{simulation_options_s{16, 16, 4, 0.0, 0, 0, 1}, 8, 1000};
+  const auto path = (std::filesystem::temp_directory_path() / (name + "-" + std::to_string(::getpid()))).string();
+
+  std::thread worker(run_bad_worker, path, bad_cut);
+
+  const auto solutions = coordinate(
+      "unix:" + path, options, sizes, [&components](const std::size_t task)
+      { return cluster_task_s{components[task], std::nullopt}; },
+      "", 0, 1);
+  worker.join();
+
+  // Assert the rejected component was solved again
+  for (std::size_t component = 0; component < components.size(); component++)
+  {
+    const auto local = solve_component(components[component], options, std::nullopt);
+    ASSERT_EQ(solutions[component].cut, local.cut);
+  }
+}
+
+TEST(coordinate, invalid_result)
+{
+  // Build the components
+  const auto components = build_random_components(300, 900, 5);
+  ASSERT_FALSE(components.empty());
+
+  // Answer with a vertex outside the component
+  expect_bad_cut_resolved("cluster-test-invalid", components, [&components](const std::size_t id)
+                          { return std::vector<csr_index_t>{(csr_index_t)components[id].num_vertices()}; });
+}
+
+TEST(coordinate, infeasible_result)
+{
+  // Build the components
+  const auto components = build_random_components(300, 900, 5);
+  ASSERT_FALSE(components.empty());
+
+  // Answer with an empty cut (In range, but every component has more than one vertex, so it stays cyclic)
+  expect_bad_cut_resolved("cluster-test-infeasible", components, [](const std::size_t)
+                          { return std::vector<csr_index_t>{}; });
+}
+
+TEST(coordinate, abandons_unsolvable)
+{
+  // Build the components
+  const auto components = build_random_components(300, 900, 5);
+  ASSERT_FALSE(components.empty());
+
+  std::vector<std::size_t> sizes;
+  for (const auto &component : components)
+  {
+    sizes.push_back(component.num_vertices());
+  }
+
+  const auto path = (std::filesystem::temp_directory_path() / ("cluster-test-abandon-" + std::to_string(::getpid()))).string();
+
+  // Connect a worker which answers every task with an empty cut
+  std::thread worker([&path]()
+                     {
+                       for (std::size_t attempt = 0; attempt < CLUSTER_MAX_ATTEMPTS; attempt++)
+                       {
+                         answer_bad_cut(path, [](const std::size_t)
+                                        { return std::vector<csr_index_t>{}; });
+                       } });
+
+  // Assert the coordinator gives up on the first component instead of handing it out forever
+  ASSERT_THROW(coordinate(
+                   "unix:" + path, solver_options_s{simulation_options_s{16, 16, 4, 0.0, 0, 0, 1}, 8, 1000}, sizes, [&components](const std::size_t task)
+                   { return cluster_task_s{components[task], std::nullopt}; },
+                   "", 0, 1),
+               std::runtime_error);
+  worker.join();
+}
+
+TEST(coordinate, invalid_address)
+{
+  // Assert addresses without a scheme are rejected
+  ASSERT_THROW(coordinate("localhost:1234", solver_options_s{}, {1}, [](const std::size_t)
+                          { return cluster_task_s{}; },
+                          "", 0, 1),
+               std::invalid_argument);
+}
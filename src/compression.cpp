@@ -0,0 +1,777 @@
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+// Declare zlib's input pointers as const
+#define ZLIB_CONST
+#include <zlib.h>
+
+#ifdef ALGOBOWL_ZSTD
+#include <zstd.h>
+#endif
+
+#include "compression.hpp"
+
+/**
+ * @brief A stream buffer fed by a decompression thread through two alternating chunks (The thread fills one chunk while
+ * the reader parses the other)
+ */
+struct decompressing_buffer_s : std::streambuf
+{
+  /**
+   * @brief The compressed file
+   */
+  std::ifstream file;
+
+  /**
+   * @brief The bytes already read from the file to detect the format (Decompressed before the rest of the file)
+   */
+  std::vector<char> prefix;
+
+  /**
+   * @brief The compression format
+   */
+  compression_e compression;
+
+  /**
+   * @brief The decompressed chunks
+   */
+  std::array<std::vector<char>, 2> chunks;
+
+  /**
+   * @brief The number of bytes in each chunk
+   */
+  std::array<std::size_t, 2> sizes{};
+
+  /**
+   * @brief The number of chunks filled by the thread
+   */
+  std::size_t produced = 0;
+
+  /**
+   * @brief The number of chunks the reader is done with
+   */
+  std::size_t released = 0;
+
+  /**
+   * @brief Whether the reader holds chunk released % 2
+   */
+  bool reading = false;
+
+  /**
+   * @brief Whether the thread is done
+   */
+  bool finished = false;
+
+  /**
+   * @brief Whether the reader is gone
+   */
+  bool stopping = false;
+
+  /**
+   * @brief The thread's error, if any
+   */
+  std::exception_ptr error;
+
+  /**
+   * @brief Guards the chunk counters and flags
+   */
+  std::mutex mutex;
+
+  /**
+   * @brief Signals a chunk being filled or released
+   */
+  std::condition_variable changed;
+
+  /**
+   * @brief The decompression thread
+   */
+  std::thread thread;
+
+  /**
+   * @brief Start decompressing a file
+   * @param input The compressed file
+   * @param sniffed The bytes already read from the file
+   * @param format The compression format
+   */
+  decompressing_buffer_s(std::ifstream &&input, std::vector<char> sniffed, const compression_e format) : file(std::move(input)), prefix(std::move(sniffed)), compression(format)
+  {
+    for (auto &chunk : chunks)
+    {
+      chunk.resize(COMPRESSION_CHUNK_SIZE);
+    }
+
+    thread = std::thread(&decompressing_buffer_s::run, this);
+  }
+
+  /**
+   * @brief Stop the decompression thread
+   */
+  ~decompressing_buffer_s() override
+  {
+    {
+      std::lock_guard lock(mutex);
+      stopping = true;
+    }
+
+    changed.notify_all();
+    thread.join();
+  }
+
+  /**
+   * @brief Release the current chunk and wait for the next one
+   * @return The next character, or end of file
+   */
+  int_type underflow() override
+  {
+    std::unique_lock lock(mutex);
+
+    // Hand the current chunk back to the thread
+    if (reading)
+    {
+      released++;
+      reading = false;
+      changed.notify_all();
+    }
+
+    changed.wait(lock, [this]
+                 { return released < produced || finished; });
+
+    if (released < produced)
+    {
+      auto *chunk = chunks[released % 2].data();
+      setg(chunk, chunk, chunk + sizes[released % 2]);
+      reading = true;
+
+      return traits_type::to_int_type(*gptr());
+    }
+
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+
+    return traits_type::eof();
+  }
+
+  /**
+   * @brief Wait for a free chunk
+   * @return The chunk, or nullptr if the reader is gone
+   */
+  char *acquire()
+  {
+    std::unique_lock lock(mutex);
+    changed.wait(lock, [this]
+                 { return produced - released < chunks.size() || stopping; });
+
+    return stopping ? nullptr : chunks[produced % 2].data();
+  }
+
+  /**
+   * @brief Hand a filled chunk to the reader
+   * @param size The number of bytes in the chunk
+   */
+  void publish(const std::size_t size)
+  {
+    {
+      std::lock_guard lock(mutex);
+      sizes[produced % 2] = size;
+      produced++;
+    }
+
+    changed.notify_all();
+  }
+
+  /**
+   * @brief Decompress the file chunk by chunk
+   * @param step Decompress from the input to the output, advancing both (Returns true at the end of a frame)
+   * @param reset Prepare for another frame (Concatenated frames are decompressed in sequence)
+   */
+  template <typename Step, typename Reset>
+  void pump(Step step, Reset reset)
+  {
+    // Start with the bytes read to detect the format
+    std::vector<char> input(COMPRESSION_CHUNK_SIZE);
+    std::copy(prefix.begin(), prefix.end(), input.begin());
+    const char *next = input.data();
+    std::size_t available = prefix.size();
+
+    char *chunk = acquire();
+    std::size_t filled = 0;
+    bool frameEnded = false;
+    bool drained = true;
+
+    while (chunk != nullptr)
+    {
+      // Read more compressed data once the decoder has flushed everything it could (Or the frame ended)
+      if (available == 0 && (drained || frameEnded))
+      {
+        file.read(input.data(), (std::streamsize)input.size());
+        next = input.data();
+        available = (std::size_t)file.gcount();
+
+        if (available == 0)
+        {
+          if (file.bad())
+          {
+            throw std::runtime_error("Failed to read the compressed file");
+          }
+
+          break;
+        }
+      }
+
+      // Start the next frame (Only once there is data after the previous one)
+      if (frameEnded && available != 0)
+      {
+        reset();
+        frameEnded = false;
+      }
+
+      char *output = chunk + filled;
+      std::size_t space = COMPRESSION_CHUNK_SIZE - filled;
+      frameEnded = step(next, available, output, space);
+      drained = space != 0;
+      filled = COMPRESSION_CHUNK_SIZE - space;
+
+      // Hand the chunk over once it is full
+      if (filled == COMPRESSION_CHUNK_SIZE)
+      {
+        publish(filled);
+        chunk = acquire();
+        filled = 0;
+      }
+    }
+
+    if (chunk == nullptr)
+    {
+      return;
+    }
+
+    if (!frameEnded)
+    {
+      throw std::runtime_error("The compressed file is truncated");
+    }
+
+    if (filled != 0)
+    {
+      publish(filled);
+    }
+  }
+
+  /**
+   * @brief Decompress gzip (or zlib) data
+   */
+  void inflate_file()
+  {
+    z_stream stream{};
+    if (inflateInit2(&stream, 15 + 32) != Z_OK)
+    {
+      throw std::runtime_error("Failed to initialize zlib");
+    }
+
+    const std::unique_ptr<z_stream, int (*)(z_streamp)> guard(&stream, inflateEnd);
+
+    pump(
+        [&stream](const char *&next, std::size_t &available, char *&output, std::size_t &space)
+        {
+          stream.next_in = (const Bytef *)next;
+          stream.avail_in = (uInt)available;
+          stream.next_out = (Bytef *)output;
+          stream.avail_out = (uInt)space;
+
+          const auto result = inflate(&stream, Z_NO_FLUSH);
+          if (result != Z_OK && result != Z_STREAM_END && result != Z_BUF_ERROR)
+          {
+            throw std::runtime_error(std::string("Failed to decompress the gzip data: ") + (stream.msg != nullptr ? stream.msg : "unknown error"));
+          }
+
+          next = (const char *)stream.next_in;
+          available = stream.avail_in;
+          output = (char *)stream.next_out;
+          space = stream.avail_out;
+
+          return result == Z_STREAM_END;
+        },
+        [&stream]
+        { inflateReset(&stream); });
+  }
+
+#ifdef ALGOBOWL_ZSTD
+  /**
+   * @brief Decompress Zstandard data
+   */
+  void decompress_zstd()
+  {
+    const std::unique_ptr<ZSTD_DStream, std::size_t (*)(ZSTD_DStream *)> context(ZSTD_createDStream(), ZSTD_freeDStream);
+    if (context == nullptr || ZSTD_isError(ZSTD_initDStream(context.get())))
+    {
+      throw std::runtime_error("Failed to initialize Zstandard");
+    }
+
+    pump(
+        [&context](const char *&next, std::size_t &available, char *&output, std::size_t &space)
+        {
+          ZSTD_inBuffer inBuffer{next, available, 0};
+          ZSTD_outBuffer outBuffer{output, space, 0};
+
+          const auto result = ZSTD_decompressStream(context.get(), &outBuffer, &inBuffer);
+          if (ZSTD_isError(result))
+          {
+            throw std::runtime_error(std::string("Failed to decompress the Zstandard data: ") + ZSTD_getErrorName(result));
+          }
+
+          next += inBuffer.pos;
+          available -= inBuffer.pos;
+          output += outBuffer.pos;
+          space -= outBuffer.pos;
+
+          return result == 0;
+        },
+        [&context]
+        { ZSTD_initDStream(context.get()); });
+  }
+#endif
+
+  /**
+   * @brief Decompress the file, recording any error for the reader
+   */
+  void run()
+  {
+    try
+    {
+      if (compression == compression_e::gzip)
+      {
+        inflate_file();
+      }
+#ifdef ALGOBOWL_ZSTD
+      else if (compression == compression_e::zstd)
+      {
+        decompress_zstd();
+      }
+#endif
+      else
+      {
+        throw std::runtime_error("Unsupported compression format");
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard lock(mutex);
+      error = std::current_exception();
+    }
+
+    {
+      std::lock_guard lock(mutex);
+      finished = true;
+    }
+
+    changed.notify_all();
+  }
+};
+
+/**
+ * @brief A stream buffer which compresses the data written to it
+ */
+struct compressing_buffer_s : std::streambuf
+{
+  /**
+   * @brief The compressed file
+   */
+  std::ofstream file;
+
+  /**
+   * @brief The compression format
+   */
+  compression_e compression;
+
+  /**
+   * @brief The uncompressed data not yet compressed
+   */
+  std::vector<char> buffer;
+
+  /**
+   * @brief The compressed data not yet written
+   */
+  std::vector<char> compressed;
+
+  /**
+   * @brief The zlib state
+   */
+  z_stream zlib_stream{};
+
+#ifdef ALGOBOWL_ZSTD
+  /**
+   * @brief The Zstandard state
+   */
+  ZSTD_CStream *zstd_stream = nullptr;
+#endif
+
+  /**
+   * @brief Whether the trailer was written
+   */
+  bool finished = false;
+
+  /**
+   * @brief Start compressing to a file
+   * @param output The file
+   * @param format The compression format
+   */
+  compressing_buffer_s(std::ofstream &&output, const compression_e format) : file(std::move(output)), compression(format), buffer(COMPRESSION_CHUNK_SIZE), compressed(COMPRESSION_CHUNK_SIZE)
+  {
+    if (compression == compression_e::gzip)
+    {
+      if (deflateInit2(&zlib_stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+      {
+        throw std::runtime_error("Failed to initialize zlib");
+      }
+    }
+#ifdef ALGOBOWL_ZSTD
+    else if (compression == compression_e::zstd)
+    {
+      zstd_stream = ZSTD_createCStream();
+      if (zstd_stream == nullptr)
+      {
+        throw std::runtime_error("Failed to initialize Zstandard");
+      }
+    }
+#endif
+    else
+    {
+      throw std::runtime_error("Unsupported compression format");
+    }
+
+    setp(buffer.data(), buffer.data() + buffer.size());
+  }
+
+  /**
+   * @brief Finish the file if close_output was not called (Errors are ignored)
+   */
+  ~compressing_buffer_s() override
+  {
+    if (!finished)
+    {
+      try
+      {
+        finish();
+      }
+      catch (...)
+      {
+      }
+    }
+
+    if (compression == compression_e::gzip)
+    {
+      deflateEnd(&zlib_stream);
+    }
+#ifdef ALGOBOWL_ZSTD
+    else
+    {
+      ZSTD_freeCStream(zstd_stream);
+    }
+#endif
+  }
+
+  /**
+   * @brief Compress the buffered data to the file
+   * @param last Whether to end the compressed stream
+   */
+  void compress_buffer(const bool last)
+  {
+    const auto size = (std::size_t)(pptr() - pbase());
+
+    if (compression == compression_e::gzip)
+    {
+      zlib_stream.next_in = (const Bytef *)pbase();
+      zlib_stream.avail_in = (uInt)size;
+
+      int result;
+      do
+      {
+        zlib_stream.next_out = (Bytef *)compressed.data();
+        zlib_stream.avail_out = (uInt)compressed.size();
+
+        result = deflate(&zlib_stream, last ? Z_FINISH : Z_NO_FLUSH);
+        if (result == Z_STREAM_ERROR)
+        {
+          throw std::runtime_error("Failed to compress the gzip data");
+        }
+
+        file.write(compressed.data(), (std::streamsize)(compressed.size() - zlib_stream.avail_out));
+      } while (zlib_stream.avail_out == 0);
+    }
+#ifdef ALGOBOWL_ZSTD
+    else
+    {
+      ZSTD_inBuffer inBuffer{pbase(), size, 0};
+
+      std::size_t remaining;
+      do
+      {
+        ZSTD_outBuffer outBuffer{compressed.data(), compressed.size(), 0};
+
+        remaining = ZSTD_compressStream2(zstd_stream, &outBuffer, &inBuffer, last ? ZSTD_e_end : ZSTD_e_continue);
+        if (ZSTD_isError(remaining))
+        {
+          throw std::runtime_error(std::string("Failed to compress the Zstandard data: ") + ZSTD_getErrorName(remaining));
+        }
+
+        file.write(compressed.data(), (std::streamsize)outBuffer.pos);
+      } while (last ? remaining != 0 : inBuffer.pos < inBuffer.size);
+    }
+#endif
+
+    if (!file)
+    {
+      throw std::runtime_error("Failed to write the compressed file");
+    }
+
+    setp(buffer.data(), buffer.data() + buffer.size());
+  }
+
+  /**
+   * @brief Compress the full buffer
+   * @param character The character which did not fit
+   * @return The character, or end of file on failure
+   */
+  int_type overflow(int_type character) override
+  {
+    compress_buffer(false);
+
+    if (!traits_type::eq_int_type(character, traits_type::eof()))
+    {
+      *pptr() = traits_type::to_char_type(character);
+      pbump(1);
+    }
+
+    return traits_type::not_eof(character);
+  }
+
+  /**
+   * @brief Compress the buffered data
+   * @return 0 on success, -1 on failure
+   */
+  int sync() override
+  {
+    compress_buffer(false);
+    file.flush();
+
+    return file ? 0 : -1;
+  }
+
+  /**
+   * @brief Write the trailer and close the file
+   */
+  void finish()
+  {
+    finished = true;
+    compress_buffer(true);
+    file.close();
+
+    if (!file)
+    {
+      throw std::runtime_error("Failed to write the compressed file");
+    }
+  }
+};
+
+/**
+ * @brief A stream buffer which returns the bytes read to detect the format before the rest of a plain file (So the file
+ * never has to be rewound, which fails on pipes)
+ */
+struct prefixed_buffer_s : std::streambuf
+{
+  /**
+   * @brief The file
+   */
+  std::ifstream file;
+
+  /**
+   * @brief The bytes being read (The detected bytes first, then chunks of the file)
+   */
+  std::vector<char> buffer;
+
+  /**
+   * @brief Wrap a file
+   * @param input The file
+   * @param sniffed The bytes already read from the file
+   */
+  prefixed_buffer_s(std::ifstream &&input, std::vector<char> sniffed) : file(std::move(input)), buffer(std::move(sniffed))
+  {
+    setg(buffer.data(), buffer.data(), buffer.data() + buffer.size());
+  }
+
+  /**
+   * @brief Read the next chunk of the file
+   * @return The next character, or end of file
+   */
+  int_type underflow() override
+  {
+    buffer.resize(COMPRESSION_CHUNK_SIZE);
+    file.read(buffer.data(), (std::streamsize)buffer.size());
+    const auto count = (std::size_t)file.gcount();
+
+    if (count == 0)
+    {
+      if (file.bad())
+      {
+        throw std::runtime_error("Failed to read the file");
+      }
+
+      return traits_type::eof();
+    }
+
+    setg(buffer.data(), buffer.data(), buffer.data() + count);
+    return traits_type::to_int_type(*gptr());
+  }
+};
+
+/**
+ * @brief An input stream owning its buffer
+ */
+struct input_stream_s : std::istream
+{
+  /**
+   * @brief The buffer
+   */
+  std::unique_ptr<std::streambuf> buffer;
+
+  /**
+   * @brief Wrap a buffer (Read and decompression errors are rethrown from reads instead of only setting the bad bit)
+   * @param source The buffer
+   */
+  explicit input_stream_s(std::unique_ptr<std::streambuf> source) : std::istream(source.get()), buffer(std::move(source))
+  {
+    exceptions(std::ios::badbit);
+  }
+};
+
+/**
+ * @brief An output stream owning its compressing buffer
+ */
+struct output_stream_s : std::ostream
+{
+  /**
+   * @brief The buffer
+   */
+  std::unique_ptr<compressing_buffer_s> buffer;
+
+  /**
+   * @brief Wrap a buffer (Compression errors are rethrown from writes instead of only setting the bad bit)
+   * @param source The buffer
+   */
+  explicit output_stream_s(std::unique_ptr<compressing_buffer_s> source) : std::ostream(source.get()), buffer(std::move(source))
+  {
+    exceptions(std::ios::badbit);
+  }
+};
+
+bool compression_supported(const compression_e compression)
+{
+#ifdef ALGOBOWL_ZSTD
+  (void)compression;
+  return true;
+#else
+  return compression != compression_e::zstd;
+#endif
+}
+
+compression_e compression_from_extension(const std::string &filename)
+{
+  if (filename.ends_with(".gz"))
+  {
+    return compression_e::gzip;
+  }
+  else if (filename.ends_with(".zst"))
+  {
+    return compression_e::zstd;
+  }
+
+  return compression_e::none;
+}
+
+std::unique_ptr<std::istream> open_input(const std::string &filename)
+{
+  std::ifstream file(filename, std::ios::binary);
+  if (!file.is_open())
+  {
+    return nullptr;
+  }
+
+  // Detect the format from the magic bytes (gzip: 1f 8b, Zstandard: 28 b5 2f fd), keeping them for the reader instead of
+  // rewinding the file
+  std::vector<char> sniffed(4);
+  file.read(sniffed.data(), (std::streamsize)sniffed.size());
+  const auto count = file.gcount();
+  sniffed.resize((std::size_t)count);
+  file.clear();
+
+  const auto magic = [&sniffed](const std::size_t index)
+  { return (unsigned char)sniffed[index]; };
+
+  auto compression = compression_e::none;
+  if (2 <= count && magic(0) == 0x1f && magic(1) == 0x8b)
+  {
+    compression = compression_e::gzip;
+  }
+  else if (4 <= count && magic(0) == 0x28 && magic(1) == 0xb5 && magic(2) == 0x2f && magic(3) == 0xfd)
+  {
+    compression = compression_e::zstd;
+  }
+
+  if (compression == compression_e::none)
+  {
+    return std::make_unique<input_stream_s>(std::make_unique<prefixed_buffer_s>(std::move(file), std::move(sniffed)));
+  }
+
+  if (!compression_supported(compression))
+  {
+    throw std::runtime_error("The file is compressed with Zstandard, which this build does not support: " + filename);
+  }
+
+  return std::make_unique<input_stream_s>(std::make_unique<decompressing_buffer_s>(std::move(file), std::move(sniffed), compression));
+}
+
+std::unique_ptr<std::ostream> open_output(const std::string &filename, const compression_e compression)
+{
+  if (!compression_supported(compression))
+  {
+    throw std::invalid_argument("This build does not support Zstandard compression");
+  }
+
+  std::ofstream file(filename, std::ios::binary);
+  if (!file.is_open())
+  {
+    return nullptr;
+  }
+
+  if (compression == compression_e::none)
+  {
+    return std::make_unique<std::ofstream>(std::move(file));
+  }
+
+  return std::make_unique<output_stream_s>(std::make_unique<compressing_buffer_s>(std::move(file), compression));
+}
+
+void close_output(std::ostream &output)
+{
+  if (auto *stream = dynamic_cast<output_stream_s *>(&output))
+  {
+    stream->buffer->finish();
+  }
+  else if (auto *file = dynamic_cast<std::ofstream *>(&output))
+  {
+    file->close();
+  }
+
+  if (!output)
+  {
+    throw std::runtime_error("Failed to write the output file");
+  }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+
+/**
+ * @brief The number of bytes in each chunk handed between the decompression thread and the reader (Two chunks are in flight)
+ */
+#define COMPRESSION_CHUNK_SIZE (1 << 20)
+
+/**
+ * @brief File compression formats
+ */
+enum class compression_e
+{
+  /**
+   * @brief Plain text
+   */
+  none,
+
+  /**
+   * @brief gzip (zlib)
+   */
+  gzip,
+
+  /**
+   * @brief Zstandard (Only if the build found libzstd)
+   */
+  zstd,
+};
+
+/**
+ * @brief Check if a compression format is supported by this build
+ * @param compression The compression format
+ * @return True if files in the format can be read and written, false otherwise
+ */
+bool compression_supported(const compression_e compression);
+
+/**
+ * @brief Get the compression format implied by a file name
+ * @param filename The file name
+ * @return gzip for .gz, zstd for .zst, none otherwise
+ */
+compression_e compression_from_extension(const std::string &filename);
+
+/**
+ * @brief Open a file for reading, transparently decompressing gzip and Zstandard data (Detected by their magic bytes)
+ * @param filename The file name
+ * @return The stream (Compressed data is decompressed on a separate thread while the stream is read; decompression errors
+ * are thrown from the read), or nullptr if the file cannot be opened
+ */
+std::unique_ptr<std::istream> open_input(const std::string &filename);
+
+/**
+ * @brief Open a file for writing, compressing the data written to it
+ * @param filename The file name
+ * @param compression The compression format
+ * @return The stream (Finish it with close_output), or nullptr if the file cannot be opened
+ */
+std::unique_ptr<std::ostream> open_output(const std::string &filename, const compression_e compression);
+
+/**
+ * @brief Finish writing a stream opened with open_output (Writes the compressed trailer and closes the file)
+ * @param output The stream
+ */
+void close_output(std::ostream &output);
@@ -0,0 +1,181 @@
+#include <filesystem>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+#include "compression.hpp"
+#include "input.hpp"
+
+/**
+ * @brief Get a temporary file path unique to this process
+ * @param name The file name
+ * @return The path
+ */
+static std::string temporary_path(const std::string &name)
+{
+  return (std::filesystem::temp_directory_path() / ("compression-test-" + std::to_string(::getpid()) + "-" + name)).string();
+}
+
+/**
+ * @brief Write a string to a compressed file
+ * @param path The file path
+ * @param compression The compression format
+ * @param contents The contents
+ */
+static void write_file(const std::string &path, const compression_e compression, const std::string &contents)
+{
+  const auto output = open_output(path, compression);
+  ASSERT_NE(output, nullptr);
+  *output << contents;
+  close_output(*output);
+}
+
+/**
+ * @brief Read a file through open_input
+ * @param path The file path
+ * @return The decompressed contents
+ */
+static std::string read_file(const std::string &path)
+{
+  const auto input = open_input(path);
+  return std::string(std::istreambuf_iterator<char>(*input), std::istreambuf_iterator<char>());
+}
+
+/**
+ * @brief Build text spanning several decompression chunks
+ * @return The text
+ */
+static std::string build_text()
+{
+  std::string text;
+  for (std::size_t line = 0; text.size() < 3 * COMPRESSION_CHUNK_SIZE; line++)
+  {
+    text += std::to_string(line * 2654435761 % 1000003) + " " + std::to_string(line) + "\n";
+  }
+
+  return text;
+}
+
+TEST(compression, round_trip)
+{
+  // Build
+  const auto text = build_text();
+  const auto plainPath = temporary_path("plain.txt");
+  const auto gzipPath = temporary_path("text.gz");
+  write_file(plainPath, compression_e::none, text);
+  write_file(gzipPath, compression_from_extension(gzipPath), text);
+
+  // Assert the gzip file is compressed and both files read back
+  ASSERT_LT(std::filesystem::file_size(gzipPath), text.size() / 2);
+  ASSERT_EQ(read_file(plainPath), text);
+  ASSERT_EQ(read_file(gzipPath), text);
+
+  std::filesystem::remove(plainPath);
+  std::filesystem::remove(gzipPath);
+}
+
+TEST(compression, zstd_round_trip)
+{
+  if (!compression_supported(compression_e::zstd))
+  {
+    GTEST_SKIP() << "Zstandard is not supported by this build";
+  }
+
+  // Build
+  const auto text = build_text();
+  const auto path = temporary_path("text.zst");
+  write_file(path, compression_from_extension(path), text);
+
+  // Assert
+  ASSERT_EQ(read_file(path), text);
+
+  std::filesystem::remove(path);
+}
+
+TEST(compression, concatenated_members)
+{
+  // Build two gzip files and concatenate them
+  const auto firstPath = temporary_path("first.gz");
+  const auto secondPath = temporary_path("second.gz");
+  write_file(firstPath, compression_e::gzip, "3\n1 2\n");
+  write_file(secondPath, compression_e::gzip, "1 3\n1 1");
+
+  const auto joinedPath = temporary_path("joined.gz");
+  {
+    std::ofstream joined(joinedPath, std::ios::binary);
+    joined << std::ifstream(firstPath, std::ios::binary).rdbuf() << std::ifstream(secondPath, std::ios::binary).rdbuf();
+  }
+
+  // Assert the members are decompressed in sequence and parsed
+  const auto input = open_input(joinedPath);
+  const auto graph = deserialize_input(*input);
+  ASSERT_EQ(boost::num_vertices(graph), 3);
+  ASSERT_EQ(boost::num_edges(graph), 3);
+
+  std::filesystem::remove(firstPath);
+  std::filesystem::remove(secondPath);
+  std::filesystem::remove(joinedPath);
+}
+
+TEST(compression, truncated)
+{
+  // Build a gzip file and cut off its end
+  const auto text = build_text();
+  const auto path = temporary_path("truncated.gz");
+  write_file(path, compression_e::gzip, text);
+  std::filesystem::resize_file(path, std::filesystem::file_size(path) / 2);
+
+  // Assert reading it throws
+  ASSERT_THROW(read_file(path), std::runtime_error);
+
+  std::filesystem::remove(path);
+}
+
+TEST(compression, pipe)
+{
+  for (const auto compression : {compression_e::none, compression_e::gzip})
+  {
+    // Build a compressed file and a FIFO to stream it through (Which cannot be rewound)
+    const auto text = build_text();
+    const auto path = temporary_path("piped.txt");
+    const auto fifoPath = temporary_path("fifo");
+    write_file(path, compression, text);
+    ASSERT_EQ(::mkfifo(fifoPath.c_str(), 0600), 0);
+
+    std::thread writer([&path, &fifoPath]()
+                       { std::ofstream(fifoPath, std::ios::binary) << std::ifstream(path, std::ios::binary).rdbuf(); });
+
+    // Assert the format is detected and the file reads back
+    ASSERT_EQ(read_file(fifoPath), text);
+    writer.join();
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(fifoPath);
+  }
+}
+
+TEST(compression, abandoned)
+{
+  // Build
+  const auto text = build_text();
+  const auto path = temporary_path("abandoned.gz");
+  write_file(path, compression_e::gzip, text);
+
+  // Assert the stream can be destroyed before it is fully read
+  {
+    const auto input = open_input(path);
+    std::string word;
+    *input >> word;
+    ASSERT_EQ(word, "0");
+  }
+
+  // Assert missing files are reported
+  ASSERT_EQ(open_input(temporary_path("missing.gz")), nullptr);
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,78 @@
+#include <algorithm>
+#include <unordered_map>
+
+#include "csr.hpp"
+
+csr_graph_s build_csr(const graph_t &graph, ordered_vertex_descriptors_t &index_to_vertex)
+{
+  // Order the vertices by number
+  index_to_vertex.assign(boost::vertices(graph).first, boost::vertices(graph).second);
+  std::sort(index_to_vertex.begin(), index_to_vertex.end(), [&graph](const auto &a, const auto &b)
+            { return graph[a] < graph[b]; });
+
+  std::unordered_map<vertex_descriptor_t, csr_index_t> vertexToIndex;
+  vertexToIndex.reserve(index_to_vertex.size());
+  for (std::size_t index = 0; index < index_to_vertex.size(); index++)
+  {
+    vertexToIndex.emplace(index_to_vertex[index], (csr_index_t)index);
+  }
+
+  // Build the rows
+  csr_graph_s csr;
+  csr.numbers.reserve(index_to_vertex.size());
+  csr.out_offsets.reserve(index_to_vertex.size() + 1);
+  csr.out_targets.reserve(boost::num_edges(graph));
+  csr.in_offsets.reserve(index_to_vertex.size() + 1);
+  csr.in_sources.reserve(boost::num_edges(graph));
+
+  csr.out_offsets.push_back(0);
+  csr.in_offsets.push_back(0);
+  for (const auto &vertexDescriptor : index_to_vertex)
+  {
+    csr.numbers.push_back(graph[vertexDescriptor].number);
+
+    // Add the out-vertices
+    for (const auto &edgeDescriptor : boost::make_iterator_range(boost::out_edges(vertexDescriptor, graph)))
+    {
+      csr.out_targets.push_back(vertexToIndex[boost::target(edgeDescriptor, graph)]);
+    }
+
+    std::sort(csr.out_targets.begin() + csr.out_offsets.back(), csr.out_targets.end());
+    csr.out_offsets.push_back((csr_index_t)csr.out_targets.size());
+
+    // Add the in-vertices
+    for (const auto &edgeDescriptor : boost::make_iterator_range(boost::in_edges(vertexDescriptor, graph)))
+    {
+      csr.in_sources.push_back(vertexToIndex[boost::source(edgeDescriptor, graph)]);
+    }
+
+    std::sort(csr.in_sources.begin() + csr.in_offsets.back(), csr.in_sources.end());
+    csr.in_offsets.push_back((csr_index_t)csr.in_sources.size());
+  }
+
+  return csr;
+}
+
+graph_t build_graph(const csr_graph_s &csr, ordered_vertex_descriptors_t &index_to_vertex)
+{
+  graph_t graph;
+
+  // Add the vertices
+  index_to_vertex.clear();
+  index_to_vertex.reserve(csr.num_vertices());
+  for (const auto number : csr.numbers)
+  {
+    index_to_vertex.push_back(boost::add_vertex(vertex_properties_s{number}, graph));
+  }
+
+  // Add the edges
+  for (std::size_t vertex = 0; vertex < csr.num_vertices(); vertex++)
+  {
+    for (auto edge = csr.out_offsets[vertex]; edge < csr.out_offsets[vertex + 1]; edge++)
+    {
+      boost::add_edge(index_to_vertex[vertex], index_to_vertex[csr.out_targets[edge]], graph);
+    }
+  }
+
+  return graph;
+}
@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "common.hpp"
+
+/**
+ * @brief Dense vertex index (Position of a vertex within a compressed sparse row graph)
+ */
+typedef uint32_t csr_index_t;
+
+/**
+ * @brief Edge offset type for a vertex index type (At least 32 bits, since a graph with 16-bit vertex indices may still
+ * have more edges than 16 bits can count)
+ */
+template <typename Index>
+using csr_offset_t = std::conditional_t<sizeof(Index) < sizeof(uint32_t), uint32_t, Index>;
+
+/**
+ * @brief Compressed sparse row representation of a graph, with vertex indices of the given width
+ * @note Vertices are indexed in ascending order of their number and every row is sorted, so that the layout (And
+ * anything derived from it, such as random streams) does not depend on the order of the source graph
+ */
+template <typename Index>
+struct basic_csr_graph_s
+{
+  /**
+   * @brief The offset of each vertex's out-vertices in out_targets (With a trailing sentinel)
+   */
+  std::vector<csr_offset_t<Index>> out_offsets;
+
+  /**
+   * @brief The out-vertices of every vertex
+   */
+  std::vector<Index> out_targets;
+
+  /**
+   * @brief The offset of each vertex's in-vertices in in_sources (With a trailing sentinel)
+   */
+  std::vector<csr_offset_t<Index>> in_offsets;
+
+  /**
+   * @brief The in-vertices of every vertex
+   */
+  std::vector<Index> in_sources;
+
+  /**
+   * @brief The original number of each vertex (1-indexed)
+   */
+  std::vector<std::size_t> numbers;
+
+  /**
+   * @brief Get the number of vertices
+   * @return The number of vertices
+   */
+  std::size_t num_vertices() const
+  {
+    return numbers.size();
+  }
+
+  /**
+   * @brief Get the number of edges
+   * @return The number of edges
+   */
+  std::size_t num_edges() const
+  {
+    return out_targets.size();
+  }
+};
+
+/**
+ * @brief Compressed sparse row graph with the default index width
+ */
+typedef basic_csr_graph_s<csr_index_t> csr_graph_s;
+
+/**
+ * @brief Copy a compressed sparse row graph with another index width
+ * @param graph The graph
+ * @return The graph with Index vertex indices
+ * @throws std::invalid_argument If the vertices or edges do not fit the index width
+ */
+template <typename Index>
+basic_csr_graph_s<Index> convert_csr(const csr_graph_s &graph)
+{
+  if (std::numeric_limits<Index>::max() < graph.num_vertices() || std::numeric_limits<csr_offset_t<Index>>::max() < graph.num_edges())
+  {
+    throw std::invalid_argument("The graph does not fit the index width");
+  }
+
+  return basic_csr_graph_s<Index>{
+      std::vector<csr_offset_t<Index>>(graph.out_offsets.begin(), graph.out_offsets.end()),
+      std::vector<Index>(graph.out_targets.begin(), graph.out_targets.end()),
+      std::vector<csr_offset_t<Index>>(graph.in_offsets.begin(), graph.in_offsets.end()),
+      std::vector<Index>(graph.in_sources.begin(), graph.in_sources.end()),
+      graph.numbers,
+  };
+}
+
+/**
+ * @brief Build the compressed sparse row representation of a graph
+ * @param graph The graph
+ * @param index_to_vertex The vertex descriptor of each index (Output)
+ * @return The compressed sparse row graph
+ */
+csr_graph_s build_csr(const graph_t &graph, ordered_vertex_descriptors_t &index_to_vertex);
+
+/**
+ * @brief Build the adjacency list representation of a compressed sparse row graph
+ * @param csr The compressed sparse row graph
+ * @param index_to_vertex The vertex descriptor of each index (Output)
+ * @return The graph
+ */
+graph_t build_graph(const csr_graph_s &csr, ordered_vertex_descriptors_t &index_to_vertex);
@@ -0,0 +1,87 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "csr.hpp"
+#include "test_graphs.hpp"
+
+TEST(build_csr, sample)
+{
+  // Build the compressed sparse row graph
+  const auto csr = build_sample_csr();
+
+  // Assert the vertices
+  ASSERT_EQ(csr.num_vertices(), 5);
+  ASSERT_EQ(csr.num_edges(), 6);
+  ASSERT_EQ(csr.numbers, (std::vector<std::size_t>{1, 2, 3, 4, 5}));
+
+  // Assert the rows (1 -> 2, 4; 2 -> 3; 3 -> 1; 4 -> 5; 5 -> 1)
+  ASSERT_EQ(csr.out_offsets, (std::vector<csr_index_t>{0, 2, 3, 4, 5, 6}));
+  ASSERT_EQ(csr.out_targets, (std::vector<csr_index_t>{1, 3, 2, 0, 4, 0}));
+  ASSERT_EQ(csr.in_offsets, (std::vector<csr_index_t>{0, 2, 3, 4, 5, 6}));
+  ASSERT_EQ(csr.in_sources, (std::vector<csr_index_t>{2, 4, 0, 1, 0, 3}));
+}
+
+TEST(build_csr, empty)
+{
+  // Build the compressed sparse row graph
+  graph_t graph;
+  ordered_vertex_descriptors_t indexToVertex;
+  const auto csr = build_csr(graph, indexToVertex);
+
+  // Assert the graph
+  ASSERT_EQ(csr.num_vertices(), 0);
+  ASSERT_EQ(csr.num_edges(), 0);
+  ASSERT_EQ(csr.out_offsets, (std::vector<csr_index_t>{0}));
+}
+
+TEST(build_graph, round_trip)
+{
+  // Build the compressed sparse row graph and convert it back
+  const auto csr = build_sample_csr();
+  ordered_vertex_descriptors_t indexToVertex;
+  const auto graph = build_graph(csr, indexToVertex);
+
+  // Assert the graph
+  ASSERT_EQ(boost::num_vertices(graph), 5);
+  ASSERT_EQ(boost::num_edges(graph), 6);
+
+  for (std::size_t index = 0; index < indexToVertex.size(); index++)
+  {
+    ASSERT_EQ(graph[indexToVertex[index]].number, csr.numbers[index]);
+  }
+
+  // Assert the round trip
+  ordered_vertex_descriptors_t roundTripIndexToVertex;
+  const auto roundTrip = build_csr(graph, roundTripIndexToVertex);
+  ASSERT_EQ(roundTrip.out_offsets, csr.out_offsets);
+  ASSERT_EQ(roundTrip.out_targets, csr.out_targets);
+  ASSERT_EQ(roundTrip.in_sources, csr.in_sources);
+}
+
+TEST(convert_csr, narrow)
+{
+  // Build the compressed sparse row graph and narrow it
+  const auto csr = build_sample_csr();
+  const auto narrow = convert_csr<uint16_t>(csr);
+
+  // Assert the structure is unchanged
+  ASSERT_EQ(narrow.num_vertices(), csr.num_vertices());
+  ASSERT_EQ(narrow.numbers, csr.numbers);
+  ASSERT_EQ(std::vector<csr_index_t>(narrow.out_offsets.begin(), narrow.out_offsets.end()), csr.out_offsets);
+  ASSERT_EQ(std::vector<csr_index_t>(narrow.out_targets.begin(), narrow.out_targets.end()), csr.out_targets);
+  ASSERT_EQ(std::vector<csr_index_t>(narrow.in_offsets.begin(), narrow.in_offsets.end()), csr.in_offsets);
+  ASSERT_EQ(std::vector<csr_index_t>(narrow.in_sources.begin(), narrow.in_sources.end()), csr.in_sources);
+}
+
+TEST(convert_csr, too_wide)
+{
+  // Build a graph with more vertices than 16-bit indices can hold
+  csr_graph_s csr;
+  csr.numbers.resize(70000);
+  csr.out_offsets.assign(70001, 0);
+  csr.in_offsets.assign(70001, 0);
+
+  // Assert only the wider conversion succeeds
+  ASSERT_THROW(convert_csr<uint16_t>(csr), std::invalid_argument);
+  ASSERT_EQ(convert_csr<uint64_t>(csr).num_vertices(), 70000);
+}
@@ -0,0 +1,99 @@
+#include <algorithm>
+
+#include "cycles.hpp"
+#include "random.hpp"
+
+/**
+ * @brief Count the shortest cycles through a range of sampled pivots
+ * @param graph The graph
+ * @param first The first sample
+ * @param last One past the last sample
+ * @param seed The random seed
+ * @param component The component key
+ * @param counts The number of cycles through each vertex to add to
+ */
+static void count_cycles(const csr_graph_s &graph, const std::size_t first, const std::size_t last, const uint64_t seed, const std::size_t component, std::vector<std::size_t> &counts)
+{
+  const auto numVertices = graph.num_vertices();
+
+  // Searches are told apart by a stamp, so the buffers are never cleared
+  std::vector<std::size_t> visited(numVertices, 0);
+  std::vector<csr_index_t> parent(numVertices);
+  std::vector<csr_index_t> level;
+  std::vector<csr_index_t> nextLevel;
+  std::vector<csr_index_t> closing;
+
+  for (auto sample = first; sample < last; sample++)
+  {
+    auto stream = make_random_stream(seed, component, 0, sample);
+    const auto pivot = (csr_index_t)bounded_random(next_random(stream), (uint32_t)numVertices);
+    const auto stamp = sample + 1;
+
+    // Search level by level until an in-vertex of the pivot is reached
+    visited[pivot] = stamp;
+    level.assign(1, pivot);
+    closing.clear();
+
+    for (std::size_t depth = 0; depth < CYCLES_MAX_DEPTH && !level.empty() && closing.empty(); depth++)
+    {
+      nextLevel.clear();
+      for (const auto vertex : level)
+      {
+        for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+        {
+          const auto target = graph.out_targets[edge];
+          if (target == pivot)
+          {
+            closing.push_back(vertex);
+          }
+          else if (visited[target] != stamp)
+          {
+            visited[target] = stamp;
+            parent[target] = vertex;
+            nextLevel.push_back(target);
+          }
+        }
+      }
+
+      std::swap(level, nextLevel);
+    }
+
+    // Count the vertices on each shortest cycle
+    for (auto vertex : closing)
+    {
+      for (; vertex != pivot; vertex = parent[vertex])
+      {
+        counts[vertex]++;
+      }
+
+      counts[pivot]++;
+    }
+  }
+}
+
+std::vector<std::size_t> cycle_traffic(const csr_graph_s &graph, const std::size_t samples, const uint64_t seed, const std::size_t component, const std::size_t threads, const parallel_executor_t &parallel)
+{
+  const auto numVertices = graph.num_vertices();
+  if (numVertices == 0)
+  {
+    return {};
+  }
+
+  // Split the samples into contiguous ranges, one per thread
+  const auto workers = std::max<std::size_t>(1, std::min(threads, samples));
+  std::vector<std::vector<std::size_t>> counts(workers, std::vector<std::size_t>(numVertices, 0));
+
+  parallel_for(parallel, workers, [&](const std::size_t worker)
+               { count_cycles(graph, samples * worker / workers, samples * (worker + 1) / workers, seed, component, counts[worker]); });
+
+  // Sum the counts
+  for (std::size_t worker = 1; worker < workers; worker++)
+  {
+    for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+    {
+      counts[0][vertex] += counts[worker][vertex];
+    }
+  }
+
+  return std::move(counts[0]);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "csr.hpp"
+#include "helpers.hpp"
+
+/**
+ * @brief The maximum depth of each pivot's breadth-first search (Cycles longer than this plus one are not found)
+ */
+#define CYCLES_MAX_DEPTH 64
+
+/**
+ * @brief Count how many sampled short cycles pass through each vertex
+ * @param graph The graph
+ * @param samples The number of pivot vertices to sample (More samples trade time for a more accurate ranking)
+ * @param seed The random seed
+ * @param component The component key (Pivots are drawn from the random stream of the component and sample)
+ * @param threads The number of threads to split the samples between (The counts do not depend on it)
+ * @param parallel The executor to run the threads' samples on (If null, threads are started)
+ * @return The number of sampled cycles through each vertex (Ranked like random walk traffic)
+ * @note Each pivot runs a breadth-first search along out-edges, level by level up to CYCLES_MAX_DEPTH, and stops after
+ * the first level which reaches one of its in-vertices; every in-vertex reached then closes one shortest cycle through
+ * the pivot along the search tree, and each vertex on it is counted once
+ */
+std::vector<std::size_t> cycle_traffic(const csr_graph_s &graph, const std::size_t samples, const uint64_t seed, const std::size_t component, const std::size_t threads, const parallel_executor_t &parallel);
@@ -0,0 +1,49 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "cycles.hpp"
+#include "test_graphs.hpp"
+
+TEST(cycle_traffic, shared_vertex)
+{
+  // Build two triangles sharing vertex 1, with a sink hanging off vertex 3
+  const auto graph = build_graph(6, {{1, 2}, {2, 3}, {3, 1}, {1, 4}, {4, 5}, {5, 1}, {3, 6}});
+
+  // Count the cycles
+  const auto counts = cycle_traffic(graph, 200, 0, 1, 1, nullptr);
+
+  // Assert the shared vertex is on the most cycles and the sink is on none
+  ASSERT_EQ(counts.size(), 6);
+  ASSERT_EQ(counts[5], 0);
+  for (csr_index_t vertex = 1; vertex < 5; vertex++)
+  {
+    ASSERT_LT(0, counts[vertex]);
+    ASSERT_LT(counts[vertex], counts[0]);
+  }
+}
+
+TEST(cycle_traffic, self_loop)
+{
+  // Build a self-loop on vertex 2, reachable from a 2-cycle
+  const auto graph = build_graph(3, {{1, 3}, {3, 1}, {1, 2}, {2, 2}});
+
+  // Count the cycles
+  const auto counts = cycle_traffic(graph, 300, 0, 1, 1, nullptr);
+
+  // Assert each pivot only counts its shortest cycles
+  ASSERT_LT(0, counts[1]);
+  ASSERT_EQ(counts[0], counts[2]);
+}
+
+TEST(cycle_traffic, thread_invariance)
+{
+  // Build a random graph
+  const auto graph = build_random(500, 1500, 5);
+
+  // Assert the counts do not depend on the number of threads
+  const auto single = cycle_traffic(graph, 1000, 3, 1, 1, nullptr);
+  ASSERT_EQ(cycle_traffic(graph, 1000, 3, 1, 3, nullptr), single);
+  ASSERT_EQ(cycle_traffic(graph, 1000, 3, 1, 8, nullptr), single);
+  ASSERT_LT(0, *std::max_element(single.begin(), single.end()));
+}
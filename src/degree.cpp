@@ -0,0 +1,455 @@
+#include <algorithm>
+#include <bit>
+#include <limits>
+
+#include "degree.hpp"
+#include "filter.hpp"
+#include "scc.hpp"
+
+/**
+ * @brief Scores below this have a bucket each
+ */
+#define DEGREE_EXACT_BUCKETS 256
+
+/**
+ * @brief The number of buckets per power of two above DEGREE_EXACT_BUCKETS (The top bits of the score after the leading one)
+ */
+#define DEGREE_SUB_BUCKET_BITS 4
+
+/**
+ * @brief The number of buckets (Enough for any 64-bit score)
+ */
+#define DEGREE_BUCKETS (DEGREE_EXACT_BUCKETS + (64 - 8) * (1 << DEGREE_SUB_BUCKET_BITS))
+
+/**
+ * @brief Marker for an empty queue
+ */
+#define DEGREE_NONE std::numeric_limits<csr_index_t>::max()
+
+/**
+ * @brief Get the bucket of a score (Log-linear, so that scores within about 6% of each other may share a bucket)
+ * @param score The score
+ * @return The bucket
+ */
+static inline std::size_t score_bucket(const uint64_t score)
+{
+  if (score < DEGREE_EXACT_BUCKETS)
+  {
+    return score;
+  }
+
+  const auto exponent = (std::size_t)(63 - std::countl_zero(score));
+  const auto mantissa = (std::size_t)(score >> (exponent - DEGREE_SUB_BUCKET_BITS)) & ((1 << DEGREE_SUB_BUCKET_BITS) - 1);
+  return DEGREE_EXACT_BUCKETS + (exponent - 8) * (1 << DEGREE_SUB_BUCKET_BITS) + mantissa;
+}
+
+/**
+ * @brief Mutable graph being reduced and cut by the degree engine
+ */
+struct degree_state_s
+{
+  /**
+   * @brief The score to maximize
+   */
+  degree_score_e score;
+
+  /**
+   * @brief The out-vertices of each vertex (Unordered, without self-loops)
+   */
+  std::vector<std::vector<csr_index_t>> out;
+
+  /**
+   * @brief The in-vertices of each vertex (Unordered, without self-loops)
+   */
+  std::vector<std::vector<csr_index_t>> in;
+
+  /**
+   * @brief Whether each vertex is still in the graph
+   */
+  std::vector<uint8_t> alive;
+
+  /**
+   * @brief Whether each vertex has a self-loop
+   */
+  std::vector<uint8_t> loop;
+
+  /**
+   * @brief The number of vertices still in the graph
+   */
+  std::size_t alive_count = 0;
+
+  /**
+   * @brief The vertices whose reductions must be rechecked
+   */
+  std::vector<csr_index_t> worklist;
+
+  /**
+   * @brief Whether each vertex is in the worklist
+   */
+  std::vector<uint8_t> queued;
+
+  /**
+   * @brief The bucket queue (Entries whose bucket no longer matches the vertex's score are stale)
+   */
+  std::vector<std::vector<csr_index_t>> buckets;
+
+  /**
+   * @brief The highest bucket which may be non-empty
+   */
+  std::size_t top = 0;
+
+  /**
+   * @brief The cut vertices in removal order
+   */
+  std::vector<csr_index_t> cut;
+
+  /**
+   * @brief The number of sources and sinks removed by the reductions
+   */
+  std::size_t acyclic_removed = 0;
+
+  /**
+   * @brief The number of vertices bypassed by the reductions
+   */
+  std::size_t bypassed = 0;
+
+  /**
+   * @brief Get the score of a vertex
+   * @param vertex The vertex
+   * @return The score
+   */
+  uint64_t vertex_score(const csr_index_t vertex) const
+  {
+    if (score == degree_score_e::sum)
+    {
+      return (uint64_t)in[vertex].size() + out[vertex].size();
+    }
+
+    return (uint64_t)in[vertex].size() * out[vertex].size();
+  }
+
+  /**
+   * @brief Note that a vertex's neighborhood changed, queueing its reductions and its new score
+   * @param vertex The vertex
+   */
+  void touch(const csr_index_t vertex)
+  {
+    if (!alive[vertex])
+    {
+      return;
+    }
+
+    if (!queued[vertex])
+    {
+      queued[vertex] = 1;
+      worklist.push_back(vertex);
+    }
+
+    const auto bucket = score_bucket(vertex_score(vertex));
+    buckets[bucket].push_back(vertex);
+    top = std::max(top, bucket);
+  }
+
+  /**
+   * @brief Remove a vertex from an adjacency list
+   * @param list The adjacency list
+   * @param vertex The vertex
+   */
+  static void erase(std::vector<csr_index_t> &list, const csr_index_t vertex)
+  {
+    const auto position = std::find(list.begin(), list.end(), vertex);
+    *position = list.back();
+    list.pop_back();
+  }
+
+  /**
+   * @brief Remove a vertex and its edges
+   * @param vertex The vertex
+   */
+  void remove(const csr_index_t vertex)
+  {
+    alive[vertex] = 0;
+    alive_count--;
+
+    for (const auto target : out[vertex])
+    {
+      erase(in[target], vertex);
+      touch(target);
+    }
+
+    for (const auto source : in[vertex])
+    {
+      erase(out[source], vertex);
+      touch(source);
+    }
+
+    out[vertex].clear();
+    out[vertex].shrink_to_fit();
+    in[vertex].clear();
+    in[vertex].shrink_to_fit();
+  }
+
+  /**
+   * @brief Add an edge unless it exists
+   * @param source The source vertex
+   * @param target The target vertex
+   */
+  void add_edge(const csr_index_t source, const csr_index_t target)
+  {
+    if (source == target)
+    {
+      loop[source] = 1;
+    }
+    else if (std::find(out[source].begin(), out[source].end(), target) == out[source].end())
+    {
+      out[source].push_back(target);
+      in[target].push_back(source);
+      touch(target);
+    }
+
+    touch(source);
+  }
+
+  /**
+   * @brief Apply the reductions until none applies
+   */
+  void reduce()
+  {
+    while (!worklist.empty())
+    {
+      const auto vertex = worklist.back();
+      worklist.pop_back();
+      queued[vertex] = 0;
+
+      if (!alive[vertex])
+      {
+        continue;
+      }
+
+      // A self-loop must be cut
+      if (loop[vertex])
+      {
+        cut.push_back(vertex);
+        remove(vertex);
+      }
+      // A source or sink is on no cycle
+      else if (in[vertex].empty() || out[vertex].empty())
+      {
+        remove(vertex);
+        acyclic_removed++;
+      }
+      // Bypass a vertex with a single in-vertex
+      else if (in[vertex].size() == 1)
+      {
+        const auto source = in[vertex][0];
+        const auto targets = out[vertex];
+        remove(vertex);
+        bypassed++;
+
+        for (const auto target : targets)
+        {
+          add_edge(source, target);
+        }
+      }
+      // Bypass a vertex with a single out-vertex
+      else if (out[vertex].size() == 1)
+      {
+        const auto target = out[vertex][0];
+        const auto sources = in[vertex];
+        remove(vertex);
+        bypassed++;
+
+        for (const auto source : sources)
+        {
+          add_edge(source, target);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Pop the vertex with the largest score
+   * @return The vertex, or DEGREE_NONE if the graph is empty
+   */
+  csr_index_t pop()
+  {
+    while (true)
+    {
+      while (buckets[top].empty())
+      {
+        if (top == 0)
+        {
+          return DEGREE_NONE;
+        }
+
+        top--;
+      }
+
+      const auto vertex = buckets[top].back();
+      buckets[top].pop_back();
+
+      if (alive[vertex] && score_bucket(vertex_score(vertex)) == top)
+      {
+        return vertex;
+      }
+    }
+  }
+
+  /**
+   * @brief Split the graph into strongly connected components and drop the edges between them
+   */
+  void resplit()
+  {
+    // Build the compressed sparse row graph of the remaining vertices
+    std::vector<csr_index_t> compact(alive.size(), DEGREE_NONE);
+    csr_graph_s remaining;
+    for (std::size_t vertex = 0; vertex < alive.size(); vertex++)
+    {
+      if (alive[vertex])
+      {
+        compact[vertex] = (csr_index_t)remaining.numbers.size();
+        remaining.numbers.push_back(vertex);
+      }
+    }
+
+    remaining.out_offsets.push_back(0);
+    for (const auto vertex : remaining.numbers)
+    {
+      for (const auto target : out[vertex])
+      {
+        remaining.out_targets.push_back(compact[target]);
+      }
+
+      remaining.out_offsets.push_back((csr_index_t)remaining.out_targets.size());
+    }
+
+    const auto labels = label_components_iterative(remaining);
+
+    // Drop the edges between components
+    for (const auto vertex : remaining.numbers)
+    {
+      const auto label = labels[compact[vertex]];
+      for (std::size_t index = 0; index < out[vertex].size();)
+      {
+        const auto target = out[vertex][index];
+        if (labels[compact[target]] == label)
+        {
+          index++;
+          continue;
+        }
+
+        out[vertex][index] = out[vertex].back();
+        out[vertex].pop_back();
+        erase(in[target], (csr_index_t)vertex);
+        touch((csr_index_t)vertex);
+        touch(target);
+      }
+    }
+
+    reduce();
+  }
+};
+
+/**
+ * @brief Build the degree engine's state of a graph, with every vertex queued
+ * @param graph The graph
+ * @param score The score to maximize
+ * @return The state
+ */
+static degree_state_s make_degree_state(const csr_graph_s &graph, const degree_score_e score)
+{
+  const auto numVertices = graph.num_vertices();
+
+  degree_state_s state;
+  state.score = score;
+  state.out.resize(numVertices);
+  state.in.resize(numVertices);
+  state.alive.assign(numVertices, 1);
+  state.loop.assign(numVertices, 0);
+  state.queued.assign(numVertices, 0);
+  state.buckets.resize(DEGREE_BUCKETS);
+  state.alive_count = numVertices;
+
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+    {
+      const auto target = graph.out_targets[edge];
+      if (target == vertex)
+      {
+        state.loop[vertex] = 1;
+      }
+      else
+      {
+        state.out[vertex].push_back(target);
+        state.in[target].push_back(vertex);
+      }
+    }
+  }
+
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    state.touch(vertex);
+  }
+
+  return state;
+}
+
+degree_reduction_s degree_reduce(const csr_graph_s &graph)
+{
+  auto state = make_degree_state(graph, degree_score_e::product);
+  state.reduce();
+
+  std::size_t remainingEdges = 0;
+  for (const auto &targets : state.out)
+  {
+    remainingEdges += targets.size();
+  }
+
+  return degree_reduction_s{state.cut.size(), state.acyclic_removed, state.bypassed, state.alive_count, remainingEdges};
+}
+
+std::vector<csr_index_t> degree_cut(const csr_graph_s &graph, const degree_score_e score)
+{
+  const auto numVertices = graph.num_vertices();
+
+  // Cut the vertex with the largest score until the graph is empty
+  auto state = make_degree_state(graph, score);
+  state.reduce();
+
+  std::size_t removedSinceSplit = 0;
+  for (auto vertex = state.pop(); vertex != DEGREE_NONE; vertex = state.pop())
+  {
+    state.cut.push_back(vertex);
+    state.remove(vertex);
+    state.reduce();
+
+    if (std::max<std::size_t>(DEGREE_RESPLIT_MIN, state.alive_count / DEGREE_RESPLIT_DIVISOR) <= ++removedSinceSplit)
+    {
+      state.resplit();
+      removedSinceSplit = 0;
+    }
+  }
+
+  // Keep every uncut vertex, then try the cut vertices again in reverse removal order
+  std::vector<uint8_t> isCut(numVertices, 0);
+  for (const auto vertex : state.cut)
+  {
+    isCut[vertex] = 1;
+  }
+
+  std::vector<csr_index_t> order;
+  order.reserve(numVertices);
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    if (!isCut[vertex])
+    {
+      order.push_back(vertex);
+    }
+  }
+
+  const auto trusted = order.size();
+  order.insert(order.end(), state.cut.rbegin(), state.cut.rend());
+
+  return filter_acyclic(graph, order, trusted);
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vector>
+
+#include "csr.hpp"
+
+/**
+ * @brief The minimum number of greedy removals between strongly connected component re-splits
+ */
+#define DEGREE_RESPLIT_MIN 64
+
+/**
+ * @brief The fraction (1 / DEGREE_RESPLIT_DIVISOR) of the remaining vertices removed greedily between re-splits
+ */
+#define DEGREE_RESPLIT_DIVISOR 8
+
+/**
+ * @brief Vertex score maximized by the degree engine
+ */
+enum class degree_score_e
+{
+  /**
+   * @brief In-degree x out-degree (The number of 2-paths through the vertex)
+   */
+  product,
+
+  /**
+   * @brief In-degree + out-degree
+   */
+  sum,
+};
+
+/**
+ * @brief Effect of the degree engine's reductions on a graph
+ */
+struct degree_reduction_s
+{
+  /**
+   * @brief The number of vertices cut for having a self-loop (Including self-loops created by bypasses)
+   */
+  std::size_t forced;
+
+  /**
+   * @brief The number of sources and sinks removed (Including ones created by earlier removals)
+   */
+  std::size_t acyclic;
+
+  /**
+   * @brief The number of vertices with a single in-vertex or out-vertex bypassed
+   */
+  std::size_t bypassed;
+
+  /**
+   * @brief The number of vertices left for the engine to rank
+   */
+  std::size_t remaining_vertices;
+
+  /**
+   * @brief The number of edges left (Without self-loops or duplicate edges created by bypasses)
+   */
+  std::size_t remaining_edges;
+};
+
+/**
+ * @brief Apply the degree engine's reductions until none applies, without cutting anything else
+ * @param graph The graph
+ * @return The effect of the reductions
+ */
+degree_reduction_s degree_reduce(const csr_graph_s &graph);
+
+/**
+ * @brief Find a feedback vertex set by greedily cutting the vertex with the largest degree score
+ * @param graph The graph
+ * @param score The score to maximize
+ * @return The local indices of the vertices to cut in ascending order
+ * @note The self-loop, source/sink and in/out-degree one reductions are applied after every removal. Scores are kept in
+ * a log-linear bucket queue with lazy decrease-key (Stale entries are skipped when popped), the remaining graph is
+ * re-split into strongly connected components after every DEGREE_RESPLIT_DIVISOR-th of its vertices is removed (Edges
+ * between components are dropped), and cut vertices are finally kept again in reverse removal order where possible
+ */
+std::vector<csr_index_t> degree_cut(const csr_graph_s &graph, const degree_score_e score);
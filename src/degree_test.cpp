@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+#include <fstream>
+#include <vector>
+
+#include "bound.hpp"
+#include "degree.hpp"
+#include "exact.hpp"
+#include "filter.hpp"
+#include "input.hpp"
+#include "scc.hpp"
+#include "test_graphs.hpp"
+
+TEST(degree_cut, sample)
+{
+  // Build the graph
+  const auto graph = build_sample_csr();
+
+  // Assert vertex 1 (On both cycles) is cut with either score
+  ASSERT_EQ(degree_cut(graph, degree_score_e::product), (std::vector<csr_index_t>{0}));
+  ASSERT_EQ(degree_cut(graph, degree_score_e::sum), (std::vector<csr_index_t>{0}));
+}
+
+TEST(degree_cut, feasible)
+{
+  for (uint64_t seed = 0; seed < 4; seed++)
+  {
+    // Build a random graph
+    const auto graph = build_random(1000, 4000, seed);
+
+    for (const auto score : {degree_score_e::product, degree_score_e::sum})
+    {
+      // Cut the graph
+      const auto cut = degree_cut(graph, score);
+
+      // Assert the cut is feasible, minimal and no smaller than the lower bound
+      ASSERT_TRUE(std::is_sorted(cut.begin(), cut.end()));
+      ASSERT_TRUE(is_acyclic_without(graph, cut));
+      ASSERT_LE(cycle_packing_bound(graph), cut.size());
+
+      for (std::size_t index = 0; index < cut.size(); index++)
+      {
+        auto restored = cut;
+        restored.erase(restored.begin() + (std::ptrdiff_t)index);
+        ASSERT_FALSE(is_acyclic_without(graph, restored));
+      }
+    }
+  }
+}
+
+TEST(degree_cut, near_optimal)
+{
+  for (uint64_t seed = 0; seed < 10; seed++)
+  {
+    // Build a small random graph
+    const auto graph = build_random(40, 100, seed);
+
+    // Assert the cut is feasible and close to the optimum
+    const auto cut = degree_cut(graph, degree_score_e::product);
+    const auto optimum = solve_exact(graph, 1000000);
+    ASSERT_TRUE(is_acyclic_without(graph, cut));
+    ASSERT_TRUE(optimum.has_value());
+    ASSERT_LE(cut.size(), optimum->size() + 2);
+  }
+}
+
+TEST(degree_cut, large_component)
+{
+  // Open the file
+  std::ifstream file("test/6-random-outdeg-in.txt");
+
+  // Build the largest component
+  ordered_vertex_descriptors_t indexToVertex;
+  const auto graph = build_csr(deserialize_input(file), indexToVertex);
+  const auto decomposition = decompose(graph, 1, nullptr);
+
+  std::size_t largest = 0;
+  for (std::size_t component = 0; component < decomposition.num_components(); component++)
+  {
+    if (component_view_s{graph, decomposition, largest}.size() < component_view_s{graph, decomposition, component}.size())
+    {
+      largest = component;
+    }
+  }
+
+  const auto local = component_view_s{graph, decomposition, largest}.build_csr();
+
+  // Assert the cut is feasible
+  ASSERT_TRUE(is_acyclic_without(local, degree_cut(local, degree_score_e::product)));
+}
+
+TEST(degree_reduce, reductions)
+{
+  // Build a self-loop into a triangle with a sink hanging off it
+  graph_t graph;
+  std::vector<vertex_descriptor_t> vertices;
+  for (std::size_t number = 1; number <= 5; number++)
+  {
+    vertices.push_back(boost::add_vertex(vertex_properties_s{number}, graph));
+  }
+
+  for (const auto &[source, target] : std::vector<std::pair<std::size_t, std::size_t>>{{1, 1}, {1, 2}, {2, 3}, {3, 4}, {4, 2}, {2, 5}})
+  {
+    boost::add_edge(vertices[source - 1], vertices[target - 1], graph);
+  }
+
+  ordered_vertex_descriptors_t indexToVertex;
+  const auto reduction = degree_reduce(build_csr(graph, indexToVertex));
+
+  // Assert the reductions remove everything (The triangle collapses into a self-loop)
+  ASSERT_EQ(reduction.forced, 2);
+  ASSERT_EQ(reduction.acyclic, 1);
+  ASSERT_EQ(reduction.bypassed, 2);
+  ASSERT_EQ(reduction.remaining_vertices, 0);
+  ASSERT_EQ(reduction.remaining_edges, 0);
+
+  // Assert a random graph keeps its vertices accounted for
+  const auto random = build_random(500, 1200, 4);
+  const auto randomReduction = degree_reduce(random);
+  ASSERT_EQ(randomReduction.forced + randomReduction.acyclic + randomReduction.bypassed + randomReduction.remaining_vertices, random.num_vertices());
+  ASSERT_LT(0, randomReduction.remaining_vertices);
+}
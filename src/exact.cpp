@@ -0,0 +1,576 @@
+#include <array>
+#include <bit>
+#include <stdexcept>
+
+#include "exact.hpp"
+
+/**
+ * @brief Fixed-width vertex set
+ */
+template <std::size_t WORDS>
+struct vertex_set_s
+{
+  /**
+   * @brief The bits (Vertex i is bit i % 64 of word i / 64)
+   */
+  std::array<uint64_t, WORDS> words{};
+
+  /**
+   * @brief Add a vertex to the set
+   * @param vertex The vertex
+   */
+  void set(const std::size_t vertex)
+  {
+    words[vertex / 64] |= (uint64_t)1 << (vertex % 64);
+  }
+
+  /**
+   * @brief Remove a vertex from the set
+   * @param vertex The vertex
+   */
+  void reset(const std::size_t vertex)
+  {
+    words[vertex / 64] &= ~((uint64_t)1 << (vertex % 64));
+  }
+
+  /**
+   * @brief Check if a vertex is in the set
+   * @param vertex The vertex
+   * @return Whether the vertex is in the set
+   */
+  bool test(const std::size_t vertex) const
+  {
+    return (words[vertex / 64] >> (vertex % 64)) & 1;
+  }
+
+  /**
+   * @brief Check if the set is not empty
+   * @return Whether the set has any vertex
+   */
+  bool any() const
+  {
+    for (const auto word : words)
+    {
+      if (word != 0)
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  /**
+   * @brief Count the vertices in the set
+   * @return The number of vertices
+   */
+  std::size_t count() const
+  {
+    std::size_t count = 0;
+    for (const auto word : words)
+    {
+      count += (std::size_t)std::popcount(word);
+    }
+
+    return count;
+  }
+
+  /**
+   * @brief Get the smallest vertex in the set (The set must not be empty)
+   * @return The vertex
+   */
+  std::size_t first() const
+  {
+    for (std::size_t word = 0; word < WORDS; word++)
+    {
+      if (words[word] != 0)
+      {
+        return word * 64 + (std::size_t)std::countr_zero(words[word]);
+      }
+    }
+
+    return WORDS * 64;
+  }
+
+  /**
+   * @brief Call a function for every vertex in the set, in ascending order
+   * @param function The function
+   */
+  template <typename Function>
+  void for_each(const Function &function) const
+  {
+    for (std::size_t word = 0; word < WORDS; word++)
+    {
+      for (auto bits = words[word]; bits != 0; bits &= bits - 1)
+      {
+        function(word * 64 + (std::size_t)std::countr_zero(bits));
+      }
+    }
+  }
+
+  /**
+   * @brief Get the vertices in both sets
+   * @param other The other set
+   * @return The intersection
+   */
+  vertex_set_s operator&(const vertex_set_s &other) const
+  {
+    vertex_set_s result;
+    for (std::size_t word = 0; word < WORDS; word++)
+    {
+      result.words[word] = words[word] & other.words[word];
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Get the vertices in either set
+   * @param other The other set
+   * @return The union
+   */
+  vertex_set_s operator|(const vertex_set_s &other) const
+  {
+    vertex_set_s result;
+    for (std::size_t word = 0; word < WORDS; word++)
+    {
+      result.words[word] = words[word] | other.words[word];
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Get the vertices in this set but not the other
+   * @param other The other set
+   * @return The difference
+   */
+  vertex_set_s without(const vertex_set_s &other) const
+  {
+    vertex_set_s result;
+    for (std::size_t word = 0; word < WORDS; word++)
+    {
+      result.words[word] = words[word] & ~other.words[word];
+    }
+
+    return result;
+  }
+};
+
+/**
+ * @brief Search state (The adjacency is only meaningful for vertices in alive)
+ */
+template <std::size_t WORDS>
+struct exact_state_s
+{
+  /**
+   * @brief The vertices which have not been cut or reduced away
+   */
+  vertex_set_s<WORDS> alive;
+
+  /**
+   * @brief The out-vertices of each vertex
+   */
+  std::vector<vertex_set_s<WORDS>> out;
+
+  /**
+   * @brief The in-vertices of each vertex
+   */
+  std::vector<vertex_set_s<WORDS>> in;
+
+  /**
+   * @brief Bypass a vertex, connecting each of its in-vertices to each of its out-vertices
+   * @param vertex The vertex
+   */
+  void bypass(const std::size_t vertex)
+  {
+    const auto sources = in[vertex] & alive;
+    const auto targets = out[vertex] & alive;
+
+    sources.for_each([&](const std::size_t source)
+                     { out[source] = out[source] | targets; });
+    targets.for_each([&](const std::size_t target)
+                     { in[target] = in[target] | sources; });
+
+    alive.reset(vertex);
+  }
+};
+
+/**
+ * @brief Branch-and-reduce search
+ */
+template <std::size_t WORDS>
+struct exact_search_s
+{
+  /**
+   * @brief The number of nodes visited
+   */
+  std::size_t nodes = 0;
+
+  /**
+   * @brief The maximum number of nodes
+   */
+  std::size_t node_limit;
+
+  /**
+   * @brief Whether the node limit was exceeded
+   */
+  bool aborted = false;
+
+  /**
+   * @brief Apply the reductions until none applies
+   * @param state The state
+   * @return The vertices which must be cut
+   */
+  vertex_set_s<WORDS> reduce(exact_state_s<WORDS> &state)
+  {
+    vertex_set_s<WORDS> forced;
+
+    bool changed = true;
+    while (changed)
+    {
+      changed = false;
+
+      const auto snapshot = state.alive;
+      snapshot.for_each([&](const std::size_t vertex)
+                        {
+        const auto targets = state.out[vertex] & state.alive;
+        const auto sources = state.in[vertex] & state.alive;
+
+        // A self-loop must be cut
+        if (targets.test(vertex))
+        {
+          forced.set(vertex);
+          state.alive.reset(vertex);
+          changed = true;
+        }
+        // A source or sink is on no cycle
+        else if (!targets.any() || !sources.any())
+        {
+          state.alive.reset(vertex);
+          changed = true;
+        }
+        // Every cycle through a vertex with a single in-vertex or out-vertex also passes through that neighbor
+        else if (sources.count() == 1 || targets.count() == 1)
+        {
+          state.bypass(vertex);
+          changed = true;
+        } });
+    }
+
+    return forced;
+  }
+
+  /**
+   * @brief Get the vertices reachable from a vertex
+   * @param adjacency The out-vertices or in-vertices of each vertex
+   * @param alive The vertices to traverse
+   * @param vertex The vertex
+   * @return The reachable vertices (Including the vertex)
+   */
+  static vertex_set_s<WORDS> closure(const std::vector<vertex_set_s<WORDS>> &adjacency, const vertex_set_s<WORDS> &alive, const std::size_t vertex)
+  {
+    vertex_set_s<WORDS> reached;
+    reached.set(vertex);
+
+    auto frontier = reached;
+    while (frontier.any())
+    {
+      vertex_set_s<WORDS> next;
+      frontier.for_each([&](const std::size_t member)
+                        { next = next | adjacency[member]; });
+
+      frontier = (next & alive).without(reached);
+      reached = reached | frontier;
+    }
+
+    return reached;
+  }
+
+  /**
+   * @brief Split the state into strongly connected components
+   * @param state The state
+   * @return The components which contain a cycle
+   */
+  static std::vector<vertex_set_s<WORDS>> components(const exact_state_s<WORDS> &state)
+  {
+    std::vector<vertex_set_s<WORDS>> result;
+
+    auto remaining = state.alive;
+    while (remaining.any())
+    {
+      const auto vertex = remaining.first();
+      const auto component = closure(state.out, remaining, vertex) & closure(state.in, remaining, vertex);
+      remaining = remaining.without(component);
+
+      if (1 < component.count() || state.out[vertex].test(vertex))
+      {
+        result.push_back(component);
+      }
+    }
+
+    return result;
+  }
+
+  /**
+   * @brief Find a shortest cycle through a vertex
+   * @param state The state
+   * @param available The vertices the cycle may use
+   * @param vertex The vertex
+   * @return The vertices of the cycle (Empty if there is none)
+   */
+  static vertex_set_s<WORDS> shortest_cycle(const exact_state_s<WORDS> &state, const vertex_set_s<WORDS> &available, const std::size_t vertex)
+  {
+    // Breadth-first search, keeping each level to walk the cycle back
+    std::vector<vertex_set_s<WORDS>> levels(1);
+    levels[0].set(vertex);
+    auto reached = levels[0];
+
+    while (true)
+    {
+      vertex_set_s<WORDS> next;
+      levels.back().for_each([&](const std::size_t member)
+                             { next = next | state.out[member]; });
+      next = next & available;
+
+      // Walk the cycle back from the vertex
+      if (next.test(vertex))
+      {
+        vertex_set_s<WORDS> cycle;
+        cycle.set(vertex);
+
+        auto current = vertex;
+        for (std::size_t level = levels.size() - 1; 0 < level; level--)
+        {
+          current = (state.in[current] & levels[level]).first();
+          cycle.set(current);
+        }
+
+        return cycle;
+      }
+
+      next = next.without(reached);
+      if (!next.any())
+      {
+        return {};
+      }
+
+      reached = reached | next;
+      levels.push_back(next);
+    }
+  }
+
+  /**
+   * @brief Compute a lower bound with a greedy packing of vertex-disjoint cycles (2-cycles first, then shortest cycles)
+   * @param state The state
+   * @return The number of packed cycles
+   */
+  static std::size_t lower_bound(const exact_state_s<WORDS> &state)
+  {
+    auto available = state.alive;
+    std::size_t cycles = 0;
+
+    state.alive.for_each([&](const std::size_t vertex)
+                         {
+      if (!available.test(vertex))
+      {
+        return;
+      }
+
+      const auto partners = state.out[vertex] & state.in[vertex] & available;
+      if (partners.any())
+      {
+        available.reset(vertex);
+        available.reset(partners.first());
+        cycles++;
+      } });
+
+    state.alive.for_each([&](const std::size_t vertex)
+                         {
+      if (!available.test(vertex))
+      {
+        return;
+      }
+
+      const auto cycle = shortest_cycle(state, available, vertex);
+      if (cycle.any())
+      {
+        available = available.without(cycle);
+        cycles++;
+      } });
+
+    return cycles;
+  }
+
+  /**
+   * @brief Find a minimum feedback vertex set smaller than a budget
+   * @param state The state
+   * @param budget The exclusive upper bound on the size of the set
+   * @return The set, or nothing if there is none smaller than the budget (Or the search was abandoned)
+   */
+  std::optional<vertex_set_s<WORDS>> solve(exact_state_s<WORDS> state, const std::size_t budget)
+  {
+    if (node_limit < ++nodes)
+    {
+      aborted = true;
+    }
+
+    if (aborted)
+    {
+      return std::nullopt;
+    }
+
+    // Reduce
+    const auto forced = reduce(state);
+    const auto forcedCount = forced.count();
+    if (budget <= forcedCount)
+    {
+      return std::nullopt;
+    }
+
+    // Solve each strongly connected component independently
+    const auto cyclicComponents = components(state);
+    if (cyclicComponents.empty())
+    {
+      return forced;
+    }
+
+    if (1 < cyclicComponents.size())
+    {
+      auto total = forced;
+      for (const auto &component : cyclicComponents)
+      {
+        auto substate = state;
+        substate.alive = component;
+
+        const auto result = solve(substate, budget - total.count());
+        if (!result)
+        {
+          return std::nullopt;
+        }
+
+        total = total | *result;
+      }
+
+      return total;
+    }
+
+    // Prune with the lower bound
+    state.alive = cyclicComponents[0];
+    const auto lowerBound = lower_bound(state);
+    if (budget <= forcedCount + lowerBound)
+    {
+      return std::nullopt;
+    }
+
+    // Branch on the vertex with the largest in-degree x out-degree
+    std::size_t branchVertex = 0;
+    std::size_t branchScore = 0;
+    state.alive.for_each([&](const std::size_t vertex)
+                         {
+      const auto score = (state.in[vertex] & state.alive).count() * (state.out[vertex] & state.alive).count();
+      if (branchScore < score)
+      {
+        branchVertex = vertex;
+        branchScore = score;
+      } });
+
+    // Cut the vertex
+    std::optional<vertex_set_s<WORDS>> best;
+    auto remaining = budget - forcedCount;
+
+    auto cutState = state;
+    cutState.alive.reset(branchVertex);
+    if (const auto result = solve(cutState, remaining - 1))
+    {
+      best = *result;
+      best->set(branchVertex);
+      remaining = best->count();
+
+      // Stop if the packing proves the solution optimal
+      if (remaining == lowerBound)
+      {
+        return forced | *best;
+      }
+    }
+
+    // Keep the vertex
+    auto keepState = state;
+    keepState.bypass(branchVertex);
+    if (const auto result = solve(keepState, remaining))
+    {
+      best = *result;
+    }
+
+    if (!best)
+    {
+      return std::nullopt;
+    }
+
+    return forced | *best;
+  }
+};
+
+/**
+ * @brief Find a minimum feedback vertex set with vertex sets of a fixed width
+ * @param graph The graph
+ * @param node_limit The maximum number of search nodes
+ * @return The local indices of the set, or nothing if the search was abandoned
+ */
+template <std::size_t WORDS>
+static std::optional<std::vector<csr_index_t>> solve_exact_width(const csr_graph_s &graph, const std::size_t node_limit)
+{
+  const auto numVertices = graph.num_vertices();
+
+  // Build the state
+  exact_state_s<WORDS> state;
+  state.out.resize(numVertices);
+  state.in.resize(numVertices);
+  for (std::size_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    state.alive.set(vertex);
+
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+    {
+      state.out[vertex].set(graph.out_targets[edge]);
+      state.in[graph.out_targets[edge]].set(vertex);
+    }
+  }
+
+  // Search (Cutting every vertex always works, so a budget of one more always succeeds unless abandoned)
+  exact_search_s<WORDS> search;
+  search.node_limit = node_limit;
+
+  // Discard a cut found before the search was abandoned (A smaller one may be in the unexplored branches)
+  const auto result = search.solve(state, numVertices + 1);
+  if (!result || search.aborted)
+  {
+    return std::nullopt;
+  }
+
+  std::vector<csr_index_t> cut;
+  result->for_each([&cut](const std::size_t vertex)
+                   { cut.push_back((csr_index_t)vertex); });
+
+  return cut;
+}
+
+std::optional<std::vector<csr_index_t>> solve_exact(const csr_graph_s &graph, const std::size_t node_limit)
+{
+  const auto numVertices = graph.num_vertices();
+
+  if (numVertices <= 64)
+  {
+    return solve_exact_width<1>(graph, node_limit);
+  }
+  else if (numVertices <= 128)
+  {
+    return solve_exact_width<2>(graph, node_limit);
+  }
+  else if (numVertices <= EXACT_MAX_VERTICES)
+  {
+    return solve_exact_width<4>(graph, node_limit);
+  }
+
+  throw std::invalid_argument("The graph has more than " + std::to_string(EXACT_MAX_VERTICES) + " vertices");
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <optional>
+#include <vector>
+
+#include "csr.hpp"
+
+/**
+ * @brief The maximum number of vertices the exact solver accepts (The widest vertex set is 256 bits)
+ */
+#define EXACT_MAX_VERTICES 256
+
+/**
+ * @brief Find a minimum feedback vertex set with branch-and-reduce
+ * @param graph The graph (At most EXACT_MAX_VERTICES vertices)
+ * @param node_limit The maximum number of search nodes (If exceeded, the search is abandoned)
+ * @return The local indices of a minimum feedback vertex set in ascending order, or nothing if the search was abandoned
+ * @note Vertex sets are 64, 128 or 256-bit words depending on the size of the graph. Each node applies the self-loop,
+ * source/sink and in/out-degree one reductions, splits the graph into strongly connected components, and prunes with
+ * a greedy vertex-disjoint cycle packing before branching on cutting or bypassing the vertex with the largest
+ * in-degree x out-degree
+ */
+std::optional<std::vector<csr_index_t>> solve_exact(const csr_graph_s &graph, const std::size_t node_limit);
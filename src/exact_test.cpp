@@ -0,0 +1,196 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include "exact.hpp"
+#include "filter.hpp"
+#include "test_graphs.hpp"
+
+/**
+ * @brief Find the size of a minimum feedback vertex set by trying every subset
+ * @param graph The graph
+ * @return The size
+ */
+static std::size_t brute_force(const csr_graph_s &graph)
+{
+  std::size_t best = graph.num_vertices();
+  for (std::size_t mask = 0; mask < ((std::size_t)1 << graph.num_vertices()); mask++)
+  {
+    std::vector<csr_index_t> cut;
+    for (std::size_t vertex = 0; vertex < graph.num_vertices(); vertex++)
+    {
+      if ((mask >> vertex) & 1)
+      {
+        cut.push_back((csr_index_t)vertex);
+      }
+    }
+
+    if (cut.size() < best && is_acyclic_without(graph, cut))
+    {
+      best = cut.size();
+    }
+  }
+
+  return best;
+}
+
+TEST(solve_exact, cycle)
+{
+  // Build a cycle
+  std::vector<std::pair<csr_index_t, csr_index_t>> edges;
+  for (csr_index_t vertex = 0; vertex < 10; vertex++)
+  {
+    edges.emplace_back(vertex, (vertex + 1) % 10);
+  }
+
+  // Solve the graph
+  const auto cut = solve_exact(build_direct(10, edges), 1000);
+
+  // Assert a single vertex is cut
+  ASSERT_TRUE(cut.has_value());
+  ASSERT_EQ(cut->size(), 1);
+}
+
+TEST(solve_exact, complete)
+{
+  // Build a complete graph
+  std::vector<std::pair<csr_index_t, csr_index_t>> edges;
+  for (csr_index_t source = 0; source < 6; source++)
+  {
+    for (csr_index_t target = 0; target < 6; target++)
+    {
+      if (source != target)
+      {
+        edges.emplace_back(source, target);
+      }
+    }
+  }
+
+  // Solve the graph
+  const auto graph = build_direct(6, edges);
+  const auto cut = solve_exact(graph, 1000);
+
+  // Assert all but one vertex is cut
+  ASSERT_TRUE(cut.has_value());
+  ASSERT_EQ(cut->size(), 5);
+  ASSERT_TRUE(is_acyclic_without(graph, *cut));
+}
+
+TEST(solve_exact, self_loops)
+{
+  // Build a cycle where two vertices have self-loops
+  const auto graph = build_direct(4, {{0, 1}, {1, 2}, {2, 3}, {3, 0}, {1, 1}, {3, 3}});
+
+  // Solve the graph
+  const auto cut = solve_exact(graph, 1000);
+
+  // Assert exactly the self-loops are cut
+  ASSERT_TRUE(cut.has_value());
+  ASSERT_EQ(*cut, (std::vector<csr_index_t>{1, 3}));
+}
+
+TEST(solve_exact, matches_brute_force)
+{
+  for (uint64_t seed = 0; seed < 40; seed++)
+  {
+    // Build a random graph
+    const std::size_t numVertices = 8 + seed % 5;
+    const auto graph = build_random(numVertices, numVertices * (2 + seed % 3), seed);
+
+    // Solve the graph
+    const auto cut = solve_exact(graph, 1000000);
+
+    // Assert the cut is a minimum feedback vertex set
+    ASSERT_TRUE(cut.has_value());
+    ASSERT_TRUE(std::is_sorted(cut->begin(), cut->end()));
+    ASSERT_TRUE(is_acyclic_without(graph, *cut));
+    ASSERT_EQ(cut->size(), brute_force(graph));
+  }
+}
+
+TEST(solve_exact, widths_agree)
+{
+  for (uint64_t seed = 0; seed < 10; seed++)
+  {
+    // Build a random graph, and the same graph padded with isolated vertices to need wider vertex sets
+    const auto graph = build_random(40, 100, seed);
+
+    std::vector<std::pair<csr_index_t, csr_index_t>> edges;
+    for (std::size_t vertex = 0; vertex < graph.num_vertices(); vertex++)
+    {
+      for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+      {
+        edges.emplace_back((csr_index_t)vertex, graph.out_targets[edge]);
+      }
+    }
+
+    // Solve the graphs
+    const auto narrow = solve_exact(graph, 1000000);
+    const auto medium = solve_exact(build_direct(100, edges), 1000000);
+    const auto wide = solve_exact(build_direct(EXACT_MAX_VERTICES, edges), 1000000);
+
+    // Assert the cuts match
+    ASSERT_TRUE(narrow.has_value());
+    ASSERT_TRUE(is_acyclic_without(graph, *narrow));
+    ASSERT_EQ(medium, narrow);
+    ASSERT_EQ(wide, narrow);
+  }
+}
+
+TEST(solve_exact, wide)
+{
+  // Build a chain of 2-cycles across every vertex
+  std::vector<std::pair<csr_index_t, csr_index_t>> edges;
+  for (csr_index_t vertex = 0; vertex + 1 < EXACT_MAX_VERTICES; vertex++)
+  {
+    edges.emplace_back(vertex, vertex + 1);
+    edges.emplace_back(vertex + 1, vertex);
+  }
+
+  // Solve the graph
+  const auto graph = build_direct(EXACT_MAX_VERTICES, edges);
+  const auto cut = solve_exact(graph, 1000000);
+
+  // Assert every other vertex is cut
+  ASSERT_TRUE(cut.has_value());
+  ASSERT_EQ(cut->size(), EXACT_MAX_VERTICES / 2);
+  ASSERT_TRUE(is_acyclic_without(graph, *cut));
+}
+
+TEST(solve_exact, node_limit)
+{
+  // Build a random graph which needs branching
+  const auto graph = build_random(60, 300, 0);
+
+  // Assert the search is abandoned
+  ASSERT_FALSE(solve_exact(graph, 1).has_value());
+}
+
+TEST(solve_exact, abandoned_after_cut)
+{
+  for (uint64_t seed = 0; seed < 20; seed++)
+  {
+    // Build a random graph and solve it without a meaningful limit
+    const auto graph = build_random(30, 120, seed);
+    const auto optimal = solve_exact(graph, 1000000);
+    ASSERT_TRUE(optimal.has_value());
+
+    // Assert tiny limits either abandon the search or still return a minimum cut
+    for (std::size_t limit = 1; limit <= 64; limit++)
+    {
+      const auto cut = solve_exact(graph, limit);
+      if (cut)
+      {
+        ASSERT_EQ(cut->size(), optimal->size());
+      }
+    }
+  }
+}
+
+TEST(solve_exact, too_large)
+{
+  // Assert graphs above the maximum are rejected
+  ASSERT_THROW(solve_exact(build_direct(EXACT_MAX_VERTICES + 1, {}), 1000), std::invalid_argument);
+}
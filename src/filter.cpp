@@ -0,0 +1,170 @@
+#include <iostream>
+
+#include "filter.hpp"
+#include "helpers.hpp"
+#include "reachability.hpp"
+
+/**
+ * @brief Print the filter progress periodically
+ * @param processed The number of processed vertices
+ * @param total The total number of vertices
+ */
+static void print_progress(const std::size_t processed, const std::size_t total)
+{
+  if (processed % VERTEX_PROCESSING_PROGRESS_STRIDE == 0 && progress_enabled())
+  {
+    std::cout << "Processed vertex " << processed << " of " << total << " (" << processed * 100 / total << "%)" << std::endl;
+  }
+}
+
+/**
+ * @brief Collect the vertices which were not kept
+ * @param kept Whether each vertex was kept
+ * @return The local indices of the other vertices, in ascending order
+ */
+static std::vector<csr_index_t> collect_cut(const std::vector<uint8_t> &kept)
+{
+  std::vector<csr_index_t> cut;
+  for (std::size_t vertex = 0; vertex < kept.size(); vertex++)
+  {
+    if (!kept[vertex])
+    {
+      cut.push_back((csr_index_t)vertex);
+    }
+  }
+
+  return cut;
+}
+
+std::vector<csr_index_t> filter_acyclic(const csr_graph_s &graph, const std::vector<csr_index_t> &order, const std::size_t trusted)
+{
+  if (graph.num_vertices() <= REACHABILITY_MAX_VERTICES)
+  {
+    return filter_acyclic_bitset(graph, order, trusted);
+  }
+
+  return filter_acyclic_search(graph, order, trusted);
+}
+
+std::vector<csr_index_t> filter_acyclic_bitset(const csr_graph_s &graph, const std::vector<csr_index_t> &order, const std::size_t trusted)
+{
+  auto reachability = make_reachability(graph);
+
+  // Keep the trusted prefix
+  reachability.accept_acyclic(std::vector<csr_index_t>(order.begin(), order.begin() + (std::ptrdiff_t)trusted));
+
+  // Try keeping the rest
+  for (std::size_t processed = trusted; processed < order.size(); processed++)
+  {
+    reachability.try_accept(order[processed]);
+    print_progress(processed + 1, order.size());
+  }
+
+  return collect_cut(reachability.accepted);
+}
+
+std::vector<csr_index_t> filter_acyclic_search(const csr_graph_s &graph, const std::vector<csr_index_t> &order, const std::size_t trusted)
+{
+  std::vector<uint8_t> kept(graph.num_vertices(), 0);
+
+  // Visit stamps (Avoids clearing the visited set between searches)
+  std::vector<std::size_t> visited(graph.num_vertices(), 0);
+  std::vector<csr_index_t> stack;
+
+  std::size_t processed = 0;
+  for (const auto vertex : order)
+  {
+    processed++;
+
+    // Keep the trusted prefix
+    if (processed <= trusted)
+    {
+      kept[vertex] = 1;
+      print_progress(processed, order.size());
+      continue;
+    }
+
+    // Search the kept vertices reachable from the vertex for an edge back to it
+    bool cyclic = false;
+    stack.assign(1, vertex);
+    visited[vertex] = processed;
+
+    while (!stack.empty() && !cyclic)
+    {
+      const auto current = stack.back();
+      stack.pop_back();
+
+      for (auto edge = graph.out_offsets[current]; edge < graph.out_offsets[current + 1]; edge++)
+      {
+        const auto target = graph.out_targets[edge];
+        if (target == vertex)
+        {
+          cyclic = true;
+          break;
+        }
+
+        if (kept[target] && visited[target] != processed)
+        {
+          visited[target] = processed;
+          stack.push_back(target);
+        }
+      }
+    }
+
+    kept[vertex] = !cyclic;
+    print_progress(processed, order.size());
+  }
+
+  return collect_cut(kept);
+}
+
+bool is_acyclic_without(const csr_graph_s &graph, const std::vector<csr_index_t> &cut)
+{
+  std::vector<uint8_t> removed(graph.num_vertices(), 0);
+  for (const auto vertex : cut)
+  {
+    removed[vertex] = 1;
+  }
+
+  // Count the in-degree of every remaining vertex
+  std::vector<csr_index_t> inDegree(graph.num_vertices(), 0);
+  std::vector<csr_index_t> ready;
+  std::size_t remaining = 0;
+  for (std::size_t vertex = 0; vertex < graph.num_vertices(); vertex++)
+  {
+    if (removed[vertex])
+    {
+      continue;
+    }
+
+    for (auto edge = graph.in_offsets[vertex]; edge < graph.in_offsets[vertex + 1]; edge++)
+    {
+      inDegree[vertex] += !removed[graph.in_sources[edge]];
+    }
+
+    remaining++;
+    if (inDegree[vertex] == 0)
+    {
+      ready.push_back((csr_index_t)vertex);
+    }
+  }
+
+  // Remove sources until none is left
+  while (!ready.empty())
+  {
+    const auto vertex = ready.back();
+    ready.pop_back();
+    remaining--;
+
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+    {
+      const auto target = graph.out_targets[edge];
+      if (!removed[target] && --inDegree[target] == 0)
+      {
+        ready.push_back(target);
+      }
+    }
+  }
+
+  return remaining == 0;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+
+#include "csr.hpp"
+
+/**
+ * @brief The stide between progress updates for vertex processing
+ */
+#define VERTEX_PROCESSING_PROGRESS_STRIDE 250
+
+/**
+ * @brief Keep vertices in order while the kept vertices stay acyclic
+ * @param graph The graph
+ * @param order The vertices in the order to try keeping them
+ * @param trusted The length of the prefix of the order known to be acyclic together (Kept without checking)
+ * @return The local indices of the vertices which were not kept, in ascending order
+ * @note Uses filter_acyclic_bitset for graphs of at most REACHABILITY_MAX_VERTICES vertices and filter_acyclic_search
+ * otherwise; both keep exactly the same vertices
+ */
+std::vector<csr_index_t> filter_acyclic(const csr_graph_s &graph, const std::vector<csr_index_t> &order, const std::size_t trusted);
+
+/**
+ * @brief Keep vertices in order while the kept vertices stay acyclic, checking each vertex against bitset reachability rows
+ * @param graph The graph (At most REACHABILITY_MAX_VERTICES vertices)
+ * @param order The vertices in the order to try keeping them
+ * @param trusted The length of the prefix of the order known to be acyclic together (Kept without checking)
+ * @return The local indices of the vertices which were not kept, in ascending order
+ */
+std::vector<csr_index_t> filter_acyclic_bitset(const csr_graph_s &graph, const std::vector<csr_index_t> &order, const std::size_t trusted);
+
+/**
+ * @brief Keep vertices in order while the kept vertices stay acyclic, checking each vertex with a depth-first search
+ * @param graph The graph
+ * @param order The vertices in the order to try keeping them
+ * @param trusted The length of the prefix of the order known to be acyclic together (Kept without checking)
+ * @return The local indices of the vertices which were not kept, in ascending order
+ * @note Each check only searches the kept vertices reachable from the candidate, in O(|V| + |E|) memory
+ */
+std::vector<csr_index_t> filter_acyclic_search(const csr_graph_s &graph, const std::vector<csr_index_t> &order, const std::size_t trusted);
+
+/**
+ * @brief Check if a graph is acyclic after cutting some vertices (Kahn's algorithm)
+ * @param graph The graph
+ * @param cut The local indices of the cut vertices
+ * @return True if the remaining graph is acyclic, false otherwise
+ */
+bool is_acyclic_without(const csr_graph_s &graph, const std::vector<csr_index_t> &cut);
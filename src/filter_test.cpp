@@ -0,0 +1,152 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "filter.hpp"
+#include "helpers.hpp"
+#include "random.hpp"
+#include "test_graphs.hpp"
+
+/**
+ * @brief Build a random order of the vertices
+ * @param numVertices The number of vertices
+ * @param seed The random seed
+ * @return The order
+ */
+static std::vector<csr_index_t> build_order(const std::size_t numVertices, const uint64_t seed)
+{
+  auto stream = make_random_stream(seed, numVertices, 1, 0);
+
+  std::vector<csr_index_t> order(numVertices);
+  for (std::size_t index = 0; index < numVertices; index++)
+  {
+    order[index] = (csr_index_t)index;
+    std::swap(order[index], order[bounded_random(next_random(stream), (uint32_t)(index + 1))]);
+  }
+
+  return order;
+}
+
+/**
+ * @brief Keep vertices in order with the adjacency list graph and detect_cycles (Reference implementation)
+ * @param graph The graph
+ * @param indexToVertex The vertex descriptor of each index
+ * @param order The vertices in the order to try keeping them
+ * @return The local indices of the vertices which were not kept, in ascending order
+ */
+static std::vector<csr_index_t> filter_reference(const graph_t &graph, const ordered_vertex_descriptors_t &indexToVertex, const std::vector<csr_index_t> &order)
+{
+  std::vector<bool> kept(indexToVertex.size(), false);
+  for (const auto vertex : order)
+  {
+    kept[vertex] = true;
+
+    // Build the kept subgraph
+    graph_t subgraph;
+    std::unordered_map<vertex_descriptor_t, vertex_descriptor_t> clones;
+    for (std::size_t index = 0; index < indexToVertex.size(); index++)
+    {
+      if (kept[index])
+      {
+        clones[indexToVertex[index]] = boost::add_vertex(graph[indexToVertex[index]], subgraph);
+      }
+    }
+
+    for (const auto &edgeDescriptor : boost::make_iterator_range(boost::edges(graph)))
+    {
+      const auto source = clones.find(boost::source(edgeDescriptor, graph));
+      const auto target = clones.find(boost::target(edgeDescriptor, graph));
+      if (source != clones.end() && target != clones.end())
+      {
+        boost::add_edge(source->second, target->second, subgraph);
+      }
+    }
+
+    kept[vertex] = !detect_cycles(subgraph);
+  }
+
+  std::vector<csr_index_t> cut;
+  for (std::size_t index = 0; index < kept.size(); index++)
+  {
+    if (!kept[index])
+    {
+      cut.push_back((csr_index_t)index);
+    }
+  }
+
+  return cut;
+}
+
+TEST(filter_acyclic, matches_reference)
+{
+  for (uint64_t seed = 0; seed < 10; seed++)
+  {
+    // Build a random graph and order
+    const auto graph = build_random_graph(60, 150, seed);
+    ordered_vertex_descriptors_t indexToVertex;
+    const auto csr = build_csr(graph, indexToVertex);
+    const auto order = build_order(60, seed);
+
+    // Filter the graph
+    const auto expected = filter_reference(graph, indexToVertex, order);
+
+    // Assert both implementations match the reference
+    ASSERT_EQ(filter_acyclic_bitset(csr, order, 0), expected);
+    ASSERT_EQ(filter_acyclic_search(csr, order, 0), expected);
+  }
+}
+
+TEST(filter_acyclic, bitset_matches_search)
+{
+  for (uint64_t seed = 0; seed < 4; seed++)
+  {
+    // Build a random graph and order
+    const std::size_t numVertices = 2000;
+    const auto csr = build_random(numVertices, numVertices * 3, seed);
+    const auto order = build_order(numVertices, seed);
+
+    // Assert both implementations keep the same vertices
+    ASSERT_EQ(filter_acyclic_bitset(csr, order, 0), filter_acyclic_search(csr, order, 0));
+  }
+}
+
+TEST(is_acyclic_without, filtered)
+{
+  // Build a random graph and filter it
+  const auto csr = build_random(200, 600, 0);
+  auto cut = filter_acyclic(csr, build_order(200, 0), 0);
+
+  // Assert the filtered graph is acyclic and restoring a cut vertex is not
+  ASSERT_TRUE(is_acyclic_without(csr, cut));
+  ASSERT_FALSE(cut.empty());
+
+  cut.erase(cut.begin());
+  ASSERT_FALSE(is_acyclic_without(csr, cut));
+  ASSERT_FALSE(is_acyclic_without(csr, {}));
+}
+
+TEST(filter_acyclic, trusted_prefix)
+{
+  // Build a random graph and filter it
+  const std::size_t numVertices = 500;
+  const auto csr = build_random(numVertices, numVertices * 3, 0);
+  const auto order = build_order(numVertices, 0);
+  const auto cut = filter_acyclic_search(csr, order, 0);
+
+  // Put the kept vertices first, then the cut vertices
+  std::vector<csr_index_t> keptFirst;
+  for (const auto vertex : order)
+  {
+    if (!std::binary_search(cut.begin(), cut.end(), vertex))
+    {
+      keptFirst.push_back(vertex);
+    }
+  }
+
+  const auto trusted = keptFirst.size();
+  keptFirst.insert(keptFirst.end(), cut.begin(), cut.end());
+
+  // Assert trusting the kept prefix keeps the same vertices
+  ASSERT_EQ(filter_acyclic_bitset(csr, keptFirst, trusted), cut);
+  ASSERT_EQ(filter_acyclic_search(csr, keptFirst, trusted), cut);
+}
@@ -0,0 +1,581 @@
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <mutex>
+#include <new>
+#include <numeric>
+#include <string>
+#include <thread>
+
+#include "exact.hpp"
+#include "fvs.h"
+#include "helpers.hpp"
+#include "scc.hpp"
+#include "solve.hpp"
+
+/**
+ * @brief Turns progress messages off on the calling thread while it exists (The library never prints, but the host's
+ * own progress setting is restored afterwards)
+ */
+struct quiet_progress_s
+{
+  /**
+   * @brief The calling thread's setting before
+   */
+  bool previous;
+
+  /**
+   * @brief Turn progress messages off
+   */
+  quiet_progress_s() : previous(progress_enabled())
+  {
+    set_progress_enabled(false);
+  }
+
+  /**
+   * @brief Restore the previous setting
+   */
+  ~quiet_progress_s()
+  {
+    set_progress_enabled(previous);
+  }
+};
+
+/**
+ * @brief Solver handle
+ */
+struct fvs_solver
+{
+  /**
+   * @brief The solver options
+   */
+  solver_options_s options;
+
+  /**
+   * @brief The number of threads (Including the calling thread)
+   */
+  std::size_t threads;
+
+  /**
+   * @brief The pool threads
+   */
+  std::vector<std::thread> pool;
+
+  /**
+   * @brief Guards the job, the generation, the number of busy threads and the stopping flag
+   */
+  std::mutex mutex;
+
+  /**
+   * @brief Wakes the pool threads for a new job or for stopping
+   */
+  std::condition_variable wake;
+
+  /**
+   * @brief Wakes the calling thread once every pool thread finished the job
+   */
+  std::condition_variable idle;
+
+  /**
+   * @brief The job every pool thread runs
+   */
+  std::function<void()> job;
+
+  /**
+   * @brief The number of jobs started (Pool threads run each generation once)
+   */
+  std::size_t generation = 0;
+
+  /**
+   * @brief The number of pool threads still running the job
+   */
+  std::size_t busy = 0;
+
+  /**
+   * @brief Whether the pool threads should exit
+   */
+  bool stopping = false;
+
+  /**
+   * @brief The graph being solved (Its arrays keep their capacity across calls)
+   */
+  csr_graph_s graph;
+
+  /**
+   * @brief Scratch row counters
+   */
+  std::vector<csr_index_t> counts;
+
+  /**
+   * @brief Whether each vertex is cut
+   */
+  std::vector<uint8_t> cut;
+
+  /**
+   * @brief The message of the last failed call
+   */
+  std::string error;
+};
+
+/**
+ * @brief Run pool jobs until the solver stops
+ * @param solver The solver
+ */
+static void pool_loop(fvs_solver *solver)
+{
+  const quiet_progress_s quiet;
+
+  std::size_t seen = 0;
+  while (true)
+  {
+    std::unique_lock<std::mutex> lock(solver->mutex);
+    solver->wake.wait(lock, [solver, seen]()
+                      { return solver->stopping || solver->generation != seen; });
+
+    if (solver->stopping)
+    {
+      return;
+    }
+
+    seen = solver->generation;
+    lock.unlock();
+
+    solver->job();
+
+    lock.lock();
+    if (--solver->busy == 0)
+    {
+      solver->idle.notify_all();
+    }
+  }
+}
+
+/**
+ * @brief Run a job on every pool thread and the calling thread, and wait for all of them
+ * @param solver The solver
+ * @param job The job
+ */
+static void run_parallel(fvs_solver *solver, std::function<void()> job)
+{
+  {
+    std::lock_guard<std::mutex> lock(solver->mutex);
+    solver->job = std::move(job);
+    solver->busy = solver->pool.size();
+    solver->generation++;
+  }
+
+  solver->wake.notify_all();
+  solver->job();
+
+  std::unique_lock<std::mutex> lock(solver->mutex);
+  solver->idle.wait(lock, [solver]()
+                    { return solver->busy == 0; });
+}
+
+/**
+ * @brief Sort and deduplicate the rows of the solver's graph, then build its in-edges and vertex numbers
+ * @param solver The solver (Its out-offsets and out-targets must be filled)
+ */
+static void finish_graph(fvs_solver *solver)
+{
+  auto &graph = solver->graph;
+  const auto numVertices = graph.out_offsets.size() - 1;
+
+  // Sort and deduplicate each row in place, compacting the rows
+  csr_index_t write = 0;
+  csr_index_t rowStart = 0;
+  for (std::size_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    const auto first = graph.out_targets.begin() + rowStart;
+    const auto last = graph.out_targets.begin() + graph.out_offsets[vertex + 1];
+    std::sort(first, last);
+    const auto unique = std::unique(first, last);
+
+    rowStart = graph.out_offsets[vertex + 1];
+    graph.out_offsets[vertex] = write;
+    write = (csr_index_t)(std::copy(first, unique, graph.out_targets.begin() + write) - graph.out_targets.begin());
+  }
+
+  graph.out_offsets[numVertices] = write;
+  graph.out_targets.resize(write);
+
+  // Build the in-edges by counting (Sources come out sorted, since rows are visited in order)
+  solver->counts.assign(numVertices + 1, 0);
+  for (const auto target : graph.out_targets)
+  {
+    solver->counts[target + 1]++;
+  }
+
+  std::partial_sum(solver->counts.begin(), solver->counts.end(), solver->counts.begin());
+  graph.in_offsets.assign(solver->counts.begin(), solver->counts.end());
+  graph.in_sources.resize(graph.out_targets.size());
+
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+    {
+      graph.in_sources[solver->counts[graph.out_targets[edge]]++] = vertex;
+    }
+  }
+
+  graph.numbers.resize(numVertices);
+  std::iota(graph.numbers.begin(), graph.numbers.end(), 0);
+}
+
+/**
+ * @brief Solve the solver's graph and copy the cut out
+ * @param solver The solver
+ * @param cut The buffer to store the cut vertices in
+ * @param cutCapacity The number of entries in the buffer
+ * @param cutSize The number of cut vertices
+ * @return The status
+ */
+static int solve_graph(fvs_solver *solver, uint32_t *cut, const std::size_t cutCapacity, std::size_t *cutSize)
+{
+  const quiet_progress_s quiet;
+  const auto &graph = solver->graph;
+
+  // Run parallel work on the pool (Spreading the tasks over the pool threads and the calling thread)
+  const parallel_executor_t pool = [solver](const std::size_t count, const std::function<void(std::size_t)> &task)
+  {
+    std::atomic<std::size_t> next = 0;
+    run_parallel(solver, [&]()
+                 {
+                   for (auto index = next++; index < count; index = next++)
+                   {
+                     task(index);
+                   } });
+  };
+
+  const auto decomposition = decompose(graph, solver->threads, pool);
+
+  // Hand out the components which contain a cycle largest first
+  std::vector<std::size_t> components;
+  std::size_t multiVertex = 0;
+  for (std::size_t component = 0; component < decomposition.num_components(); component++)
+  {
+    const component_view_s view{graph, decomposition, component};
+    if (view.is_cyclic())
+    {
+      components.push_back(component);
+      multiVertex += 1 < view.size();
+    }
+  }
+
+  std::stable_sort(components.begin(), components.end(), [&](const std::size_t a, const std::size_t b)
+                   { return component_view_s{graph, decomposition, b}.size() < component_view_s{graph, decomposition, a}.size(); });
+
+  solver->cut.assign(graph.num_vertices(), 0);
+
+  // Solve a component and flag its cut vertices
+  auto componentOptions = solver->options;
+  const auto solve_one = [&](const std::size_t index)
+  {
+    const component_view_s component{graph, decomposition, components[index]};
+    const auto vertices = component.vertices();
+
+    // Cut singletons with a self-loop
+    if (component.size() == 1)
+    {
+      solver->cut[vertices[0]] = 1;
+      return;
+    }
+
+    try
+    {
+      // Components are disjoint, so their vertices' flags are written by one thread each
+      const auto solution = solve_component(component.build_csr(), componentOptions, std::nullopt);
+      for (const auto vertex : solution.cut)
+      {
+        solver->cut[vertices[vertex]] = 1;
+      }
+    }
+    catch (const std::exception &exception)
+    {
+      std::lock_guard<std::mutex> lock(solver->mutex);
+      if (solver->error.empty())
+      {
+        solver->error = exception.what();
+      }
+    }
+  };
+
+  // With fewer components than threads, solve them one at a time and run each simulation's threads on the pool;
+  // otherwise solve one component per thread at once (The cuts do not depend on the number of threads)
+  if (multiVertex < solver->threads)
+  {
+    componentOptions.simulation.threads = solver->threads;
+    componentOptions.simulation.parallel = pool;
+
+    for (std::size_t index = 0; index < components.size(); index++)
+    {
+      solve_one(index);
+    }
+  }
+  else
+  {
+    componentOptions.simulation.threads = 1;
+
+    std::atomic<std::size_t> next = 0;
+    run_parallel(solver, [&]()
+                 {
+                   for (auto index = next++; index < components.size(); index = next++)
+                   {
+                     solve_one(index);
+                   } });
+  }
+
+  if (!solver->error.empty())
+  {
+    return FVS_ERROR;
+  }
+
+  // Copy the cut out
+  *cutSize = (std::size_t)std::count(solver->cut.begin(), solver->cut.end(), 1);
+  if (cutCapacity < *cutSize)
+  {
+    return FVS_BUFFER_TOO_SMALL;
+  }
+
+  for (std::size_t vertex = 0; vertex < solver->cut.size(); vertex++)
+  {
+    if (solver->cut[vertex])
+    {
+      *cut++ = (uint32_t)vertex;
+    }
+  }
+
+  return FVS_OK;
+}
+
+/**
+ * @brief Check the common arguments of the solve functions
+ * @param solver The solver
+ * @param numVertices The number of vertices
+ * @param cut The cut buffer
+ * @param cutCapacity The number of entries in the cut buffer
+ * @param cutSize The number of cut vertices
+ * @return True if the arguments are valid, false otherwise (Setting the solver's error)
+ */
+static bool check_arguments(fvs_solver *solver, const std::size_t numVertices, const uint32_t *cut, const std::size_t cutCapacity, const std::size_t *cutSize)
+{
+  if (cutSize == nullptr || (cut == nullptr && cutCapacity != 0))
+  {
+    solver->error = "The cut buffer and size must not be null";
+    return false;
+  }
+
+  if (std::numeric_limits<csr_index_t>::max() <= numVertices)
+  {
+    solver->error = "Too many vertices";
+    return false;
+  }
+
+  return true;
+}
+
+void fvs_default_options(fvs_options_t *options)
+{
+  const solver_options_s defaults{};
+
+  *options = fvs_options_t{
+      sizeof(fvs_options_t),
+      SIMULATION_DEFAULT_AGENTS,
+      SIMULATION_DEFAULT_STEPS,
+      SIMULATION_DEFAULT_BATCHES,
+      SIMULATION_DEFAULT_CHANGE_THRESHOLD,
+      0,
+      std::thread::hardware_concurrency(),
+      defaults.exact_threshold,
+      defaults.exact_node_limit,
+      FVS_ENGINE_WALK,
+      FVS_STRATEGY_DIRECT,
+      defaults.divide_threshold,
+      defaults.divide_fraction,
+      defaults.cycle_samples,
+      FVS_REORDER_NONE,
+  };
+}
+
+fvs_solver_t *fvs_create(const fvs_options_t *options)
+{
+  if (options == nullptr)
+  {
+    return nullptr;
+  }
+
+  // Take the fields the caller knows about, and the defaults for the rest
+  fvs_options_t known;
+  fvs_default_options(&known);
+  std::memcpy(&known, options, std::min(options->size, sizeof(fvs_options_t)));
+
+  if (EXACT_MAX_VERTICES < known.exact_threshold || !(0 < known.divide_fraction && known.divide_fraction < 1) ||
+      (known.traffic_engine != FVS_ENGINE_WALK && known.traffic_engine != FVS_ENGINE_DEGREE && known.traffic_engine != FVS_ENGINE_CYCLES) ||
+      (known.strategy != FVS_STRATEGY_DIRECT && known.strategy != FVS_STRATEGY_DIVIDE && known.strategy != FVS_STRATEGY_PEEL) ||
+      known.reorder < FVS_REORDER_NONE || FVS_REORDER_DEGREE < known.reorder)
+  {
+    return nullptr;
+  }
+
+  auto *solver = new (std::nothrow) fvs_solver;
+  if (solver == nullptr)
+  {
+    return nullptr;
+  }
+
+  solver->threads = std::max<std::size_t>(1, known.threads);
+  solver->options.simulation = simulation_options_s{known.agents, known.steps, known.batches, known.change_threshold, known.seed, 0, solver->threads};
+  solver->options.exact_threshold = known.exact_threshold;
+  solver->options.exact_node_limit = known.exact_node_limit;
+  solver->options.traffic_engine = known.traffic_engine == FVS_ENGINE_CYCLES ? traffic_engine_e::cycles : known.traffic_engine == FVS_ENGINE_DEGREE ? traffic_engine_e::degree
+                                                                                                                                                       : traffic_engine_e::walk;
+  solver->options.cycle_samples = known.cycle_samples;
+  solver->options.strategy = known.strategy == FVS_STRATEGY_PEEL ? solve_strategy_e::peel : known.strategy == FVS_STRATEGY_DIVIDE ? solve_strategy_e::divide
+                                                                                                                                    : solve_strategy_e::direct;
+  solver->options.divide_threshold = known.divide_threshold;
+  solver->options.divide_fraction = known.divide_fraction;
+  solver->options.reorder = (reorder_e)known.reorder;
+
+  // Start the pool (The calling thread is the last worker)
+  try
+  {
+    for (std::size_t thread = 1; thread < solver->threads; thread++)
+    {
+      solver->pool.emplace_back(pool_loop, solver);
+    }
+  }
+  catch (const std::exception &)
+  {
+    fvs_destroy(solver);
+    return nullptr;
+  }
+
+  return solver;
+}
+
+void fvs_destroy(fvs_solver_t *solver)
+{
+  if (solver == nullptr)
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(solver->mutex);
+    solver->stopping = true;
+  }
+
+  solver->wake.notify_all();
+  for (auto &thread : solver->pool)
+  {
+    thread.join();
+  }
+
+  delete solver;
+}
+
+int fvs_solve_csr(fvs_solver_t *solver, size_t num_vertices, const uint32_t *offsets, const uint32_t *targets, uint32_t *cut, size_t cut_capacity, size_t *cut_size)
+{
+  if (solver == nullptr)
+  {
+    return FVS_INVALID_ARGUMENT;
+  }
+
+  solver->error.clear();
+  if (!check_arguments(solver, num_vertices, cut, cut_capacity, cut_size) || offsets == nullptr)
+  {
+    solver->error = solver->error.empty() ? "The offsets must not be null" : solver->error;
+    return FVS_INVALID_ARGUMENT;
+  }
+
+  // Validate the rows
+  const auto numEdges = offsets[num_vertices];
+  if (offsets[0] != 0 || !std::is_sorted(offsets, offsets + num_vertices + 1) || (targets == nullptr && numEdges != 0) ||
+      std::any_of(targets, targets + numEdges, [num_vertices](const uint32_t target)
+                  { return num_vertices <= target; }))
+  {
+    solver->error = "The offsets must ascend from 0 and the targets must be vertex indices";
+    return FVS_INVALID_ARGUMENT;
+  }
+
+  try
+  {
+    auto &graph = solver->graph;
+    graph.out_offsets.assign(offsets, offsets + num_vertices + 1);
+    graph.out_targets.assign(targets, targets + numEdges);
+    finish_graph(solver);
+
+    return solve_graph(solver, cut, cut_capacity, cut_size);
+  }
+  catch (const std::exception &exception)
+  {
+    solver->error = exception.what();
+    return FVS_ERROR;
+  }
+}
+
+int fvs_solve_edges(fvs_solver_t *solver, size_t num_vertices, size_t num_edges, const uint32_t *sources, const uint32_t *targets, uint32_t *cut, size_t cut_capacity, size_t *cut_size)
+{
+  if (solver == nullptr)
+  {
+    return FVS_INVALID_ARGUMENT;
+  }
+
+  solver->error.clear();
+  if (!check_arguments(solver, num_vertices, cut, cut_capacity, cut_size))
+  {
+    return FVS_INVALID_ARGUMENT;
+  }
+
+  if (num_edges != 0 && (sources == nullptr || targets == nullptr))
+  {
+    solver->error = "The edges must not be null";
+    return FVS_INVALID_ARGUMENT;
+  }
+
+  if (std::numeric_limits<csr_index_t>::max() <= num_edges || std::any_of(sources, sources + num_edges, [num_vertices](const uint32_t source)
+                                                                          { return num_vertices <= source; }) ||
+      std::any_of(targets, targets + num_edges, [num_vertices](const uint32_t target)
+                  { return num_vertices <= target; }))
+  {
+    solver->error = "The edges must join vertex indices";
+    return FVS_INVALID_ARGUMENT;
+  }
+
+  try
+  {
+    // Bucket the edges by source
+    auto &graph = solver->graph;
+    graph.out_offsets.assign(num_vertices + 1, 0);
+    for (std::size_t edge = 0; edge < num_edges; edge++)
+    {
+      graph.out_offsets[sources[edge] + 1]++;
+    }
+
+    std::partial_sum(graph.out_offsets.begin(), graph.out_offsets.end(), graph.out_offsets.begin());
+    solver->counts.assign(graph.out_offsets.begin(), graph.out_offsets.end() - 1);
+    graph.out_targets.resize(num_edges);
+
+    for (std::size_t edge = 0; edge < num_edges; edge++)
+    {
+      graph.out_targets[solver->counts[sources[edge]]++] = targets[edge];
+    }
+
+    finish_graph(solver);
+
+    return solve_graph(solver, cut, cut_capacity, cut_size);
+  }
+  catch (const std::exception &exception)
+  {
+    solver->error = exception.what();
+    return FVS_ERROR;
+  }
+}
+
+const char *fvs_last_error(const fvs_solver_t *solver)
+{
+  return solver == nullptr ? "The solver must not be null" : solver->error.c_str();
+}
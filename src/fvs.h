@@ -0,0 +1,260 @@
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+/**
+ * @brief Export a function from the shared library (Everything else is hidden)
+ */
+#define FVS_API __attribute__((visibility("default")))
+#else
+#define FVS_API
+#endif
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+  /**
+   * @brief Status codes
+   */
+  enum fvs_status
+  {
+    /**
+     * @brief The call succeeded
+     */
+    FVS_OK = 0,
+
+    /**
+     * @brief An argument is invalid (See fvs_last_error)
+     */
+    FVS_INVALID_ARGUMENT = 1,
+
+    /**
+     * @brief The cut buffer is too small (The required size is stored in cut_size)
+     */
+    FVS_BUFFER_TOO_SMALL = 2,
+
+    /**
+     * @brief Solving failed (See fvs_last_error)
+     */
+    FVS_ERROR = 3,
+  };
+
+  /**
+   * @brief Vertex ranking engines
+   */
+  enum fvs_traffic_engine
+  {
+    /**
+     * @brief Random walk traffic, improved with the degree engine's cut
+     */
+    FVS_ENGINE_WALK = 0,
+
+    /**
+     * @brief Greedy degree engine only
+     */
+    FVS_ENGINE_DEGREE = 1,
+
+    /**
+     * @brief Sampled short cycle counts, improved with the degree engine's cut
+     */
+    FVS_ENGINE_CYCLES = 2,
+  };
+
+  /**
+   * @brief Strategies for large components
+   */
+  enum fvs_strategy
+  {
+    /**
+     * @brief Simulate and filter once
+     */
+    FVS_STRATEGY_DIRECT = 0,
+
+    /**
+     * @brief Cut the highest-traffic vertices, re-split and recurse in parallel (Much slower than direct, without a
+     * smaller cut on the test inputs)
+     */
+    FVS_STRATEGY_DIVIDE = 1,
+
+    /**
+     * @brief Cut the highest-traffic vertices in rounds with refreshed traffic
+     */
+    FVS_STRATEGY_PEEL = 2,
+  };
+
+  /**
+   * @brief Vertex relabelings for memory locality
+   */
+  enum fvs_reorder
+  {
+    /**
+     * @brief Keep the vertices in index order
+     */
+    FVS_REORDER_NONE = 0,
+
+    /**
+     * @brief Breadth-first search order
+     */
+    FVS_REORDER_BFS = 1,
+
+    /**
+     * @brief Reverse Cuthill-McKee order
+     */
+    FVS_REORDER_RCM = 2,
+
+    /**
+     * @brief Descending degree
+     */
+    FVS_REORDER_DEGREE = 3,
+  };
+
+  /**
+   * @brief Solver options (Fill with fvs_default_options, then override; fields are only ever appended, and size tells
+   * the library which fields the caller knows about)
+   */
+  typedef struct fvs_options
+  {
+    /**
+     * @brief sizeof(fvs_options_t) as compiled by the caller
+     */
+    size_t size;
+
+    /**
+     * @brief The number of agents per batch
+     */
+    size_t agents;
+
+    /**
+     * @brief The number of steps per agent per batch
+     */
+    size_t steps;
+
+    /**
+     * @brief The maximum number of batches
+     */
+    size_t batches;
+
+    /**
+     * @brief The mean normalized traffic change below which the simulation stops
+     */
+    double change_threshold;
+
+    /**
+     * @brief The random seed (The cut is identical for a given seed regardless of the number of threads)
+     */
+    uint64_t seed;
+
+    /**
+     * @brief The number of threads in the solver's pool
+     */
+    size_t threads;
+
+    /**
+     * @brief The number of vertices at or below which a component is solved exactly (At most 256)
+     */
+    size_t exact_threshold;
+
+    /**
+     * @brief The maximum number of exact search nodes per component
+     */
+    size_t exact_node_limit;
+
+    /**
+     * @brief The vertex ranking engine (An fvs_traffic_engine)
+     */
+    int traffic_engine;
+
+    /**
+     * @brief The strategy for large components (An fvs_strategy)
+     */
+    int strategy;
+
+    /**
+     * @brief The number of vertices above which the divide or peel strategy is used
+     */
+    size_t divide_threshold;
+
+    /**
+     * @brief The fraction of the highest-traffic vertices cut before each re-split or peel round
+     */
+    double divide_fraction;
+
+    /**
+     * @brief The number of pivot vertices the cycles engine samples per component
+     */
+    size_t cycle_samples;
+
+    /**
+     * @brief The relabeling of the copy each component's random walks run on, for memory locality (An fvs_reorder; the
+     * cut is unchanged)
+     */
+    int reorder;
+  } fvs_options_t;
+
+  /**
+   * @brief Solver handle (Owns a thread pool and buffers reused across calls; calls on one handle must not overlap)
+   * @note A solver never prints. Its pool threads and, for the duration of each solve call, the calling thread are
+   * silenced; no other thread of the host is affected
+   */
+  typedef struct fvs_solver fvs_solver_t;
+
+  /**
+   * @brief Fill the options with the solver's defaults
+   * @param options The options
+   */
+  FVS_API void fvs_default_options(fvs_options_t *options);
+
+  /**
+   * @brief Create a solver
+   * @param options The options (Copied)
+   * @return The solver, or NULL if the options are invalid or allocation failed
+   */
+  FVS_API fvs_solver_t *fvs_create(const fvs_options_t *options);
+
+  /**
+   * @brief Destroy a solver, joining its threads
+   * @param solver The solver (May be NULL)
+   */
+  FVS_API void fvs_destroy(fvs_solver_t *solver);
+
+  /**
+   * @brief Find a feedback vertex set of a graph given as compressed sparse rows
+   * @param solver The solver
+   * @param num_vertices The number of vertices
+   * @param offsets The out-edges of vertex v are targets[offsets[v]] to targets[offsets[v + 1] - 1] (num_vertices + 1 entries)
+   * @param targets The target of each edge (Vertex indices start at 0; duplicates and self-loops are allowed)
+   * @param cut The buffer to store the cut vertices in, in ascending order
+   * @param cut_capacity The number of entries in the buffer
+   * @param cut_size The number of cut vertices (Also set if the buffer is too small)
+   * @return The status
+   */
+  FVS_API int fvs_solve_csr(fvs_solver_t *solver, size_t num_vertices, const uint32_t *offsets, const uint32_t *targets, uint32_t *cut, size_t cut_capacity, size_t *cut_size);
+
+  /**
+   * @brief Find a feedback vertex set of a graph given as an edge list
+   * @param solver The solver
+   * @param num_vertices The number of vertices
+   * @param num_edges The number of edges
+   * @param sources The source of each edge
+   * @param targets The target of each edge
+   * @param cut The buffer to store the cut vertices in, in ascending order
+   * @param cut_capacity The number of entries in the buffer
+   * @param cut_size The number of cut vertices (Also set if the buffer is too small)
+   * @return The status
+   */
+  FVS_API int fvs_solve_edges(fvs_solver_t *solver, size_t num_vertices, size_t num_edges, const uint32_t *sources, const uint32_t *targets, uint32_t *cut, size_t cut_capacity, size_t *cut_size);
+
+  /**
+   * @brief Get the message of the last failed call on a solver
+   * @param solver The solver
+   * @return The message (Valid until the next call on the solver; empty if the last call succeeded)
+   */
+  FVS_API const char *fvs_last_error(const fvs_solver_t *solver);
+
+#ifdef __cplusplus
+}
+#endif
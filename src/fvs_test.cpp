@@ -0,0 +1,246 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "filter.hpp"
+#include "fvs.h"
+#include "helpers.hpp"
+#include "test_graphs.hpp"
+
+/**
+ * @brief A random edge list
+ */
+struct edge_list_s
+{
+  /**
+   * @brief The number of vertices
+   */
+  std::size_t num_vertices;
+
+  /**
+   * @brief The source of each edge
+   */
+  std::vector<uint32_t> sources;
+
+  /**
+   * @brief The target of each edge
+   */
+  std::vector<uint32_t> targets;
+};
+
+/**
+ * @brief Build a random edge list (With duplicate edges and self-loops)
+ * @param numVertices The number of vertices
+ * @param numEdges The number of edges
+ * @param seed The random seed
+ * @return The edge list
+ */
+static edge_list_s build_edges(const std::size_t numVertices, const std::size_t numEdges, const uint64_t seed)
+{
+  edge_list_s edges{numVertices, {}, {}};
+  for (const auto &[source, target] : build_random_edges(numVertices, numEdges, seed))
+  {
+    edges.sources.push_back(source);
+    edges.targets.push_back(target);
+  }
+
+  return edges;
+}
+
+/**
+ * @brief Create a solver with small simulations
+ * @param threads The number of threads
+ * @return The solver
+ */
+static fvs_solver_t *create_solver(const std::size_t threads)
+{
+  fvs_options_t options;
+  fvs_default_options(&options);
+  options.agents = 16;
+  options.steps = 16;
+  options.batches = 4;
+  options.threads = threads;
+  options.exact_threshold = 8;
+
+  return fvs_create(&options);
+}
+
+TEST(fvs, edges_match_csr)
+{
+  // Build the graph both ways
+  const auto edges = build_edges(300, 900, 1);
+  const auto csr = build_random(300, 900, 1);
+  const std::vector<uint32_t> offsets(csr.out_offsets.begin(), csr.out_offsets.end());
+  const std::vector<uint32_t> targets(csr.out_targets.begin(), csr.out_targets.end());
+
+  // Solve the graph twice with each input on one solver
+  auto *solver = create_solver(4);
+  ASSERT_NE(solver, nullptr);
+
+  std::vector<uint32_t> cut(edges.num_vertices);
+  std::size_t cutSize = 0;
+  ASSERT_EQ(fvs_solve_edges(solver, edges.num_vertices, edges.sources.size(), edges.sources.data(), edges.targets.data(), cut.data(), cut.size(), &cutSize), FVS_OK);
+  const std::vector<csr_index_t> edgeCut(cut.begin(), cut.begin() + (std::ptrdiff_t)cutSize);
+
+  for (std::size_t call = 0; call < 2; call++)
+  {
+    ASSERT_EQ(fvs_solve_csr(solver, edges.num_vertices, offsets.data(), targets.data(), cut.data(), cut.size(), &cutSize), FVS_OK);
+    ASSERT_EQ(std::vector<csr_index_t>(cut.begin(), cut.begin() + (std::ptrdiff_t)cutSize), edgeCut);
+  }
+
+  fvs_destroy(solver);
+
+  // Assert the cut is feasible and ascending
+  ASSERT_TRUE(is_acyclic_without(csr, edgeCut));
+  ASSERT_TRUE(std::is_sorted(edgeCut.begin(), edgeCut.end()));
+}
+
+TEST(fvs, progress_restored)
+{
+  // Create a solver
+  const auto edges = build_edges(300, 900, 2);
+  auto *solver = create_solver(2);
+  ASSERT_NE(solver, nullptr);
+  ASSERT_TRUE(progress_enabled());
+
+  std::vector<uint32_t> cut(edges.num_vertices);
+  std::size_t cutSize = 0;
+  for (const auto enabled : {true, false})
+  {
+    // Solve the graph with the calling thread's progress messages on and off
+    set_progress_enabled(enabled);
+    ASSERT_EQ(fvs_solve_edges(solver, edges.num_vertices, edges.sources.size(), edges.sources.data(), edges.targets.data(), cut.data(), cut.size(), &cutSize), FVS_OK);
+
+    // Assert the setting is restored
+    ASSERT_EQ(progress_enabled(), enabled);
+  }
+
+  set_progress_enabled(true);
+  fvs_destroy(solver);
+}
+
+TEST(fvs, thread_invariance)
+{
+  // Build the graph
+  const auto edges = build_edges(400, 1000, 2);
+
+  // Solve it with different numbers of threads
+  std::vector<uint32_t> expected;
+  for (std::size_t threads = 1; threads <= 4; threads++)
+  {
+    auto *solver = create_solver(threads);
+    std::vector<uint32_t> cut(edges.num_vertices);
+    std::size_t cutSize = 0;
+    ASSERT_EQ(fvs_solve_edges(solver, edges.num_vertices, edges.sources.size(), edges.sources.data(), edges.targets.data(), cut.data(), cut.size(), &cutSize), FVS_OK);
+    fvs_destroy(solver);
+
+    cut.resize(cutSize);
+    if (threads == 1)
+    {
+      expected = cut;
+    }
+
+    // Assert the cut
+    ASSERT_EQ(cut, expected);
+  }
+}
+
+TEST(fvs, divide_on_pool)
+{
+  // Build a graph with one large component (So its pieces are solved on the pool)
+  const auto edges = build_edges(1000, 3000, 4);
+
+  // Solve it twice on one solver with each number of threads
+  std::vector<uint32_t> expected;
+  for (const std::size_t threads : {1, 4})
+  {
+    fvs_options_t options;
+    fvs_default_options(&options);
+    options.agents = 16;
+    options.steps = 16;
+    options.batches = 4;
+    options.threads = threads;
+    options.exact_threshold = 8;
+    options.strategy = FVS_STRATEGY_DIVIDE;
+    options.divide_threshold = 100;
+
+    auto *solver = fvs_create(&options);
+    ASSERT_NE(solver, nullptr);
+
+    for (std::size_t call = 0; call < 2; call++)
+    {
+      std::vector<uint32_t> cut(edges.num_vertices);
+      std::size_t cutSize = 0;
+      ASSERT_EQ(fvs_solve_edges(solver, edges.num_vertices, edges.sources.size(), edges.sources.data(), edges.targets.data(), cut.data(), cut.size(), &cutSize), FVS_OK);
+
+      cut.resize(cutSize);
+      if (expected.empty())
+      {
+        expected = cut;
+      }
+
+      // Assert the cut
+      ASSERT_EQ(cut, expected);
+    }
+
+    fvs_destroy(solver);
+  }
+}
+
+TEST(fvs, parallel_decomposition)
+{
+  // Build a graph large enough for the parallel decomposition (The solver and graphstat reject graphs this large)
+  const auto edges = build_edges(SCC_PARALLEL_THRESHOLD + 1000, SCC_PARALLEL_THRESHOLD + 1000, 3);
+  const auto csr = build_random(SCC_PARALLEL_THRESHOLD + 1000, SCC_PARALLEL_THRESHOLD + 1000, 3);
+
+  // Solve it with one thread (Tarjan's algorithm) and four threads (The Forward-Backward algorithm)
+  std::vector<std::vector<csr_index_t>> cuts;
+  for (const std::size_t threads : {1, 4})
+  {
+    auto *solver = create_solver(threads);
+    std::vector<uint32_t> cut(edges.num_vertices);
+    std::size_t cutSize = 0;
+    ASSERT_EQ(fvs_solve_edges(solver, edges.num_vertices, edges.sources.size(), edges.sources.data(), edges.targets.data(), cut.data(), cut.size(), &cutSize), FVS_OK);
+    fvs_destroy(solver);
+
+    cuts.emplace_back(cut.begin(), cut.begin() + (std::ptrdiff_t)cutSize);
+  }
+
+  // Assert the cuts match and are feasible
+  ASSERT_EQ(cuts[0], cuts[1]);
+  ASSERT_FALSE(cuts[0].empty());
+  ASSERT_TRUE(is_acyclic_without(csr, cuts[0]));
+}
+
+TEST(fvs, errors)
+{
+  // Build a graph with a cycle
+  const std::vector<uint32_t> sources{0, 1, 2};
+  const std::vector<uint32_t> targets{1, 2, 0};
+
+  auto *solver = create_solver(2);
+  uint32_t cut[1];
+  std::size_t cutSize = 0;
+
+  // Assert a buffer which is too small reports the required size
+  ASSERT_EQ(fvs_solve_edges(solver, 3, 3, sources.data(), targets.data(), cut, 0, &cutSize), FVS_BUFFER_TOO_SMALL);
+  ASSERT_EQ(cutSize, 1);
+
+  // Assert invalid graphs are rejected
+  ASSERT_EQ(fvs_solve_edges(solver, 2, 3, sources.data(), targets.data(), cut, 1, &cutSize), FVS_INVALID_ARGUMENT);
+  ASSERT_STRNE(fvs_last_error(solver), "");
+
+  const std::vector<uint32_t> offsets{0, 2, 1, 3};
+  ASSERT_EQ(fvs_solve_csr(solver, 3, offsets.data(), targets.data(), cut, 1, &cutSize), FVS_INVALID_ARGUMENT);
+
+  // Assert the solver still works
+  ASSERT_EQ(fvs_solve_edges(solver, 3, 3, sources.data(), targets.data(), cut, 1, &cutSize), FVS_OK);
+  ASSERT_EQ(cutSize, 1);
+  ASSERT_STREQ(fvs_last_error(solver), "");
+  fvs_destroy(solver);
+
+  // Assert invalid options are rejected
+  fvs_options_t options;
+  fvs_default_options(&options);
+  options.divide_fraction = 1.5;
+  ASSERT_EQ(fvs_create(&options), nullptr);
+}
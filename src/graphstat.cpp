@@ -0,0 +1,93 @@
+#include <iostream>
+#include <thread>
+
+#include "boost/program_options.hpp"
+#include "compression.hpp"
+#include "input.hpp"
+#include "stats.hpp"
+
+int main(int argc, char *argv[])
+{
+  // Arguments
+  boost::program_options::positional_options_description positional;
+  positional.add("input", -1);
+
+  // Options
+  boost::program_options::options_description description("Allowed options");
+  description.add_options()                                                                                                                                                           // Force wrap
+      ("input", boost::program_options::value<std::vector<std::string>>(), "Input files (Compressed files are detected automatically)")                                               // Force wrap
+      ("json", boost::program_options::bool_switch()->default_value(false), "Print one JSON object per line instead of human-readable text")                                          // Force wrap
+      ("agents", boost::program_options::value<std::size_t>()->default_value(1000), "Number of agents to estimate the work for")                                                      // Force wrap
+      ("steps", boost::program_options::value<std::size_t>()->default_value(1000), "Number of steps to estimate the work for")                                                        // Force wrap
+      ("batches", boost::program_options::value<std::size_t>()->default_value(250), "Maximum number of batches to estimate the work for")                                             // Force wrap
+      ("exact-threshold", boost::program_options::value<std::size_t>()->default_value(64), "Number of vertices at or below which a component is solved exactly instead of simulated") // Force wrap
+      ("threads", boost::program_options::value<std::size_t>()->default_value(std::thread::hardware_concurrency()), "Number of threads for the decomposition")                        // Force wrap
+      ("help", "Print this help message");
+
+  // Parse the arguments and options
+  boost::program_options::variables_map options;
+  boost::program_options::store(boost::program_options::command_line_parser(argc, argv).options(description).positional(positional).run(), options);
+  boost::program_options::notify(options);
+
+  // Print help
+  if (options.contains("help"))
+  {
+    std::cout << description << std::endl;
+    return 1;
+  }
+  // Validate the input
+  else if (!options.contains("input"))
+  {
+    std::cerr << "Error: at least one input file is required" << std::endl;
+    return 1;
+  }
+
+  // Get the options
+  std::vector<std::string> inputFilenames = options["input"].as<std::vector<std::string>>();
+  bool json = options["json"].as<bool>();
+
+  solver_options_s solverOptions;
+  solverOptions.simulation.agents = options["agents"].as<std::size_t>();
+  solverOptions.simulation.steps = options["steps"].as<std::size_t>();
+  solverOptions.simulation.batches = options["batches"].as<std::size_t>();
+  solverOptions.simulation.threads = options["threads"].as<std::size_t>();
+  solverOptions.exact_threshold = options["exact-threshold"].as<std::size_t>();
+
+  // Profile each file, continuing past the ones which fail
+  int status = 0;
+  for (const auto &inputFilename : inputFilenames)
+  {
+    try
+    {
+      // Open inside the try, since undecodable compressed files throw
+      const auto input = open_input(inputFilename);
+
+      if (input == nullptr)
+      {
+        std::cerr << "Error: failed to open input file: " << inputFilename << std::endl;
+        status = 1;
+        continue;
+      }
+
+      ordered_vertex_descriptors_t indexToVertex;
+      const auto csr = build_csr(deserialize_input(*input), indexToVertex);
+      const auto stats = profile_graph(csr, solverOptions);
+
+      if (json)
+      {
+        print_stats_json(std::cout, inputFilename, stats);
+      }
+      else
+      {
+        print_stats(std::cout, inputFilename, stats);
+      }
+    }
+    catch (const std::exception &error)
+    {
+      std::cerr << "Error: failed to profile " << inputFilename << ": " << error.what() << std::endl;
+      status = 1;
+    }
+  }
+
+  return status;
+}
@@ -1,35 +1,22 @@
 #include <algorithm>
+#include <array>
 #include <iostream>
+#include <numeric>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
-#include "boost/graph/strong_components.hpp"
 #include "boost/graph/topological_sort.hpp"
 #include "boost/range/algorithm/sort.hpp"
+#include "csr.hpp"
 #include "helpers.hpp"
+#include "scc.hpp"
 
 /**
- * @brief The random number generator
+ * @brief The number of bits per radix sort digit
  */
-static boost::random::mt19937 rng(0);
-
-std::size_t random_integer(const std::size_t start, const std::size_t end)
-{
-  // Initialize the distribution
-  boost::random::uniform_int_distribution<std::size_t> distribution(start, end - 1);
-
-  // Generate the random number
-  std::size_t number = distribution(rng);
-
-  return number;
-}
-
-void set_seed(const uint32_t seed)
-{
-  // Set the seed
-  rng.seed(seed);
-}
+#define RANK_RADIX_BITS 8
 
 bool only_whitespace_remaining(std::istream &input)
 {
@@ -42,92 +29,153 @@ bool only_whitespace_remaining(std::istream &input)
       });
 }
 
-ordered_graphs_t tarjans_subgraphs(const graph_t &graph)
+/**
+ * @brief Whether progress messages are printed on this thread
+ */
+static thread_local bool progressEnabled = true;
+
+void set_progress_enabled(const bool enabled)
 {
-  // Build the vertex to index bimap
-  std::unordered_map<vertex_descriptor_t, std::size_t> vertexToIndex;
-  std::unordered_map<std::size_t, vertex_descriptor_t> indexToVertex;
+  progressEnabled = enabled;
+}
 
-  for (const auto &vertexDescriptor : boost::make_iterator_range(boost::vertices(graph)))
+bool progress_enabled()
+{
+  return progressEnabled;
+}
+
+void parallel_for(const parallel_executor_t &executor, const std::size_t count, const std::function<void(std::size_t)> &task)
+{
+  if (executor && 1 < count)
   {
-    vertexToIndex.emplace(vertexDescriptor, vertexToIndex.size());
-    indexToVertex.emplace(indexToVertex.size(), vertexDescriptor);
+    executor(count, task);
+    return;
   }
 
-  // Build the vertex index property map
-  auto vertexToIndexPropertyMap = boost::make_assoc_property_map(vertexToIndex);
-  std::vector<std::size_t> vertexIndexToComponentIndex(boost::num_vertices(graph));
-  auto indexMap = boost::make_iterator_property_map(vertexIndexToComponentIndex.begin(), vertexToIndexPropertyMap);
+  std::vector<std::thread> threads;
+  for (std::size_t index = 0; index + 1 < count; index++)
+  {
+    threads.emplace_back(task, index);
+  }
 
-  // Run Tarjan's algorithm
-  std::size_t numSCCs = boost::strong_components(
-      graph,
-      indexMap,
-      boost::vertex_index_map(vertexToIndexPropertyMap));
+  if (0 < count)
+  {
+    task(count - 1);
+  }
+
+  for (auto &thread : threads)
+  {
+    thread.join();
+  }
+}
+
+ordered_graphs_t tarjans_subgraphs(const graph_t &graph)
+{
+  // Decompose the graph
+  ordered_vertex_descriptors_t indexToVertex;
+  const auto csr = build_csr(graph, indexToVertex);
+  const auto decomposition = decompose(csr, 1, nullptr);
 
   // Build the subgraphs
   ordered_graphs_t subgraphs;
-  subgraphs.reserve(numSCCs);
-  for (std::size_t i = 0; i < numSCCs; i++)
+  subgraphs.reserve(decomposition.num_components());
+  for (std::size_t component = 0; component < decomposition.num_components(); component++)
   {
-    subgraphs.push_back(graph_t());
+    subgraphs.push_back(component_view_s{csr, decomposition, component}.build_subgraph());
   }
 
-  /**
-   * @brief The vertex index to subgraph vertex map
-   */
-  std::unordered_map<std::size_t, vertex_descriptor_t> vertexIndexToSubgraphVertex(numSCCs);
+  return subgraphs;
+}
 
-  /**
-   * @brief The vertex indices for each component (relative to the input graph)
-   */
-  std::vector<std::unordered_set<std::size_t>> componentsVerticesIndex(numSCCs);
+std::size_t merge_rerank(std::vector<std::size_t> &order, const std::vector<std::size_t> &values)
+{
+  const auto less = [&values](const std::size_t a, const std::size_t b)
+  {
+    return values[a] < values[b] || (values[a] == values[b] && a < b);
+  };
 
-  // Group vertices by component and add them to the subgraphs
-  for (std::size_t i = 0; i < vertexToIndex.size(); i++)
+  // Merge runs of doubling width, counting the inversions each merge removes
+  std::vector<std::size_t> buffer(order.size());
+  std::size_t inversions = 0;
+  for (std::size_t width = 1; width < order.size(); width *= 2)
   {
-    // Get information
-    const auto componentIndex = vertexIndexToComponentIndex[i];
-    const auto vertexDescriptor = indexToVertex[i];
-    const auto vertexProperties = graph[vertexDescriptor];
+    for (std::size_t first = 0; first < order.size(); first += 2 * width)
+    {
+      const auto middle = std::min(first + width, order.size());
+      const auto last = std::min(first + 2 * width, order.size());
+      auto left = first;
+      auto right = middle;
+      auto output = first;
+
+      while (left < middle && right < last)
+      {
+        // Taking from the right run passes over every index still waiting in the left run
+        if (less(order[right], order[left]))
+        {
+          inversions += middle - left;
+          buffer[output++] = order[right++];
+        }
+        else
+        {
+          buffer[output++] = order[left++];
+        }
+      }
+
+      std::copy(order.begin() + left, order.begin() + middle, buffer.begin() + output);
+      std::copy(order.begin() + right, order.begin() + last, buffer.begin() + output + (middle - left));
+    }
 
-    // Add the vertex index to the component vertices index
-    componentsVerticesIndex[componentIndex].insert(i);
+    std::swap(order, buffer);
+  }
 
-    // Add the vertex to the subgraph
-    const auto vertex = boost::add_vertex(vertexProperties, subgraphs[componentIndex]);
+  return inversions;
+}
 
-    // Add the vertex to the subgraph vertex map
-    vertexIndexToSubgraphVertex[i] = vertex;
-  }
+std::vector<csr_index_t> rank_ascending(const std::vector<std::size_t> &values)
+{
+  std::vector<csr_index_t> order(values.size());
+  std::vector<csr_index_t> buffer(values.size());
+  std::iota(order.begin(), order.end(), 0);
 
-  // Add edges to the subgraphs
-  for (const auto &edgeDescriptor : boost::make_iterator_range(boost::edges(graph)))
+  // Sort by each digit in turn, least significant first (Counting sort is stable, so ties keep ascending index order)
+  const auto maxValue = values.empty() ? 0 : *std::max_element(values.begin(), values.end());
+  for (std::size_t shift = 0; shift < 64 && (maxValue >> shift) != 0; shift += RANK_RADIX_BITS)
   {
-    // Get the original vertex descriptors
-    const auto originalSourceVertexDescriptor = boost::source(edgeDescriptor, graph);
-    const auto originalTargetVertexDescriptor = boost::target(edgeDescriptor, graph);
-
-    // Get the vertex indices
-    const auto sourceVertexIndex = vertexToIndex[originalSourceVertexDescriptor];
-    const auto targetVertexIndex = vertexToIndex[originalTargetVertexDescriptor];
+    std::array<std::size_t, (1 << RANK_RADIX_BITS) + 1> offsets{};
+    for (const auto value : values)
+    {
+      offsets[((value >> shift) & ((1 << RANK_RADIX_BITS) - 1)) + 1]++;
+    }
 
-    // Get the component indices
-    const auto sourceComponentIndex = vertexIndexToComponentIndex[sourceVertexIndex];
-    const auto targetComponentIndex = vertexIndexToComponentIndex[targetVertexIndex];
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
 
-    // Add the edge to the subgraph only if the source and target are in the same component
-    if (sourceComponentIndex == targetComponentIndex)
+    for (const auto index : order)
     {
-      // Add the edge
-      boost::add_edge(
-          vertexIndexToSubgraphVertex[sourceVertexIndex],
-          vertexIndexToSubgraphVertex[targetVertexIndex],
-          subgraphs[sourceComponentIndex]);
+      buffer[offsets[(values[index] >> shift) & ((1 << RANK_RADIX_BITS) - 1)]++] = index;
     }
+
+    order.swap(buffer);
   }
 
-  return subgraphs;
+  return order;
+}
+
+std::vector<csr_index_t> rank_top(const std::vector<std::size_t> &values, const std::size_t count)
+{
+  const auto less = [&values](const csr_index_t a, const csr_index_t b)
+  {
+    return values[a] < values[b] || (values[a] == values[b] && a < b);
+  };
+
+  std::vector<csr_index_t> order(values.size());
+  std::iota(order.begin(), order.end(), 0);
+
+  // Partition the largest values to the end, then sort only them
+  const auto first = order.end() - (std::ptrdiff_t)std::min(count, values.size());
+  std::nth_element(order.begin(), first, order.end(), less);
+  std::sort(first, order.end(), less);
+
+  return std::vector<csr_index_t>(first, order.end());
 }
 
 bool detect_cycles(const graph_t &graph)
@@ -7,36 +7,48 @@
 #include <utility>
 #include <vector>
 
-#include "boost/random.hpp"
 #include "common.hpp"
+#include "csr.hpp"
 
 /**
- * @brief Generate a psuedo-random number in the range [start, end)
- * @param seed The seed
- * @param start The start of the range (inclusive)
- * @param end The end of the range (exclusive)
- * @return The random integer
+ * Check if the only remaining characters in the input are whitespace
+ * @param input The input stream
+ * @return True if the only remaining characters are whitespace, false otherwise
+*/
+bool only_whitespace_remaining(std::istream &input);
+
+/**
+ * @brief Turn progress messages on or off for the calling thread (They are on by default on every thread)
+ * @param enabled Whether to print progress messages
  */
-std::size_t random_integer(const std::size_t start, const std::size_t end);
+void set_progress_enabled(const bool enabled);
 
 /**
- * @brief Set the seed for the random number generator
- * @param seed The seed
+ * @brief Check if progress messages are printed on the calling thread
+ * @return True if progress messages are printed, false otherwise
  */
-void set_seed(const uint32_t seed);
+bool progress_enabled();
 
 /**
- * Check if the only remaining characters in the input are whitespace
- * @param input The input stream
- * @return True if the only remaining characters are whitespace, false otherwise
-*/
-bool only_whitespace_remaining(std::istream &input);
+ * @brief Runs tasks 0 to count - 1 of a job, possibly in parallel, and returns once every task finished (Called as
+ * executor(count, task), e.g. on a persistent thread pool)
+ */
+typedef std::function<void(std::size_t, const std::function<void(std::size_t)> &)> parallel_executor_t;
+
+/**
+ * @brief Run tasks 0 to count - 1 in parallel
+ * @param executor The executor to run them on (If null, a thread is started per task but the last, which runs on the
+ * calling thread)
+ * @param count The number of tasks
+ * @param task The task (Called once with each index)
+ */
+void parallel_for(const parallel_executor_t &executor, const std::size_t count, const std::function<void(std::size_t)> &task);
 
 /**
  * @brief Run Tarjan's algorithm to find the strongly connected components
  * @param graph The graph
  * @return Vector of subgraphs for each strongly connected component (Note that edges between strongly connected components are not included)
- * @note The time complexity is O(|V| * |E|)
+ * @note The time complexity is O(|V| + |E|) plus the cost of copying the subgraphs (Prefer decompose, which copies nothing)
  */
 ordered_graphs_t tarjans_subgraphs(const graph_t &graph);
 
@@ -47,6 +59,15 @@ ordered_graphs_t tarjans_subgraphs(const graph_t &graph);
  */
 bool detect_cycles(const graph_t &graph);
 
+/**
+ * @brief Re-sort an order of indices by ascending value (Ties broken by index) with a merge sort, counting every pair
+ * whose relative order changed since the last call
+ * @param order The order to update in place (Must be a permutation of the indices of values)
+ * @param values The values
+ * @return The number of inversions between the previous and the new order (Kendall tau distance)
+ */
+std::size_t merge_rerank(std::vector<std::size_t> &order, const std::vector<std::size_t> &values);
+
 /**
  * @brief Sort the map by values
  * @param map The map to sort
@@ -71,3 +92,21 @@ std::vector<T> mapsort(const std::unordered_map<T, V> &map, std::function<bool(c
 
   return keys;
 }
+
+/**
+ * @brief Rank indices by ascending value with a least significant digit radix sort (Ties broken by index, which is
+ * ascending vertex number for local indices)
+ * @param values The values
+ * @return The indices in ascending value order
+ * @note Digits above the largest value's leading one are skipped, so small counts take few passes
+ */
+std::vector<csr_index_t> rank_ascending(const std::vector<std::size_t> &values);
+
+/**
+ * @brief Rank only the indices of the largest values (Ties broken by index)
+ * @param values The values
+ * @param count The number of indices to rank (Clamped to the number of values)
+ * @return The indices of the count largest values in ascending value order (The last count indices of rank_ascending)
+ * @note Runs in time linear in the number of values plus count log count
+ */
+std::vector<csr_index_t> rank_top(const std::vector<std::size_t> &values, const std::size_t count);
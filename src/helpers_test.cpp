@@ -1,5 +1,7 @@
+#include <algorithm>
 #include <gtest/gtest.h>
 #include <map>
+#include <numeric>
 #include <set>
 #include <unordered_map>
 #include <vector>
@@ -377,3 +379,127 @@ TEST(detect_cycles, two_cycles)
   // Assert the result
   ASSERT_TRUE(hasCycles);
 }
+
+TEST(merge_rerank, unchanged)
+{
+  // Construct the order and values
+  std::vector<std::size_t> order = {2, 0, 1};
+  std::vector<std::size_t> values = {5, 7, 1};
+
+  // Re-rank
+  const auto inversions = merge_rerank(order, values);
+
+  // Assert the order
+  ASSERT_EQ(inversions, 0);
+  ASSERT_EQ(order, (std::vector<std::size_t>{2, 0, 1}));
+}
+
+TEST(merge_rerank, reversed)
+{
+  // Construct the order and values
+  std::vector<std::size_t> order = {0, 1, 2, 3};
+  std::vector<std::size_t> values = {4, 3, 2, 1};
+
+  // Re-rank
+  const auto inversions = merge_rerank(order, values);
+
+  // Assert the order
+  ASSERT_EQ(inversions, 6);
+  ASSERT_EQ(order, (std::vector<std::size_t>{3, 2, 1, 0}));
+}
+
+TEST(merge_rerank, ties)
+{
+  // Construct the order and values
+  std::vector<std::size_t> order = {3, 2, 1, 0};
+  std::vector<std::size_t> values = {1, 1, 0, 1};
+
+  // Re-rank
+  const auto inversions = merge_rerank(order, values);
+
+  // Assert the order (Ties are broken by index)
+  ASSERT_EQ(inversions, 4);
+  ASSERT_EQ(order, (std::vector<std::size_t>{2, 0, 1, 3}));
+}
+
+TEST(merge_rerank, matches_pair_count)
+{
+  // Construct the order and values (Enough indices for several merge widths, with ties)
+  std::vector<std::size_t> order(37);
+  std::vector<std::size_t> values(order.size());
+  for (std::size_t index = 0; index < order.size(); index++)
+  {
+    order[index] = (index * 11) % order.size();
+    values[index] = (index * 7) % 5;
+  }
+
+  // Count the pairs whose relative order changes (By brute force)
+  const auto less = [&values](const std::size_t a, const std::size_t b)
+  {
+    return values[a] < values[b] || (values[a] == values[b] && a < b);
+  };
+
+  std::size_t expected = 0;
+  for (std::size_t i = 0; i < order.size(); i++)
+  {
+    for (std::size_t j = i + 1; j < order.size(); j++)
+    {
+      expected += less(order[j], order[i]);
+    }
+  }
+
+  // Re-rank
+  const auto inversions = merge_rerank(order, values);
+
+  // Assert the count and the order
+  ASSERT_EQ(inversions, expected);
+  ASSERT_TRUE(std::is_sorted(order.begin(), order.end(), less));
+}
+
+TEST(rank_ascending, ties)
+{
+  // Construct the values
+  std::vector<std::size_t> values = {1, 1, 0, 1};
+
+  // Rank
+  const auto order = rank_ascending(values);
+
+  // Assert the order (Ties are broken by index)
+  ASSERT_EQ(order, (std::vector<csr_index_t>{2, 0, 1, 3}));
+}
+
+TEST(rank_ascending, matches_stable_sort)
+{
+  // Construct values with many ties and some above 32 bits
+  std::vector<std::size_t> values;
+  uint64_t state = 1;
+  for (std::size_t index = 0; index < 2000; index++)
+  {
+    state = state * 6364136223846793005 + 1442695040888963407;
+    values.push_back(index % 3 == 0 ? (state >> 20) : (state >> 58));
+  }
+
+  // Rank
+  const auto order = rank_ascending(values);
+
+  // Assert the order matches a stable comparison sort
+  std::vector<csr_index_t> expected(values.size());
+  std::iota(expected.begin(), expected.end(), 0);
+  std::stable_sort(expected.begin(), expected.end(), [&values](const csr_index_t a, const csr_index_t b)
+                   { return values[a] < values[b]; });
+  ASSERT_EQ(order, expected);
+
+  // Assert every top-k ranking is the matching suffix
+  for (const std::size_t count : {0, 1, 7, 500, 2000, 3000})
+  {
+    const auto top = rank_top(values, count);
+    ASSERT_EQ(top, std::vector<csr_index_t>(expected.end() - (std::ptrdiff_t)std::min<std::size_t>(count, values.size()), expected.end()));
+  }
+}
+
+TEST(rank_ascending, empty)
+{
+  // Assert empty values rank to nothing
+  ASSERT_TRUE(rank_ascending({}).empty());
+  ASSERT_TRUE(rank_top({}, 3).empty());
+}
@@ -0,0 +1,36 @@
+#include "random.hpp"
+
+philox_counter_t philox4x32(philox_counter_t counter, philox_key_t key)
+{
+  for (std::size_t round = 0; round < PHILOX_ROUNDS; round++)
+  {
+    // Multiply
+    const uint64_t product0 = (uint64_t)PHILOX_M0 * counter[0];
+    const uint64_t product1 = (uint64_t)PHILOX_M1 * counter[2];
+
+    // Mix
+    counter = {
+        (uint32_t)(product1 >> 32) ^ counter[1] ^ key[0],
+        (uint32_t)product1,
+        (uint32_t)(product0 >> 32) ^ counter[3] ^ key[1],
+        (uint32_t)product0,
+    };
+
+    // Bump the key
+    key[0] += PHILOX_W0;
+    key[1] += PHILOX_W1;
+  }
+
+  return counter;
+}
+
+random_stream_s make_random_stream(const uint64_t seed, const std::size_t component, const std::size_t batch, const std::size_t agent)
+{
+  random_stream_s stream;
+  stream.counter = {0, (uint32_t)agent, (uint32_t)batch, (uint32_t)component};
+  stream.key = {(uint32_t)seed, (uint32_t)(seed >> 32)};
+  stream.block = {};
+  stream.position = stream.block.size();
+
+  return stream;
+}
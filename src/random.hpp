@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief The Philox4x32 round multipliers
+ */
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+
+/**
+ * @brief The Philox4x32 key schedule constants (Golden ratio and sqrt(3) - 1)
+ */
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+
+/**
+ * @brief The number of Philox rounds
+ */
+#define PHILOX_ROUNDS 10
+
+/**
+ * @brief Philox4x32 counter block
+ */
+typedef std::array<uint32_t, 4> philox_counter_t;
+
+/**
+ * @brief Philox4x32 key
+ */
+typedef std::array<uint32_t, 2> philox_key_t;
+
+/**
+ * @brief Counter-based random number stream (See https://www.thesalmons.org/john/random123/papers/random123sc11.pdf)
+ * @note Each stream is keyed by (seed, component, batch, agent) so that any stream can be reproduced independently of
+ * the order in which streams are consumed (And therefore independently of the number of threads)
+ */
+struct random_stream_s
+{
+  /**
+   * @brief The counter (Block index, agent, batch, component)
+   */
+  philox_counter_t counter;
+
+  /**
+   * @brief The key (Low and high halves of the seed)
+   */
+  philox_key_t key;
+
+  /**
+   * @brief The most recently generated block
+   */
+  philox_counter_t block;
+
+  /**
+   * @brief The index of the next unused word in the block
+   */
+  std::size_t position;
+};
+
+/**
+ * @brief Run the Philox4x32-10 bijection
+ * @param counter The counter
+ * @param key The key
+ * @return The random block
+ */
+philox_counter_t philox4x32(philox_counter_t counter, philox_key_t key);
+
+/**
+ * @brief Create a random number stream
+ * @param seed The global seed
+ * @param component The component key
+ * @param batch The batch index
+ * @param agent The agent index
+ * @return The stream, positioned at its first word
+ */
+random_stream_s make_random_stream(const uint64_t seed, const std::size_t component, const std::size_t batch, const std::size_t agent);
+
+/**
+ * @brief Get the next 32-bit word from the stream
+ * @param stream The stream
+ * @return The random word
+ */
+inline uint32_t next_random(random_stream_s &stream)
+{
+  // Refill the block
+  if (stream.position == stream.block.size())
+  {
+    stream.block = philox4x32(stream.counter, stream.key);
+    stream.counter[0]++;
+    stream.position = 0;
+  }
+
+  return stream.block[stream.position++];
+}
+
+/**
+ * @brief Map a random word onto the range [0, bound) (See https://arxiv.org/abs/1805.10941)
+ * @param word The random word
+ * @param bound The exclusive upper bound
+ * @return The bounded integer
+ * @note This is Lemire's multiply-shift reduction without the rejection step, so that every draw consumes exactly one
+ * word (The bias is at most bound / 2^32, which is below 3e-6 for MAX_VERTICES)
+ */
+inline uint32_t bounded_random(const uint32_t word, const uint32_t bound)
+{
+  return (uint32_t)(((uint64_t)word * (uint64_t)bound) >> 32);
+}
@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <vector>
+
+#include "random.hpp"
+
+TEST(philox4x32, known_answer_zero)
+{
+  // Run the bijection (See the Random123 known-answer vectors)
+  const auto block = philox4x32({0, 0, 0, 0}, {0, 0});
+
+  // Assert the block
+  philox_counter_t expected = {0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8};
+  ASSERT_EQ(block, expected);
+}
+
+TEST(philox4x32, known_answer_ones)
+{
+  // Run the bijection
+  const auto block = philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff});
+
+  // Assert the block
+  philox_counter_t expected = {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd};
+  ASSERT_EQ(block, expected);
+}
+
+TEST(philox4x32, known_answer_pi)
+{
+  // Run the bijection
+  const auto block = philox4x32({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}, {0xa4093822, 0x299f31d0});
+
+  // Assert the block
+  philox_counter_t expected = {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1};
+  ASSERT_EQ(block, expected);
+}
+
+TEST(random_stream, reproducible)
+{
+  // Create two streams with the same key
+  auto first = make_random_stream(1234, 5, 6, 7);
+  auto second = make_random_stream(1234, 5, 6, 7);
+
+  // Assert the streams match
+  for (std::size_t i = 0; i < 100; i++)
+  {
+    ASSERT_EQ(next_random(first), next_random(second));
+  }
+}
+
+TEST(random_stream, independent)
+{
+  // Create streams which differ in a single key component
+  std::vector<random_stream_s> streams = {
+      make_random_stream(1, 0, 0, 0),
+      make_random_stream(2, 0, 0, 0),
+      make_random_stream(1, 1, 0, 0),
+      make_random_stream(1, 0, 1, 0),
+      make_random_stream(1, 0, 0, 1),
+  };
+
+  // Assert the first words differ
+  std::vector<uint32_t> words;
+  for (auto &stream : streams)
+  {
+    words.push_back(next_random(stream));
+  }
+
+  for (std::size_t i = 0; i < words.size(); i++)
+  {
+    for (std::size_t j = i + 1; j < words.size(); j++)
+    {
+      ASSERT_NE(words[i], words[j]);
+    }
+  }
+}
+
+TEST(bounded_random, range)
+{
+  // Assert the bounds
+  ASSERT_EQ(bounded_random(0, 10), 0);
+  ASSERT_EQ(bounded_random(0xffffffff, 10), 9);
+  ASSERT_EQ(bounded_random(0x80000000, 10), 5);
+  ASSERT_EQ(bounded_random(0x12345678, 1), 0);
+}
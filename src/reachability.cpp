@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+#include "reachability.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+
+/**
+ * @brief Whether the AVX2 row operations are compiled (They are selected at runtime based on the CPU)
+ */
+#define REACHABILITY_AVX2 1
+#endif
+
+/**
+ * @brief OR a row into another without SIMD
+ * @param destination The destination row
+ * @param source The source row
+ * @param words The number of words per row
+ */
+static void or_row_scalar(uint64_t *destination, const uint64_t *source, const std::size_t words)
+{
+  for (std::size_t word = 0; word < words; word++)
+  {
+    destination[word] |= source[word];
+  }
+}
+
+#ifdef REACHABILITY_AVX2
+/**
+ * @brief OR a row into another with AVX2
+ * @param destination The destination row
+ * @param source The source row
+ * @param words The number of words per row (A multiple of REACHABILITY_ROW_ALIGN)
+ */
+__attribute__((target("avx2"))) static void or_row_avx2(uint64_t *destination, const uint64_t *source, const std::size_t words)
+{
+  for (std::size_t word = 0; word < words; word += REACHABILITY_ROW_ALIGN)
+  {
+    const auto a = _mm256_loadu_si256((const __m256i *)(destination + word));
+    const auto b = _mm256_loadu_si256((const __m256i *)(source + word));
+    _mm256_storeu_si256((__m256i *)(destination + word), _mm256_or_si256(a, b));
+  }
+}
+#endif
+
+/**
+ * @brief OR a row into another
+ * @param destination The destination row
+ * @param source The source row
+ * @param words The number of words per row (A multiple of REACHABILITY_ROW_ALIGN)
+ */
+static void or_row(uint64_t *destination, const uint64_t *source, const std::size_t words)
+{
+#ifdef REACHABILITY_AVX2
+  static const bool avx2 = __builtin_cpu_supports("avx2");
+  if (avx2)
+  {
+    or_row_avx2(destination, source, words);
+    return;
+  }
+#endif
+
+  or_row_scalar(destination, source, words);
+}
+
+/**
+ * @brief Set a bit in a row
+ * @param row The row
+ * @param bit The bit
+ */
+static inline void set_bit(uint64_t *row, const std::size_t bit)
+{
+  row[bit / 64] |= (uint64_t)1 << (bit % 64);
+}
+
+/**
+ * @brief Test a bit in a row
+ * @param row The row
+ * @param bit The bit
+ * @return True if the bit is set, false otherwise
+ */
+static inline bool test_bit(const uint64_t *row, const std::size_t bit)
+{
+  return (row[bit / 64] >> (bit % 64)) & 1;
+}
+
+reachability_s make_reachability(const csr_graph_s &graph)
+{
+  if (REACHABILITY_MAX_VERTICES < graph.num_vertices())
+  {
+    throw std::invalid_argument("The graph has more than " + std::to_string(REACHABILITY_MAX_VERTICES) + " vertices");
+  }
+
+  // Pad the rows to a whole number of vectors
+  const auto rowWords = std::max<std::size_t>(1, (graph.num_vertices() + 64 * REACHABILITY_ROW_ALIGN - 1) / (64 * REACHABILITY_ROW_ALIGN)) * REACHABILITY_ROW_ALIGN;
+
+  return reachability_s{
+      graph,
+      rowWords,
+      std::vector<uint64_t>(graph.num_vertices() * rowWords, 0),
+      std::vector<uint64_t>(graph.num_vertices() * rowWords, 0),
+      std::vector<uint8_t>(graph.num_vertices(), 0),
+      std::vector<uint64_t>(rowWords, 0),
+  };
+}
+
+bool reachability_s::try_accept(const csr_index_t vertex)
+{
+  // Collect everything reachable through the accepted out-vertices
+  std::fill(scratch.begin(), scratch.end(), 0);
+  for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+  {
+    const auto target = graph.out_targets[edge];
+
+    // Reject self-loops
+    if (target == vertex)
+    {
+      return false;
+    }
+
+    if (accepted[target])
+    {
+      or_row(scratch.data(), descendants.data() + target * row_words, row_words);
+      set_bit(scratch.data(), target);
+    }
+  }
+
+  // Reject the vertex if any accepted in-vertex is reachable
+  for (auto edge = graph.in_offsets[vertex]; edge < graph.in_offsets[vertex + 1]; edge++)
+  {
+    const auto source = graph.in_sources[edge];
+    if (accepted[source] && test_bit(scratch.data(), source))
+    {
+      return false;
+    }
+  }
+
+  // Set the vertex's rows
+  auto *vertexDescendants = descendants.data() + vertex * row_words;
+  auto *vertexAncestors = ancestors.data() + vertex * row_words;
+  std::copy(scratch.begin(), scratch.end(), vertexDescendants);
+
+  for (auto edge = graph.in_offsets[vertex]; edge < graph.in_offsets[vertex + 1]; edge++)
+  {
+    const auto source = graph.in_sources[edge];
+    if (accepted[source])
+    {
+      or_row(vertexAncestors, ancestors.data() + source * row_words, row_words);
+      set_bit(vertexAncestors, source);
+    }
+  }
+
+  // Every ancestor now reaches the vertex and its descendants
+  set_bit(scratch.data(), vertex);
+  for (std::size_t word = 0; word < row_words; word++)
+  {
+    for (auto bits = vertexAncestors[word]; bits != 0; bits &= bits - 1)
+    {
+      const auto ancestor = word * 64 + (std::size_t)std::countr_zero(bits);
+      or_row(descendants.data() + ancestor * row_words, scratch.data(), row_words);
+    }
+  }
+
+  // Every descendant is now reached by the vertex and its ancestors
+  std::copy(vertexAncestors, vertexAncestors + row_words, scratch.begin());
+  set_bit(scratch.data(), vertex);
+  for (std::size_t word = 0; word < row_words; word++)
+  {
+    for (auto bits = vertexDescendants[word]; bits != 0; bits &= bits - 1)
+    {
+      const auto descendant = word * 64 + (std::size_t)std::countr_zero(bits);
+      or_row(ancestors.data() + descendant * row_words, scratch.data(), row_words);
+    }
+  }
+
+  accepted[vertex] = 1;
+  return true;
+}
+
+void reachability_s::accept_acyclic(const std::vector<csr_index_t> &vertices)
+{
+  for (const auto vertex : vertices)
+  {
+    accepted[vertex] = 1;
+  }
+
+  // Order the vertices topologically (Kahn's algorithm)
+  std::vector<csr_index_t> inDegree(graph.num_vertices(), 0);
+  for (const auto vertex : vertices)
+  {
+    for (auto edge = graph.in_offsets[vertex]; edge < graph.in_offsets[vertex + 1]; edge++)
+    {
+      inDegree[vertex] += accepted[graph.in_sources[edge]];
+    }
+  }
+
+  std::vector<csr_index_t> order;
+  order.reserve(vertices.size());
+  for (const auto vertex : vertices)
+  {
+    if (inDegree[vertex] == 0)
+    {
+      order.push_back(vertex);
+    }
+  }
+
+  for (std::size_t head = 0; head < order.size(); head++)
+  {
+    const auto vertex = order[head];
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+    {
+      const auto target = graph.out_targets[edge];
+      if (accepted[target] && --inDegree[target] == 0)
+      {
+        order.push_back(target);
+      }
+    }
+  }
+
+  if (order.size() != vertices.size())
+  {
+    throw std::invalid_argument("The vertices are not acyclic");
+  }
+
+  // Propagate the ancestors forwards and the descendants backwards
+  for (const auto vertex : order)
+  {
+    auto *vertexAncestors = ancestors.data() + vertex * row_words;
+    for (auto edge = graph.in_offsets[vertex]; edge < graph.in_offsets[vertex + 1]; edge++)
+    {
+      const auto source = graph.in_sources[edge];
+      if (accepted[source])
+      {
+        or_row(vertexAncestors, ancestors.data() + source * row_words, row_words);
+        set_bit(vertexAncestors, source);
+      }
+    }
+  }
+
+  for (auto vertex = order.rbegin(); vertex != order.rend(); vertex++)
+  {
+    auto *vertexDescendants = descendants.data() + *vertex * row_words;
+    for (auto edge = graph.out_offsets[*vertex]; edge < graph.out_offsets[*vertex + 1]; edge++)
+    {
+      const auto target = graph.out_targets[edge];
+      if (accepted[target])
+      {
+        or_row(vertexDescendants, descendants.data() + target * row_words, row_words);
+        set_bit(vertexDescendants, target);
+      }
+    }
+  }
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "csr.hpp"
+
+/**
+ * @brief The number of vertices at or below which the acyclic filter uses bitset reachability (Two rows of this many bits per vertex)
+ */
+#define REACHABILITY_MAX_VERTICES 4096
+
+/**
+ * @brief The number of 64-bit words rows are padded to (One AVX2 vector)
+ */
+#define REACHABILITY_ROW_ALIGN 4
+
+/**
+ * @brief Transitive closure of a growing acyclic subgraph, stored as bitset rows
+ * @note Vertices are accepted one at a time; adding a vertex creates a cycle exactly when one of its accepted
+ * out-vertices reaches (Or is) one of its accepted in-vertices, so each check is a row OR over the out-vertices and a
+ * bit test per in-vertex
+ */
+struct reachability_s
+{
+  /**
+   * @brief The graph whose induced subgraph is being grown
+   */
+  const csr_graph_s &graph;
+
+  /**
+   * @brief The number of 64-bit words per row (A multiple of REACHABILITY_ROW_ALIGN)
+   */
+  std::size_t row_words;
+
+  /**
+   * @brief The accepted vertices reachable from each accepted vertex (Excluding itself)
+   */
+  std::vector<uint64_t> descendants;
+
+  /**
+   * @brief The accepted vertices which reach each accepted vertex (Excluding itself)
+   */
+  std::vector<uint64_t> ancestors;
+
+  /**
+   * @brief Whether each vertex has been accepted
+   */
+  std::vector<uint8_t> accepted;
+
+  /**
+   * @brief Scratch row
+   */
+  std::vector<uint64_t> scratch;
+
+  /**
+   * @brief Accept a vertex if the accepted subgraph stays acyclic
+   * @param vertex The vertex
+   * @return True if the vertex was accepted, false if it would create a cycle
+   */
+  bool try_accept(const csr_index_t vertex);
+
+  /**
+   * @brief Accept a set of vertices known to be acyclic together, computing their closure in topological order
+   * @param vertices The vertices (Nothing may have been accepted yet)
+   */
+  void accept_acyclic(const std::vector<csr_index_t> &vertices);
+
+  /**
+   * @brief Check if an accepted vertex reaches another
+   * @param source The source vertex
+   * @param target The target vertex
+   * @return True if there is a non-empty path of accepted vertices from the source to the target, false otherwise
+   */
+  bool reaches(const csr_index_t source, const csr_index_t target) const
+  {
+    return (descendants[source * row_words + target / 64] >> (target % 64)) & 1;
+  }
+};
+
+/**
+ * @brief Create an empty reachability structure
+ * @param graph The graph (At most REACHABILITY_MAX_VERTICES vertices)
+ * @return The reachability structure
+ */
+reachability_s make_reachability(const csr_graph_s &graph);
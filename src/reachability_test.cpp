@@ -0,0 +1,98 @@
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+#include "reachability.hpp"
+#include "test_graphs.hpp"
+
+TEST(reachability, chain)
+{
+  // Build a cycle 1 -> 2 -> 3 -> 4 -> 1
+  const auto graph = build_graph(4, {{1, 2}, {2, 3}, {3, 4}, {4, 1}});
+  auto reachability = make_reachability(graph);
+
+  // Accept the chain out of order
+  ASSERT_TRUE(reachability.try_accept(2));
+  ASSERT_TRUE(reachability.try_accept(0));
+  ASSERT_TRUE(reachability.try_accept(1));
+
+  // Assert the closure (1 -> 2 -> 3 joined through 2)
+  ASSERT_TRUE(reachability.reaches(0, 1));
+  ASSERT_TRUE(reachability.reaches(0, 2));
+  ASSERT_TRUE(reachability.reaches(1, 2));
+  ASSERT_FALSE(reachability.reaches(2, 0));
+  ASSERT_FALSE(reachability.reaches(0, 0));
+
+  // Assert closing the cycle is rejected
+  ASSERT_FALSE(reachability.try_accept(3));
+  ASSERT_EQ(reachability.accepted, (std::vector<uint8_t>{1, 1, 1, 0}));
+}
+
+TEST(reachability, self_loop)
+{
+  // Build a self-loop
+  const auto graph = build_graph(2, {{1, 1}, {1, 2}});
+  auto reachability = make_reachability(graph);
+
+  // Assert the self-loop is rejected
+  ASSERT_FALSE(reachability.try_accept(0));
+  ASSERT_TRUE(reachability.try_accept(1));
+}
+
+TEST(reachability, wide_rows)
+{
+  // Build a long cycle spanning several row vectors
+  const std::size_t numVertices = 1000;
+  std::vector<std::pair<std::size_t, std::size_t>> edges;
+  for (std::size_t number = 1; number <= numVertices; number++)
+  {
+    edges.emplace_back(number, number % numVertices + 1);
+  }
+
+  const auto graph = build_graph(numVertices, edges);
+  auto reachability = make_reachability(graph);
+
+  // Accept every vertex but the last from both ends towards the middle
+  for (std::size_t offset = 0; offset < (numVertices - 1) / 2; offset++)
+  {
+    ASSERT_TRUE(reachability.try_accept((csr_index_t)offset));
+    ASSERT_TRUE(reachability.try_accept((csr_index_t)(numVertices - 2 - offset)));
+  }
+
+  ASSERT_TRUE(reachability.try_accept((numVertices - 1) / 2));
+
+  // Assert the path is closed and the last vertex is rejected
+  ASSERT_TRUE(reachability.reaches(0, numVertices - 2));
+  ASSERT_FALSE(reachability.reaches(numVertices - 2, 0));
+  ASSERT_FALSE(reachability.try_accept(numVertices - 1));
+}
+
+TEST(reachability, too_large)
+{
+  // Assert graphs above the maximum are rejected
+  ASSERT_THROW(make_reachability(build_graph(REACHABILITY_MAX_VERTICES + 1, {})), std::invalid_argument);
+}
+
+TEST(reachability, accept_acyclic)
+{
+  // Build a cycle 1 -> 2 -> 3 -> 4 -> 1 with a chord 1 -> 3
+  const auto graph = build_graph(4, {{1, 2}, {2, 3}, {3, 4}, {4, 1}, {1, 3}});
+
+  // Accept the path in one go and incrementally
+  auto bulk = make_reachability(graph);
+  bulk.accept_acyclic({2, 0, 1});
+
+  auto incremental = make_reachability(graph);
+  ASSERT_TRUE(incremental.try_accept(0));
+  ASSERT_TRUE(incremental.try_accept(1));
+  ASSERT_TRUE(incremental.try_accept(2));
+
+  // Assert the closures match and closing the cycle is still rejected
+  ASSERT_EQ(bulk.descendants, incremental.descendants);
+  ASSERT_EQ(bulk.ancestors, incremental.ancestors);
+  ASSERT_FALSE(bulk.try_accept(3));
+
+  // Assert a cyclic set is rejected
+  auto cyclic = make_reachability(graph);
+  ASSERT_THROW(cyclic.accept_acyclic({0, 1, 2, 3}), std::invalid_argument);
+}
@@ -0,0 +1,147 @@
+#include <algorithm>
+#include <numeric>
+
+#include "reorder.hpp"
+
+/**
+ * @brief Get the total degree of a vertex
+ * @param graph The graph
+ * @param vertex The vertex
+ * @return The in-degree plus the out-degree
+ */
+static std::size_t total_degree(const csr_graph_s &graph, const csr_index_t vertex)
+{
+  return (std::size_t)(graph.out_offsets[vertex + 1] - graph.out_offsets[vertex]) + (std::size_t)(graph.in_offsets[vertex + 1] - graph.in_offsets[vertex]);
+}
+
+/**
+ * @brief Order the vertices by breadth-first search over the edges in both directions
+ * @param graph The graph
+ * @param starts The vertices to start each search from, in order (Vertices already visited are skipped)
+ * @param byDegree Whether to visit each vertex's neighbors in ascending degree order
+ * @return The vertices in visit order
+ */
+static std::vector<csr_index_t> breadth_first_order(const csr_graph_s &graph, const std::vector<csr_index_t> &starts, const bool byDegree)
+{
+  const auto numVertices = graph.num_vertices();
+
+  std::vector<uint8_t> visited(numVertices, 0);
+  std::vector<csr_index_t> order;
+  order.reserve(numVertices);
+
+  for (const auto start : starts)
+  {
+    if (visited[start])
+    {
+      continue;
+    }
+
+    visited[start] = 1;
+    order.push_back(start);
+
+    // The order doubles as the queue
+    for (auto head = order.size() - 1; head < order.size(); head++)
+    {
+      const auto vertex = order[head];
+      const auto first = order.size();
+
+      for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+      {
+        const auto target = graph.out_targets[edge];
+        if (!visited[target])
+        {
+          visited[target] = 1;
+          order.push_back(target);
+        }
+      }
+
+      for (auto edge = graph.in_offsets[vertex]; edge < graph.in_offsets[vertex + 1]; edge++)
+      {
+        const auto source = graph.in_sources[edge];
+        if (!visited[source])
+        {
+          visited[source] = 1;
+          order.push_back(source);
+        }
+      }
+
+      // Visit lower-degree neighbors first
+      if (byDegree)
+      {
+        std::stable_sort(order.begin() + (std::ptrdiff_t)first, order.end(), [&graph](const csr_index_t left, const csr_index_t right)
+                         { return total_degree(graph, left) < total_degree(graph, right); });
+      }
+    }
+  }
+
+  return order;
+}
+
+std::vector<csr_index_t> reorder_vertices(const csr_graph_s &graph, const reorder_e reorder)
+{
+  std::vector<csr_index_t> order(graph.num_vertices());
+  std::iota(order.begin(), order.end(), 0);
+
+  if (reorder == reorder_e::bfs)
+  {
+    order = breadth_first_order(graph, order, false);
+  }
+  else if (reorder == reorder_e::rcm)
+  {
+    // Start each search from the lowest-degree unvisited vertex, then reverse the whole order
+    std::stable_sort(order.begin(), order.end(), [&graph](const csr_index_t left, const csr_index_t right)
+                     { return total_degree(graph, left) < total_degree(graph, right); });
+    order = breadth_first_order(graph, order, true);
+    std::reverse(order.begin(), order.end());
+  }
+  else if (reorder == reorder_e::degree)
+  {
+    std::stable_sort(order.begin(), order.end(), [&graph](const csr_index_t left, const csr_index_t right)
+                     { return total_degree(graph, right) < total_degree(graph, left); });
+  }
+
+  return order;
+}
+
+csr_graph_s permute_csr(const csr_graph_s &graph, const std::vector<csr_index_t> &order)
+{
+  const auto numVertices = graph.num_vertices();
+
+  // Get the new index of each old index
+  std::vector<csr_index_t> position(numVertices);
+  for (csr_index_t index = 0; index < numVertices; index++)
+  {
+    position[order[index]] = index;
+  }
+
+  csr_graph_s permuted;
+  permuted.out_offsets.reserve(numVertices + 1);
+  permuted.out_targets.reserve(graph.num_edges());
+  permuted.in_offsets.reserve(numVertices + 1);
+  permuted.in_sources.reserve(graph.num_edges());
+  permuted.numbers.reserve(numVertices);
+
+  // Copy each vertex's rows in the new order, relabeled in their original edge order
+  permuted.out_offsets.push_back(0);
+  permuted.in_offsets.push_back(0);
+  for (const auto vertex : order)
+  {
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+    {
+      permuted.out_targets.push_back(position[graph.out_targets[edge]]);
+    }
+
+    permuted.out_offsets.push_back((csr_offset_t<csr_index_t>)permuted.out_targets.size());
+
+    for (auto edge = graph.in_offsets[vertex]; edge < graph.in_offsets[vertex + 1]; edge++)
+    {
+      permuted.in_sources.push_back(position[graph.in_sources[edge]]);
+    }
+
+    permuted.in_offsets.push_back((csr_offset_t<csr_index_t>)permuted.in_sources.size());
+
+    permuted.numbers.push_back(graph.numbers[vertex]);
+  }
+
+  return permuted;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+
+#include "csr.hpp"
+
+/**
+ * @brief Vertex relabeling for memory locality
+ */
+enum class reorder_e
+{
+  /**
+   * @brief Keep the vertices in ascending number order
+   */
+  none,
+
+  /**
+   * @brief Breadth-first search order over the edges in both directions
+   */
+  bfs,
+
+  /**
+   * @brief Reverse Cuthill-McKee order (Breadth-first search from a low-degree vertex, visiting lower-degree neighbors
+   * first, reversed)
+   */
+  rcm,
+
+  /**
+   * @brief Descending total degree (Hubs first)
+   */
+  degree,
+};
+
+/**
+ * @brief Order the vertices of a graph for memory locality
+ * @param graph The graph
+ * @param reorder The ordering
+ * @return The old index of each new index (Ties are broken by ascending old index)
+ */
+std::vector<csr_index_t> reorder_vertices(const csr_graph_s &graph, const reorder_e reorder);
+
+/**
+ * @brief Relabel the vertices of a graph
+ * @param graph The graph
+ * @param order The old index of each new index (A permutation)
+ * @return The relabeled graph (Rows keep their edge order, so the k-th out-vertex of a new index is the relabeled k-th
+ * out-vertex of its old index, and the numbers move with their vertices, so numbers are no longer ascending)
+ */
+csr_graph_s permute_csr(const csr_graph_s &graph, const std::vector<csr_index_t> &order);
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <set>
+#include <vector>
+
+#include "reorder.hpp"
+#include "test_graphs.hpp"
+
+/**
+ * @brief Get the edges of a graph by vertex number
+ * @param graph The graph
+ * @param outEdges Whether to read the out-rows (Otherwise the in-rows)
+ * @return The edges as (source number, target number) pairs
+ */
+static std::set<std::pair<std::size_t, std::size_t>> numbered_edges(const csr_graph_s &graph, const bool outEdges)
+{
+  std::set<std::pair<std::size_t, std::size_t>> edges;
+  for (csr_index_t vertex = 0; vertex < graph.num_vertices(); vertex++)
+  {
+    const auto &offsets = outEdges ? graph.out_offsets : graph.in_offsets;
+    const auto &neighbors = outEdges ? graph.out_targets : graph.in_sources;
+    for (auto edge = offsets[vertex]; edge < offsets[vertex + 1]; edge++)
+    {
+      const auto number = graph.numbers[vertex];
+      const auto other = graph.numbers[neighbors[edge]];
+      edges.insert(outEdges ? std::make_pair(number, other) : std::make_pair(other, number));
+    }
+  }
+
+  return edges;
+}
+
+TEST(reorder_vertices, orders)
+{
+  // Build a path 1 - 2 - 3 - 4 with a hub 5 linked to every vertex
+  const auto graph = build_graph(5, {{1, 2}, {2, 3}, {3, 4}, {5, 1}, {5, 2}, {5, 3}, {5, 4}, {4, 5}});
+
+  // Assert each ordering
+  ASSERT_EQ(reorder_vertices(graph, reorder_e::none), (std::vector<csr_index_t>{0, 1, 2, 3, 4}));
+  ASSERT_EQ(reorder_vertices(graph, reorder_e::bfs), (std::vector<csr_index_t>{0, 1, 4, 2, 3}));
+  ASSERT_EQ(reorder_vertices(graph, reorder_e::rcm), (std::vector<csr_index_t>{3, 2, 4, 1, 0}));
+  ASSERT_EQ(reorder_vertices(graph, reorder_e::degree), (std::vector<csr_index_t>{4, 1, 2, 3, 0}));
+}
+
+TEST(permute_csr, random)
+{
+  // Build a random graph
+  const auto graph = build_random(200, 600, 7);
+
+  for (const auto reorder : {reorder_e::bfs, reorder_e::rcm, reorder_e::degree})
+  {
+    // Relabel the graph
+    const auto order = reorder_vertices(graph, reorder);
+    const auto permuted = permute_csr(graph, order);
+
+    // Assert the order is a permutation
+    auto sorted = order;
+    std::sort(sorted.begin(), sorted.end());
+    ASSERT_EQ(sorted, reorder_vertices(graph, reorder_e::none));
+
+    // Assert the rows keep their edge order and the edges are unchanged
+    for (csr_index_t vertex = 0; vertex < permuted.num_vertices(); vertex++)
+    {
+      ASSERT_EQ(permuted.numbers[vertex], graph.numbers[order[vertex]]);
+      ASSERT_EQ(permuted.out_offsets[vertex + 1] - permuted.out_offsets[vertex], graph.out_offsets[order[vertex] + 1] - graph.out_offsets[order[vertex]]);
+      for (auto edge = permuted.out_offsets[vertex]; edge < permuted.out_offsets[vertex + 1]; edge++)
+      {
+        ASSERT_EQ(order[permuted.out_targets[edge]], graph.out_targets[graph.out_offsets[order[vertex]] + edge - permuted.out_offsets[vertex]]);
+      }
+    }
+
+    ASSERT_EQ(numbered_edges(permuted, true), numbered_edges(graph, true));
+    ASSERT_EQ(numbered_edges(permuted, false), numbered_edges(graph, true));
+  }
+}
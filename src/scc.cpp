@@ -0,0 +1,959 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <utility>
+
+#include "scc.hpp"
+
+/**
+ * @brief Marker for vertices which have not been visited by Tarjan's algorithm
+ */
+#define SCC_UNVISITED std::numeric_limits<csr_index_t>::max()
+
+/**
+ * @brief Color of vertices whose component is known (Parallel algorithm only)
+ */
+#define SCC_DONE std::numeric_limits<uint32_t>::max()
+
+/**
+ * @brief Run Tarjan's algorithm from a root with an explicit call stack, labelling each component by its root vertex
+ * @param graph The graph
+ * @param root The root vertex
+ * @param inSubset Predicate selecting the vertices to traverse
+ * @param state The per-vertex state
+ * @param labels The component label of each vertex index (Output)
+ */
+template <typename Predicate>
+static void tarjan_from(const csr_graph_s &graph, const csr_index_t root, const Predicate &inSubset, tarjan_state_s &state, std::vector<std::size_t> &labels)
+{
+  csr_index_t counter = 0;
+  std::vector<csr_index_t> stack;
+  std::vector<std::pair<csr_index_t, csr_index_t>> calls;
+
+  // Visit a vertex
+  const auto visit = [&](const csr_index_t vertex)
+  {
+    state.index[vertex] = counter;
+    state.lowlink[vertex] = counter;
+    counter++;
+
+    stack.push_back(vertex);
+    state.on_stack[vertex] = 1;
+    calls.emplace_back(vertex, graph.out_offsets[vertex]);
+  };
+
+  visit(root);
+  while (!calls.empty())
+  {
+    const auto vertex = calls.back().first;
+    const auto edge = calls.back().second;
+
+    // Descend into the next out-vertex
+    if (edge < graph.out_offsets[vertex + 1])
+    {
+      calls.back().second++;
+
+      const auto target = graph.out_targets[edge];
+      if (!inSubset(target))
+      {
+        continue;
+      }
+
+      if (state.index[target] == SCC_UNVISITED)
+      {
+        visit(target);
+      }
+      else if (state.on_stack[target])
+      {
+        state.lowlink[vertex] = std::min(state.lowlink[vertex], state.index[target]);
+      }
+
+      continue;
+    }
+
+    // Return from the vertex
+    calls.pop_back();
+
+    // Pop the component if the vertex is its root
+    if (state.lowlink[vertex] == state.index[vertex])
+    {
+      csr_index_t member;
+      do
+      {
+        member = stack.back();
+        stack.pop_back();
+        state.on_stack[member] = 0;
+        labels[member] = vertex;
+      } while (member != vertex);
+    }
+
+    // Propagate the lowlink to the caller
+    if (!calls.empty())
+    {
+      const auto caller = calls.back().first;
+      state.lowlink[caller] = std::min(state.lowlink[caller], state.lowlink[vertex]);
+    }
+  }
+}
+
+/**
+ * @brief Build the decomposition from arbitrary component labels
+ * @param labels The component label of each vertex index (Any labelling where equal labels mean the same component)
+ * @return The normalized decomposition
+ */
+static scc_decomposition_s normalize_components(const std::vector<std::size_t> &labels)
+{
+  const auto numVertices = labels.size();
+  const auto unassigned = std::numeric_limits<csr_index_t>::max();
+
+  scc_decomposition_s decomposition;
+  decomposition.component_of.assign(numVertices, unassigned);
+  decomposition.local_index.resize(numVertices);
+  decomposition.permutation.resize(numVertices);
+
+  // Renumber the components in order of their smallest vertex index and count their sizes
+  std::vector<csr_index_t> labelToComponent(numVertices, unassigned);
+  std::vector<csr_index_t> sizes;
+  for (std::size_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    auto &component = labelToComponent[labels[vertex]];
+    if (component == unassigned)
+    {
+      component = (csr_index_t)sizes.size();
+      sizes.push_back(0);
+    }
+
+    decomposition.component_of[vertex] = component;
+    decomposition.local_index[vertex] = sizes[component]++;
+  }
+
+  // Group the vertices by component (A counting sort, so each component stays in ascending index order)
+  decomposition.component_offsets.assign(sizes.size() + 1, 0);
+  for (std::size_t component = 0; component < sizes.size(); component++)
+  {
+    decomposition.component_offsets[component + 1] = decomposition.component_offsets[component] + sizes[component];
+  }
+
+  for (std::size_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    const auto component = decomposition.component_of[vertex];
+    decomposition.permutation[decomposition.component_offsets[component] + decomposition.local_index[vertex]] = (csr_index_t)vertex;
+  }
+
+  return decomposition;
+}
+
+std::vector<std::size_t> label_components_iterative(const csr_graph_s &graph)
+{
+  const auto numVertices = graph.num_vertices();
+
+  tarjan_state_s state{std::vector<csr_index_t>(numVertices, SCC_UNVISITED), std::vector<csr_index_t>(numVertices), std::vector<uint8_t>(numVertices, 0)};
+  std::vector<std::size_t> labels(numVertices);
+
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    if (state.index[vertex] == SCC_UNVISITED)
+    {
+      tarjan_from(graph, vertex, [](const csr_index_t)
+                  { return true; }, state, labels);
+    }
+  }
+
+  return labels;
+}
+
+std::vector<std::size_t> label_components_parallel(const csr_graph_s &graph, const std::size_t threads, const parallel_executor_t &parallel)
+{
+  const auto numVertices = graph.num_vertices();
+  std::vector<std::size_t> labels(numVertices);
+  std::vector<std::atomic<uint32_t>> colors(numVertices);
+
+  // Trim vertices without in-vertices or out-vertices (Each is its own component), along with whatever that exposes
+  std::vector<csr_index_t> inDegrees(numVertices);
+  std::vector<csr_index_t> outDegrees(numVertices);
+  std::vector<csr_index_t> trimmed;
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    inDegrees[vertex] = graph.in_offsets[vertex + 1] - graph.in_offsets[vertex];
+    outDegrees[vertex] = graph.out_offsets[vertex + 1] - graph.out_offsets[vertex];
+    colors[vertex].store(0, std::memory_order_relaxed);
+
+    if (inDegrees[vertex] == 0 || outDegrees[vertex] == 0)
+    {
+      colors[vertex].store(SCC_DONE, std::memory_order_relaxed);
+      trimmed.push_back(vertex);
+    }
+  }
+
+  for (std::size_t position = 0; position < trimmed.size(); position++)
+  {
+    const auto vertex = trimmed[position];
+    labels[vertex] = vertex;
+
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+    {
+      const auto target = graph.out_targets[edge];
+      if (colors[target].load(std::memory_order_relaxed) != SCC_DONE && --inDegrees[target] == 0)
+      {
+        colors[target].store(SCC_DONE, std::memory_order_relaxed);
+        trimmed.push_back(target);
+      }
+    }
+
+    for (auto edge = graph.in_offsets[vertex]; edge < graph.in_offsets[vertex + 1]; edge++)
+    {
+      const auto source = graph.in_sources[edge];
+      if (colors[source].load(std::memory_order_relaxed) != SCC_DONE && --outDegrees[source] == 0)
+      {
+        colors[source].store(SCC_DONE, std::memory_order_relaxed);
+        trimmed.push_back(source);
+      }
+    }
+  }
+
+  // Each subproblem is a color and its vertices (Colors are never reused, so subproblems never see each other's vertices)
+  typedef std::pair<uint32_t, std::vector<csr_index_t>> subproblem_t;
+
+  std::vector<csr_index_t> remaining;
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    if (colors[vertex].load(std::memory_order_relaxed) != SCC_DONE)
+    {
+      remaining.push_back(vertex);
+    }
+  }
+
+  tarjan_state_s state{std::vector<csr_index_t>(numVertices, SCC_UNVISITED), std::vector<csr_index_t>(numVertices), std::vector<uint8_t>(numVertices, 0)};
+  std::atomic<uint32_t> nextColor = 1;
+  std::deque<subproblem_t> queue;
+  std::size_t pending = 0;
+  std::mutex mutex;
+  std::condition_variable condition;
+
+  const auto enqueue = [&](const uint32_t color, std::vector<csr_index_t> &&vertices)
+  {
+    if (vertices.empty())
+    {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    queue.emplace_back(color, std::move(vertices));
+    pending++;
+    condition.notify_one();
+  };
+
+  // Split a subproblem around a pivot
+  const auto solve = [&](const uint32_t color, const std::vector<csr_index_t> &vertices)
+  {
+    const auto inSubproblem = [&colors, color](const csr_index_t vertex)
+    {
+      return colors[vertex].load(std::memory_order_relaxed) == color;
+    };
+
+    // Finish small subproblems with Tarjan's algorithm
+    if (vertices.size() < SCC_SEQUENTIAL_THRESHOLD)
+    {
+      for (const auto vertex : vertices)
+      {
+        if (state.index[vertex] == SCC_UNVISITED)
+        {
+          tarjan_from(graph, vertex, inSubproblem, state, labels);
+        }
+      }
+
+      return;
+    }
+
+    // Pick the pivot most likely to be in a large component
+    const auto pivot = *std::max_element(vertices.begin(), vertices.end(), [&graph](const csr_index_t a, const csr_index_t b)
+                                         { return (uint64_t)(graph.in_offsets[a + 1] - graph.in_offsets[a]) * (graph.out_offsets[a + 1] - graph.out_offsets[a]) <
+                                                  (uint64_t)(graph.in_offsets[b + 1] - graph.in_offsets[b]) * (graph.out_offsets[b + 1] - graph.out_offsets[b]); });
+
+    // Find the vertices reachable from the pivot
+    const auto forwardColor = nextColor.fetch_add(2);
+    const auto backwardColor = forwardColor + 1;
+
+    std::vector<csr_index_t> frontier{pivot};
+    colors[pivot].store(forwardColor, std::memory_order_relaxed);
+    while (!frontier.empty())
+    {
+      const auto vertex = frontier.back();
+      frontier.pop_back();
+
+      for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+      {
+        const auto target = graph.out_targets[edge];
+        if (inSubproblem(target))
+        {
+          colors[target].store(forwardColor, std::memory_order_relaxed);
+          frontier.push_back(target);
+        }
+      }
+    }
+
+    // Find the vertices which reach the pivot (Those also reached from it form the pivot's component)
+    frontier.push_back(pivot);
+    colors[pivot].store(SCC_DONE, std::memory_order_relaxed);
+    labels[pivot] = pivot;
+    while (!frontier.empty())
+    {
+      const auto vertex = frontier.back();
+      frontier.pop_back();
+
+      for (auto edge = graph.in_offsets[vertex]; edge < graph.in_offsets[vertex + 1]; edge++)
+      {
+        const auto source = graph.in_sources[edge];
+        const auto sourceColor = colors[source].load(std::memory_order_relaxed);
+        if (sourceColor == forwardColor)
+        {
+          colors[source].store(SCC_DONE, std::memory_order_relaxed);
+          labels[source] = pivot;
+          frontier.push_back(source);
+        }
+        else if (sourceColor == color)
+        {
+          colors[source].store(backwardColor, std::memory_order_relaxed);
+          frontier.push_back(source);
+        }
+      }
+    }
+
+    // Split the rest into the forward-only, backward-only and unreached subproblems
+    std::vector<csr_index_t> forward, backward, unreached;
+    for (const auto vertex : vertices)
+    {
+      const auto vertexColor = colors[vertex].load(std::memory_order_relaxed);
+      if (vertexColor == forwardColor)
+      {
+        forward.push_back(vertex);
+      }
+      else if (vertexColor == backwardColor)
+      {
+        backward.push_back(vertex);
+      }
+      else if (vertexColor == color)
+      {
+        unreached.push_back(vertex);
+      }
+    }
+
+    enqueue(forwardColor, std::move(forward));
+    enqueue(backwardColor, std::move(backward));
+    enqueue(color, std::move(unreached));
+  };
+
+  // Process subproblems until none are queued or running
+  const auto work = [&]()
+  {
+    while (true)
+    {
+      subproblem_t subproblem;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        condition.wait(lock, [&]()
+                       { return !queue.empty() || pending == 0; });
+
+        if (queue.empty())
+        {
+          return;
+        }
+
+        subproblem = std::move(queue.front());
+        queue.pop_front();
+      }
+
+      solve(subproblem.first, subproblem.second);
+
+      std::lock_guard<std::mutex> lock(mutex);
+      pending--;
+      if (pending == 0)
+      {
+        condition.notify_all();
+      }
+    }
+  };
+
+  enqueue(0, std::move(remaining));
+  parallel_for(parallel, threads, [&work](const std::size_t)
+               { work(); });
+
+  return labels;
+}
+
+scc_decomposition_s decompose(const csr_graph_s &graph, const std::size_t threads, const parallel_executor_t &parallel)
+{
+  if (1 < threads && SCC_PARALLEL_THRESHOLD <= graph.num_vertices())
+  {
+    return normalize_components(label_components_parallel(graph, threads, parallel));
+  }
+
+  return normalize_components(label_components_iterative(graph));
+}
+
+bool component_view_s::is_cyclic() const
+{
+  if (size() != 1)
+  {
+    return true;
+  }
+
+  // Check for a self-loop
+  const auto vertex = vertices().front();
+  for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+  {
+    if (graph.out_targets[edge] == vertex)
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+std::size_t component_view_s::num_edges() const
+{
+  std::size_t edges = 0;
+  for (const auto vertex : vertices())
+  {
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+    {
+      edges += decomposition.component_of[graph.out_targets[edge]] == component;
+    }
+  }
+
+  return edges;
+}
+
+csr_graph_s component_view_s::build_csr() const
+{
+  csr_graph_s local;
+  local.numbers.reserve(size());
+  local.out_offsets.reserve(size() + 1);
+  local.in_offsets.reserve(size() + 1);
+
+  // Copy the rows, keeping only edges within the component (Local indices preserve the global order, so rows stay sorted)
+  local.out_offsets.push_back(0);
+  local.in_offsets.push_back(0);
+  for (const auto vertex : vertices())
+  {
+    local.numbers.push_back(graph.numbers[vertex]);
+
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+    {
+      const auto target = graph.out_targets[edge];
+      if (decomposition.component_of[target] == component)
+      {
+        local.out_targets.push_back(decomposition.local_index[target]);
+      }
+    }
+    local.out_offsets.push_back((csr_index_t)local.out_targets.size());
+
+    for (auto edge = graph.in_offsets[vertex]; edge < graph.in_offsets[vertex + 1]; edge++)
+    {
+      const auto source = graph.in_sources[edge];
+      if (decomposition.component_of[source] == component)
+      {
+        local.in_sources.push_back(decomposition.local_index[source]);
+      }
+    }
+    local.in_offsets.push_back((csr_index_t)local.in_sources.size());
+  }
+
+  return local;
+}
+
+graph_t component_view_s::build_subgraph() const
+{
+  graph_t subgraph;
+
+  // Add the vertices
+  ordered_vertex_descriptors_t localToVertex;
+  localToVertex.reserve(size());
+  for (const auto vertex : vertices())
+  {
+    localToVertex.push_back(boost::add_vertex(vertex_properties_s{graph.numbers[vertex]}, subgraph));
+  }
+
+  // Add the edges within the component
+  for (const auto vertex : vertices())
+  {
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+    {
+      const auto target = graph.out_targets[edge];
+      if (decomposition.component_of[target] == component)
+      {
+        boost::add_edge(localToVertex[decomposition.local_index[vertex]], localToVertex[decomposition.local_index[target]], subgraph);
+      }
+    }
+  }
+
+  return subgraph;
+}
+
+decremental_scc_s make_decremental_scc(const csr_graph_s &graph)
+{
+  const auto numVertices = graph.num_vertices();
+  const auto decomposition = normalize_components(label_components_iterative(graph));
+
+  decremental_scc_s scc{
+      graph,
+      std::vector<uint8_t>(numVertices, 1),
+      std::vector<std::size_t>(decomposition.component_of.begin(), decomposition.component_of.end()),
+      std::vector<std::vector<csr_index_t>>(decomposition.num_components()),
+      tarjan_state_s{std::vector<csr_index_t>(numVertices, SCC_UNVISITED), std::vector<csr_index_t>(numVertices), std::vector<uint8_t>(numVertices, 0)},
+      std::vector<std::size_t>(numVertices),
+      std::vector<std::size_t>(decomposition.num_components(), SIZE_MAX),
+      {},
+      std::vector<uint8_t>(numVertices, 0),
+  };
+
+  for (auto &tree : scc.trees)
+  {
+    for (auto *links : {&tree.parent, &tree.first_child, &tree.next_sibling, &tree.previous_sibling})
+    {
+      links->assign(numVertices, SCC_UNVISITED);
+    }
+  }
+
+  for (std::size_t component = 0; component < decomposition.num_components(); component++)
+  {
+    scc.members[component].assign(decomposition.permutation.begin() + decomposition.component_offsets[component], decomposition.permutation.begin() + decomposition.component_offsets[component + 1]);
+  }
+
+  return scc;
+}
+
+/**
+ * @brief Split the pieces of a subset of a component's remaining vertices off with Tarjan's algorithm
+ * @param scc The decremental structure
+ * @param subset The subset in ascending index order (Must be a union of the remaining vertices' pieces)
+ * @param inSubset Predicate selecting the vertices of the subset
+ * @param created The identifiers of the new components (Appended to)
+ */
+template <typename Predicate>
+static void split_pieces(decremental_scc_s &scc, const std::vector<csr_index_t> &subset, const Predicate &inSubset, std::vector<std::size_t> &created)
+{
+  auto &tarjan = scc.tarjan;
+  for (const auto vertex : subset)
+  {
+    if (tarjan.index[vertex] == SCC_UNVISITED)
+    {
+      tarjan_from(scc.graph, vertex, inSubset, tarjan, scc.scratch);
+    }
+  }
+
+  // Give each piece a new identifier in order of its smallest vertex index (The lowlink of a piece's root holds its offset from the first new identifier)
+  const auto first = scc.members.size();
+  for (const auto vertex : subset)
+  {
+    const auto root = (csr_index_t)scc.scratch[vertex];
+    if (tarjan.index[root] != SCC_UNVISITED)
+    {
+      tarjan.index[root] = SCC_UNVISITED;
+      tarjan.lowlink[root] = (csr_index_t)(scc.members.size() - first);
+      created.push_back(scc.members.size());
+      scc.members.emplace_back();
+      scc.roots.push_back(SIZE_MAX);
+    }
+  }
+
+  for (const auto vertex : subset)
+  {
+    const auto piece = first + tarjan.lowlink[scc.scratch[vertex]];
+    scc.component_of[vertex] = piece;
+    scc.members[piece].push_back(vertex);
+  }
+
+  // Leave every vertex unvisited for the next deletion
+  for (const auto vertex : subset)
+  {
+    tarjan.index[vertex] = SCC_UNVISITED;
+  }
+}
+
+/**
+ * @brief Attach a vertex to a tree
+ * @param tree The tree
+ * @param vertex The vertex (Must not be in the tree)
+ * @param parent The parent
+ */
+static void attach(scc_tree_s &tree, const csr_index_t vertex, const csr_index_t parent)
+{
+  tree.parent[vertex] = parent;
+  tree.previous_sibling[vertex] = SCC_UNVISITED;
+  tree.next_sibling[vertex] = tree.first_child[parent];
+  if (tree.first_child[parent] != SCC_UNVISITED)
+  {
+    tree.previous_sibling[tree.first_child[parent]] = vertex;
+  }
+
+  tree.first_child[parent] = vertex;
+}
+
+/**
+ * @brief Detach a vertex from its parent in a tree (Its subtree stays linked below it)
+ * @param tree The tree
+ * @param vertex The vertex
+ */
+static void detach(scc_tree_s &tree, const csr_index_t vertex)
+{
+  const auto parent = tree.parent[vertex];
+  if (parent == SCC_UNVISITED)
+  {
+    return;
+  }
+
+  const auto previous = tree.previous_sibling[vertex];
+  const auto next = tree.next_sibling[vertex];
+  (previous == SCC_UNVISITED ? tree.first_child[parent] : tree.next_sibling[previous]) = next;
+  if (next != SCC_UNVISITED)
+  {
+    tree.previous_sibling[next] = previous;
+  }
+
+  tree.parent[vertex] = SCC_UNVISITED;
+}
+
+/**
+ * @brief Reattach the remaining vertices below deleted ones in a tree
+ * @param scc The decremental structure
+ * @param direction The tree (0: the out-tree; 1: the in-tree)
+ * @param removed The deleted vertices of the component
+ * @param inRest Predicate selecting the remaining vertices of the component
+ * @param limit The number of vertices below the deleted ones at which to give up
+ * @param split The vertices which could not be reattached (Appended to and flagged as split off)
+ * @return False if there were more than limit vertices below the deleted ones (The tree is left broken), true otherwise
+ */
+template <typename Predicate>
+static bool repair_tree(decremental_scc_s &scc, const std::size_t direction, const std::vector<csr_index_t> &removed, const Predicate &inRest, const std::size_t limit, std::vector<csr_index_t> &split)
+{
+  const auto &graph = scc.graph;
+  auto &tree = scc.trees[direction];
+
+  // Edges toward the root (In-edges in the out-tree) and away from it
+  const auto &towardOffsets = direction == 0 ? graph.in_offsets : graph.out_offsets;
+  const auto &toward = direction == 0 ? graph.in_sources : graph.out_targets;
+  const auto &awayOffsets = direction == 0 ? graph.out_offsets : graph.in_offsets;
+  const auto &away = direction == 0 ? graph.out_targets : graph.in_sources;
+
+  // Cut the subtrees below the deleted vertices off (A deleted vertex may lie below another)
+  std::vector<csr_index_t> below;
+  std::vector<csr_index_t> stack;
+  for (const auto vertex : removed)
+  {
+    if (scc.flags[vertex] & 1)
+    {
+      continue;
+    }
+
+    detach(tree, vertex);
+    stack.push_back(vertex);
+    while (!stack.empty())
+    {
+      const auto top = stack.back();
+      stack.pop_back();
+      scc.flags[top] |= 1;
+      below.push_back(top);
+
+      for (auto child = tree.first_child[top]; child != SCC_UNVISITED; child = tree.next_sibling[child])
+      {
+        stack.push_back(child);
+      }
+
+      tree.parent[top] = SCC_UNVISITED;
+      tree.first_child[top] = SCC_UNVISITED;
+    }
+  }
+
+  // Clear the flags (The deleted vertices are never reattached)
+  const auto clear = [&]()
+  {
+    for (const auto vertex : below)
+    {
+      scc.flags[vertex] &= (uint8_t)~1;
+    }
+  };
+
+  if (limit < below.size() - removed.size())
+  {
+    clear();
+    return false;
+  }
+
+  // Reattach the cut-off vertices with an edge toward the rest of the tree, then the ones they lead to
+  std::vector<csr_index_t> queue;
+  for (const auto vertex : below)
+  {
+    if (!inRest(vertex))
+    {
+      continue;
+    }
+
+    for (auto edge = towardOffsets[vertex]; edge < towardOffsets[vertex + 1]; edge++)
+    {
+      const auto neighbor = toward[edge];
+      if (inRest(neighbor) && !(scc.flags[neighbor] & 1))
+      {
+        attach(tree, vertex, neighbor);
+        scc.flags[vertex] &= (uint8_t)~1;
+        queue.push_back(vertex);
+        break;
+      }
+    }
+  }
+
+  for (std::size_t head = 0; head < queue.size(); head++)
+  {
+    const auto vertex = queue[head];
+    for (auto edge = awayOffsets[vertex]; edge < awayOffsets[vertex + 1]; edge++)
+    {
+      const auto neighbor = away[edge];
+      if (inRest(neighbor) && (scc.flags[neighbor] & 1))
+      {
+        attach(tree, neighbor, vertex);
+        scc.flags[neighbor] &= (uint8_t)~1;
+        queue.push_back(neighbor);
+      }
+    }
+  }
+
+  // Flag the vertices which could not be reattached as split off
+  for (const auto vertex : below)
+  {
+    if (inRest(vertex) && (scc.flags[vertex] & 1) && !(scc.flags[vertex] & 2))
+    {
+      scc.flags[vertex] |= 2;
+      split.push_back(vertex);
+    }
+  }
+
+  clear();
+  return true;
+}
+
+/**
+ * @brief Build both trees of a component's remaining vertices from a new root
+ * @param scc The decremental structure
+ * @param component The component identifier
+ * @param rest The remaining vertices
+ * @param inRest Predicate selecting the remaining vertices of the component
+ * @param split The vertices outside the root's component (Appended to and flagged as split off)
+ */
+template <typename Predicate>
+static void build_trees(decremental_scc_s &scc, const std::size_t component, const std::vector<csr_index_t> &rest, const Predicate &inRest, std::vector<csr_index_t> &split)
+{
+  const auto &graph = scc.graph;
+
+  // Root the trees at the vertex with the most edges (For shallow trees)
+  const auto degree = [&graph](const csr_index_t vertex)
+  { return graph.out_offsets[vertex + 1] - graph.out_offsets[vertex] + graph.in_offsets[vertex + 1] - graph.in_offsets[vertex]; };
+  const auto root = *std::max_element(rest.begin(), rest.end(), [&degree](const csr_index_t a, const csr_index_t b)
+                                      { return degree(a) < degree(b); });
+  scc.roots[component] = root;
+
+  for (std::size_t direction = 0; direction < 2; direction++)
+  {
+    auto &tree = scc.trees[direction];
+    for (const auto vertex : rest)
+    {
+      tree.parent[vertex] = SCC_UNVISITED;
+      tree.first_child[vertex] = SCC_UNVISITED;
+    }
+
+    // Search away from the root
+    const auto &offsets = direction == 0 ? graph.out_offsets : graph.in_offsets;
+    const auto &neighbors = direction == 0 ? graph.out_targets : graph.in_sources;
+
+    std::vector<csr_index_t> queue{root};
+    for (std::size_t head = 0; head < queue.size(); head++)
+    {
+      const auto vertex = queue[head];
+      for (auto edge = offsets[vertex]; edge < offsets[vertex + 1]; edge++)
+      {
+        const auto neighbor = neighbors[edge];
+        if (neighbor != root && inRest(neighbor) && tree.parent[neighbor] == SCC_UNVISITED)
+        {
+          attach(tree, neighbor, vertex);
+          queue.push_back(neighbor);
+        }
+      }
+    }
+  }
+
+  // Flag the vertices the root does not reach or is not reached from
+  for (const auto vertex : rest)
+  {
+    if (vertex != root && (scc.trees[0].parent[vertex] == SCC_UNVISITED || scc.trees[1].parent[vertex] == SCC_UNVISITED))
+    {
+      scc.flags[vertex] |= 2;
+      split.push_back(vertex);
+    }
+  }
+}
+
+/**
+ * @brief Split the rest of a component after some of its vertices were deleted
+ * @param scc The decremental structure
+ * @param component The component identifier
+ * @param removed The deleted vertices of the component
+ * @param changed The identifiers of the changed components (Appended to)
+ */
+static void split_rest(decremental_scc_s &scc, const std::size_t component, const std::vector<csr_index_t> &removed, std::vector<std::size_t> &changed)
+{
+  const auto inRest = [&scc, component](const csr_index_t vertex)
+  { return scc.alive[vertex] && scc.component_of[vertex] == component; };
+  const auto restSize = scc.members[component].size() - removed.size();
+
+  // Repair the trees, or rebuild them if they are missing, rooted at a deleted vertex, or mostly below deleted vertices
+  std::vector<csr_index_t> split;
+  auto repaired = scc.roots[component] != SIZE_MAX && scc.alive[scc.roots[component]];
+  for (std::size_t direction = 0; direction < 2 && repaired; direction++)
+  {
+    repaired = repair_tree(scc, direction, removed, inRest, restSize / 2, split);
+  }
+
+  if (!repaired)
+  {
+    std::vector<csr_index_t> rest;
+    std::copy_if(scc.members[component].begin(), scc.members[component].end(), std::back_inserter(rest), inRest);
+    for (const auto vertex : rest)
+    {
+      scc.flags[vertex] = 0;
+    }
+
+    split.clear();
+    if (!rest.empty())
+    {
+      build_trees(scc, component, rest, inRest, split);
+    }
+  }
+
+  // Unlink the split-off vertices (Their subtrees hold only split-off vertices, since what the root does not reach or
+  // is not reached from is closed under the tree edges below it)
+  std::sort(split.begin(), split.end());
+  for (auto &tree : scc.trees)
+  {
+    for (const auto vertex : split)
+    {
+      detach(tree, vertex);
+    }
+
+    for (const auto vertex : split)
+    {
+      tree.first_child[vertex] = SCC_UNVISITED;
+    }
+  }
+
+  split_pieces(scc, split, [&scc, &inRest](const csr_index_t vertex)
+               { return inRest(vertex) && (scc.flags[vertex] & 2); }, changed);
+  for (const auto vertex : split)
+  {
+    scc.flags[vertex] = 0;
+  }
+
+  // The root's piece keeps the identifier
+  std::erase_if(scc.members[component], [&scc, component](const csr_index_t vertex)
+                { return !scc.alive[vertex] || scc.component_of[vertex] != component; });
+  if (!scc.members[component].empty())
+  {
+    changed.push_back(component);
+  }
+}
+
+std::vector<std::size_t> decremental_scc_s::remove_vertices(const std::vector<csr_index_t> &vertices)
+{
+  // Delete the vertices and group them by the component they were in
+  std::vector<std::pair<std::size_t, csr_index_t>> deleted;
+  for (const auto vertex : vertices)
+  {
+    if (!alive[vertex])
+    {
+      continue;
+    }
+
+    alive[vertex] = 0;
+    deleted.emplace_back(component_of[vertex], vertex);
+  }
+
+  std::sort(deleted.begin(), deleted.end());
+
+  // Split each affected component
+  std::vector<std::size_t> changed;
+  std::vector<csr_index_t> removed;
+  for (std::size_t first = 0; first < deleted.size();)
+  {
+    const auto component = deleted[first].first;
+    removed.clear();
+    for (; first < deleted.size() && deleted[first].first == component; first++)
+    {
+      removed.push_back(deleted[first].second);
+    }
+
+    split_rest(*this, component, removed, changed);
+  }
+
+  std::sort(changed.begin(), changed.end());
+  return changed;
+}
+
+bool decremental_scc_s::is_cyclic(const std::size_t component) const
+{
+  if (members[component].size() != 1)
+  {
+    return 1 < members[component].size();
+  }
+
+  // Check for a self-loop
+  const auto vertex = members[component].front();
+  const auto first = graph.out_targets.begin() + graph.out_offsets[vertex];
+  const auto last = graph.out_targets.begin() + graph.out_offsets[vertex + 1];
+  return std::find(first, last, vertex) != last;
+}
+
+csr_graph_s decremental_scc_s::build_csr(const std::size_t component) const
+{
+  const auto &vertices = members[component];
+
+  csr_graph_s local;
+  local.numbers.reserve(vertices.size());
+  local.out_offsets.reserve(vertices.size() + 1);
+  local.in_offsets.reserve(vertices.size() + 1);
+
+  // Find the local index of an in-component vertex (Members are sorted, so rows stay sorted)
+  const auto localIndex = [&vertices](const csr_index_t vertex)
+  { return (csr_index_t)(std::lower_bound(vertices.begin(), vertices.end(), vertex) - vertices.begin()); };
+
+  local.out_offsets.push_back(0);
+  local.in_offsets.push_back(0);
+  for (const auto vertex : vertices)
+  {
+    local.numbers.push_back(graph.numbers[vertex]);
+
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+    {
+      const auto target = graph.out_targets[edge];
+      if (alive[target] && component_of[target] == component)
+      {
+        local.out_targets.push_back(localIndex(target));
+      }
+    }
+    local.out_offsets.push_back((csr_index_t)local.out_targets.size());
+
+    for (auto edge = graph.in_offsets[vertex]; edge < graph.in_offsets[vertex + 1]; edge++)
+    {
+      const auto source = graph.in_sources[edge];
+      if (alive[source] && component_of[source] == component)
+      {
+        local.in_sources.push_back(localIndex(source));
+      }
+    }
+    local.in_offsets.push_back((csr_index_t)local.in_sources.size());
+  }
+
+  return local;
+}
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <array>
+#include <span>
+#include <vector>
+
+#include "csr.hpp"
+#include "helpers.hpp"
+
+/**
+ * @brief The number of vertices at or above which decompose uses the parallel algorithm (When given more than one thread)
+ * @note Above MAX_VERTICES, so only libfvs graphs take the parallel path: the solver and graphstat reject larger
+ * inputs, and Tarjan's algorithm decomposes a graph of MAX_VERTICES vertices and MAX_EDGES edges in under a millisecond
+ */
+#define SCC_PARALLEL_THRESHOLD 65536
+
+/**
+ * @brief The number of vertices below which a subproblem of the parallel algorithm is finished with Tarjan's algorithm
+ */
+#define SCC_SEQUENTIAL_THRESHOLD 4096
+
+/**
+ * @brief Strongly connected component decomposition of a compressed sparse row graph
+ * @note Components are numbered in ascending order of their smallest vertex index and the vertices of each component
+ * are in ascending index order, so the decomposition does not depend on the algorithm that computed it
+ */
+struct scc_decomposition_s
+{
+  /**
+   * @brief The component of each vertex index
+   */
+  std::vector<csr_index_t> component_of;
+
+  /**
+   * @brief The index of each vertex within its component
+   */
+  std::vector<csr_index_t> local_index;
+
+  /**
+   * @brief The vertex indices grouped by component
+   */
+  std::vector<csr_index_t> permutation;
+
+  /**
+   * @brief The offset of each component's vertices in permutation (With a trailing sentinel)
+   */
+  std::vector<csr_index_t> component_offsets;
+
+  /**
+   * @brief Get the number of components
+   * @return The number of components
+   */
+  std::size_t num_components() const
+  {
+    return component_offsets.size() - 1;
+  }
+};
+
+/**
+ * @brief Lightweight view of a single strongly connected component (Nothing is copied until a local graph is built)
+ */
+struct component_view_s
+{
+  /**
+   * @brief The decomposed graph
+   */
+  const csr_graph_s &graph;
+
+  /**
+   * @brief The decomposition
+   */
+  const scc_decomposition_s &decomposition;
+
+  /**
+   * @brief The component
+   */
+  std::size_t component;
+
+  /**
+   * @brief Get the vertex indices of the component (Relative to the decomposed graph)
+   * @return The vertex indices
+   */
+  std::span<const csr_index_t> vertices() const
+  {
+    return std::span<const csr_index_t>(decomposition.permutation).subspan(decomposition.component_offsets[component], size());
+  }
+
+  /**
+   * @brief Get the number of vertices
+   * @return The number of vertices
+   */
+  std::size_t size() const
+  {
+    return decomposition.component_offsets[component + 1] - decomposition.component_offsets[component];
+  }
+
+  /**
+   * @brief Get the smallest vertex number in the component (Stable across decompositions of the same graph)
+   * @return The vertex number
+   */
+  std::size_t key() const
+  {
+    return graph.numbers[vertices().front()];
+  }
+
+  /**
+   * @brief Check if the component contains a cycle (More than one vertex or a self-loop)
+   * @return True if the component is cyclic, false otherwise
+   */
+  bool is_cyclic() const;
+
+  /**
+   * @brief Count the edges within the component (Without building it)
+   * @return The number of edges
+   */
+  std::size_t num_edges() const;
+
+  /**
+   * @brief Build the compressed sparse row graph of the component (Only edges within the component are included)
+   * @return The local graph (Local index i is the i-th vertex of vertices())
+   */
+  csr_graph_s build_csr() const;
+
+  /**
+   * @brief Build the adjacency list graph of the component (Only edges within the component are included)
+   * @return The subgraph
+   */
+  graph_t build_subgraph() const;
+};
+
+/**
+ * @brief Per-vertex state of Tarjan's algorithm (Shared by runs over disjoint vertex subsets)
+ */
+struct tarjan_state_s
+{
+  /**
+   * @brief The visitation index of each vertex
+   */
+  std::vector<csr_index_t> index;
+
+  /**
+   * @brief The smallest index reachable from each vertex through its DFS subtree
+   */
+  std::vector<csr_index_t> lowlink;
+
+  /**
+   * @brief Whether each vertex is on the component stack (Bytes rather than bits so that disjoint runs may write concurrently)
+   */
+  std::vector<uint8_t> on_stack;
+};
+
+/**
+ * @brief Spanning tree of the vertices reachable from (Or reaching) a root, with linked child lists
+ */
+struct scc_tree_s
+{
+  /**
+   * @brief The parent of each vertex (The maximum index at the root and outside the tree)
+   */
+  std::vector<csr_index_t> parent;
+
+  /**
+   * @brief The first child of each vertex (The maximum index if there is none)
+   */
+  std::vector<csr_index_t> first_child;
+
+  /**
+   * @brief The next sibling of each vertex (The maximum index if there is none)
+   */
+  std::vector<csr_index_t> next_sibling;
+
+  /**
+   * @brief The previous sibling of each vertex (The maximum index if there is none)
+   */
+  std::vector<csr_index_t> previous_sibling;
+};
+
+/**
+ * @brief Strongly connected components of a graph under vertex deletion
+ * @note Each component keeps a root with an out-tree and an in-tree spanning its vertices. Deleting vertices only
+ * reattaches the vertices below them in the trees, searching from the rest of the trees; the vertices which cannot be
+ * reattached are exactly those outside the root's new component, and their pieces are split off with Tarjan's
+ * algorithm. So a deletion costs time proportional to the subtrees below the deleted vertices and the pieces split off,
+ * rather than to the component. The trees are built with two breadth-first searches on the first deletion from a
+ * component, and rebuilt when its root is deleted or the subtrees cover more than half of it. The root's component
+ * keeps the identifier; pieces split off get new identifiers, which are never reused
+ */
+struct decremental_scc_s
+{
+  /**
+   * @brief The graph
+   */
+  const csr_graph_s &graph;
+
+  /**
+   * @brief Whether each vertex is still in the graph
+   */
+  std::vector<uint8_t> alive;
+
+  /**
+   * @brief The component identifier of each remaining vertex
+   */
+  std::vector<std::size_t> component_of;
+
+  /**
+   * @brief The remaining vertices of each component in ascending index order (Empty once retired)
+   */
+  std::vector<std::vector<csr_index_t>> members;
+
+  /**
+   * @brief Tarjan's algorithm state (Every vertex is unvisited between deletions)
+   */
+  tarjan_state_s tarjan;
+
+  /**
+   * @brief Scratch component labels (The root vertex of each vertex's piece)
+   */
+  std::vector<std::size_t> scratch;
+
+  /**
+   * @brief The root of each component's reachability trees (SIZE_MAX until a deletion from the component builds them)
+   */
+  std::vector<std::size_t> roots;
+
+  /**
+   * @brief The out-tree (Paths from the root) and the in-tree (Paths to the root) of the components' vertices
+   */
+  std::array<scc_tree_s, 2> trees;
+
+  /**
+   * @brief Scratch flags of each vertex (Bit 0: cut off from its tree; bit 1: split off; zero between deletions)
+   */
+  std::vector<uint8_t> flags;
+
+  /**
+   * @brief Delete vertices and re-split the components they were in
+   * @param vertices The vertices (Already deleted vertices are ignored)
+   * @return The identifiers of the changed components in ascending order (Every piece of a component which lost a
+   * vertex, including acyclic singletons and the piece which kept its identifier)
+   */
+  std::vector<std::size_t> remove_vertices(const std::vector<csr_index_t> &vertices);
+
+  /**
+   * @brief Check if a component contains a cycle (More than one vertex or a self-loop)
+   * @param component The component identifier
+   * @return True if the component is cyclic, false otherwise
+   */
+  bool is_cyclic(const std::size_t component) const;
+
+  /**
+   * @brief Build the compressed sparse row graph of a component (Only edges within the component are included)
+   * @param component The component identifier
+   * @return The local graph (Local index i is members[component][i])
+   */
+  csr_graph_s build_csr(const std::size_t component) const;
+};
+
+/**
+ * @brief Decompose a graph into strongly connected components which can then be maintained under vertex deletion
+ * @param graph The graph
+ * @return The decremental structure (Component identifiers start in ascending order of their smallest vertex index)
+ */
+decremental_scc_s make_decremental_scc(const csr_graph_s &graph);
+
+/**
+ * @brief Label the strongly connected components with Tarjan's algorithm, using an explicit stack instead of recursion
+ * @param graph The graph
+ * @return The component label of each vertex index (The index of a vertex in the component)
+ * @note The time complexity is O(|V| + |E|) and the memory does not depend on the length of the longest path
+ */
+std::vector<std::size_t> label_components_iterative(const csr_graph_s &graph);
+
+/**
+ * @brief Label the strongly connected components with the Forward-Backward algorithm after trimming trivial components
+ * @param graph The graph
+ * @param threads The number of threads
+ * @param parallel The executor to run the threads on (nullptr to start threads)
+ * @return The component label of each vertex index (The index of a vertex in the component)
+ * @note Each subproblem is split into the component of a pivot, its forward-only and backward-only reachable sets, and
+ * the rest; independent subproblems run in parallel, and small ones are finished with Tarjan's algorithm
+ */
+std::vector<std::size_t> label_components_parallel(const csr_graph_s &graph, const std::size_t threads, const parallel_executor_t &parallel);
+
+/**
+ * @brief Decompose a graph into strongly connected components
+ * @param graph The graph
+ * @param threads The number of threads (The parallel algorithm is only used for graphs of at least
+ * SCC_PARALLEL_THRESHOLD vertices, which only libfvs accepts)
+ * @param parallel The executor to run the parallel algorithm's threads on (nullptr to start threads)
+ * @return The decomposition
+ */
+scc_decomposition_s decompose(const csr_graph_s &graph, const std::size_t threads, const parallel_executor_t &parallel);
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <fstream>
+#include <map>
+#include <vector>
+
+#include "input.hpp"
+#include "random.hpp"
+#include "scc.hpp"
+#include "test_graphs.hpp"
+
+TEST(decompose, one_scc)
+{
+  // Build the graph
+  const auto graph = build_graph(5, {{3, 1}, {5, 1}, {1, 2}, {2, 3}, {1, 4}, {4, 5}});
+
+  // Decompose the graph
+  const auto decomposition = decompose(graph, 1, nullptr);
+
+  // Assert the decomposition
+  ASSERT_EQ(decomposition.num_components(), 1);
+  ASSERT_EQ(decomposition.component_of, (std::vector<csr_index_t>{0, 0, 0, 0, 0}));
+  ASSERT_EQ(decomposition.permutation, (std::vector<csr_index_t>{0, 1, 2, 3, 4}));
+
+  const component_view_s view{graph, decomposition, 0};
+  ASSERT_TRUE(view.is_cyclic());
+  ASSERT_EQ(view.key(), 1);
+
+  // Assert the local graph matches the whole graph
+  const auto local = view.build_csr();
+  ASSERT_EQ(local.numbers, graph.numbers);
+  ASSERT_EQ(local.out_offsets, graph.out_offsets);
+  ASSERT_EQ(local.out_targets, graph.out_targets);
+  ASSERT_EQ(local.in_offsets, graph.in_offsets);
+  ASSERT_EQ(local.in_sources, graph.in_sources);
+}
+
+TEST(decompose, all_sccs)
+{
+  // Build the graph
+  const auto graph = build_graph(5, {{1, 2}, {2, 3}, {4, 5}});
+
+  // Decompose the graph
+  const auto decomposition = decompose(graph, 1, nullptr);
+
+  // Assert every vertex is an acyclic singleton
+  ASSERT_EQ(decomposition.num_components(), 5);
+  ASSERT_EQ(decomposition.component_of, (std::vector<csr_index_t>{0, 1, 2, 3, 4}));
+
+  for (std::size_t component = 0; component < decomposition.num_components(); component++)
+  {
+    const component_view_s view{graph, decomposition, component};
+    ASSERT_EQ(view.size(), 1);
+    ASSERT_FALSE(view.is_cyclic());
+  }
+}
+
+TEST(decompose, grouped)
+{
+  // Build the graph (Components {1, 4}, {2, 5, 6}, {3} with a self-loop, and the edges between them)
+  const auto graph = build_graph(6, {{1, 4}, {4, 1}, {2, 5}, {5, 6}, {6, 2}, {4, 2}, {3, 3}, {6, 3}});
+
+  // Decompose the graph
+  const auto decomposition = decompose(graph, 1, nullptr);
+
+  // Assert the decomposition
+  ASSERT_EQ(decomposition.num_components(), 3);
+  ASSERT_EQ(decomposition.component_of, (std::vector<csr_index_t>{0, 1, 2, 0, 1, 1}));
+  ASSERT_EQ(decomposition.permutation, (std::vector<csr_index_t>{0, 3, 1, 4, 5, 2}));
+  ASSERT_EQ(decomposition.component_offsets, (std::vector<csr_index_t>{0, 2, 5, 6}));
+
+  // Assert the self-loop singleton is cyclic
+  const component_view_s selfLoop{graph, decomposition, 2};
+  ASSERT_TRUE(selfLoop.is_cyclic());
+  ASSERT_EQ(selfLoop.key(), 3);
+
+  // Assert the local graph only contains edges within the component (2 -> 5 -> 6 -> 2)
+  const component_view_s triangle{graph, decomposition, 1};
+  const auto local = triangle.build_csr();
+  ASSERT_EQ(triangle.num_edges(), 3);
+  ASSERT_EQ(local.numbers, (std::vector<std::size_t>{2, 5, 6}));
+  ASSERT_EQ(local.out_offsets, (std::vector<csr_index_t>{0, 1, 2, 3}));
+  ASSERT_EQ(local.out_targets, (std::vector<csr_index_t>{1, 2, 0}));
+  ASSERT_EQ(local.in_sources, (std::vector<csr_index_t>{2, 0, 1}));
+
+  // Assert the subgraph matches the local graph
+  const auto subgraph = triangle.build_subgraph();
+  ASSERT_EQ(boost::num_vertices(subgraph), 3);
+  ASSERT_EQ(boost::num_edges(subgraph), 3);
+}
+
+TEST(decompose, no_cycle)
+{
+  // Open the file
+  std::ifstream file("test/4-no-cycle-in.txt");
+
+  // Decompose the graph
+  const auto graph = deserialize_input(file);
+  ordered_vertex_descriptors_t indexToVertex;
+  const auto csr = build_csr(graph, indexToVertex);
+  const auto decomposition = decompose(csr, 1, nullptr);
+
+  // Assert every component is an acyclic singleton
+  ASSERT_EQ(decomposition.num_components(), csr.num_vertices());
+  for (std::size_t component = 0; component < decomposition.num_components(); component++)
+  {
+    ASSERT_FALSE((component_view_s{csr, decomposition, component}.is_cyclic()));
+  }
+}
+
+/**
+ * @brief Renumber component labels in order of first appearance
+ * @param labels The component labels
+ * @return The canonical labels
+ */
+static std::vector<std::size_t> canonical_labels(const std::vector<std::size_t> &labels)
+{
+  std::map<std::size_t, std::size_t> renumbered;
+  std::vector<std::size_t> canonical;
+  for (const auto label : labels)
+  {
+    canonical.push_back(renumbered.emplace(label, renumbered.size()).first->second);
+  }
+
+  return canonical;
+}
+
+TEST(label_components_iterative, long_cycle)
+{
+  // Build a cycle long enough to overflow a recursive depth-first search
+  const std::size_t numVertices = 200000;
+  std::vector<std::pair<csr_index_t, csr_index_t>> edges;
+  for (std::size_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    edges.emplace_back((csr_index_t)vertex, (csr_index_t)((vertex + 1) % numVertices));
+  }
+
+  const auto graph = build_direct(numVertices, edges);
+
+  // Label the components
+  const auto labels = label_components_iterative(graph);
+
+  // Assert there is a single component
+  ASSERT_EQ(std::count(labels.begin(), labels.end(), labels[0]), numVertices);
+}
+
+TEST(label_components_parallel, matches_iterative)
+{
+  // Build random graphs made of dense clusters chained by sparse edges, with some long chains
+  for (uint64_t seed = 0; seed < 4; seed++)
+  {
+    const std::size_t numVertices = 20000;
+    auto stream = make_random_stream(seed, 0, 0, 0);
+
+    std::vector<std::pair<csr_index_t, csr_index_t>> edges;
+    for (std::size_t edge = 0; edge < 30000; edge++)
+    {
+      const auto source = bounded_random(next_random(stream), (uint32_t)numVertices);
+      const auto target = (csr_index_t)std::min<std::size_t>(numVertices - 1, source + bounded_random(next_random(stream), 64));
+      edges.emplace_back(source, target);
+    }
+
+    for (std::size_t edge = 0; edge < 3000; edge++)
+    {
+      const auto target = bounded_random(next_random(stream), (uint32_t)numVertices);
+      const auto source = (csr_index_t)std::min<std::size_t>(numVertices - 1, target + bounded_random(next_random(stream), 2000));
+      edges.emplace_back(source, target);
+    }
+
+    const auto graph = build_direct(numVertices, edges);
+
+    // Label the components both ways
+    const auto expected = canonical_labels(label_components_iterative(graph));
+    for (std::size_t threads = 1; threads <= 4; threads++)
+    {
+      const auto labels = canonical_labels(label_components_parallel(graph, threads, nullptr));
+
+      // Assert the components match
+      ASSERT_EQ(labels, expected);
+    }
+  }
+}
+
+TEST(decremental_scc, split)
+{
+  // Build two cycles sharing vertex 1 (1 -> 2 -> 3 -> 1 and 1 -> 4 -> 5 -> 1) and a self-loop
+  const auto graph = build_graph(6, {{3, 1}, {5, 1}, {1, 2}, {2, 3}, {1, 4}, {4, 5}, {6, 6}});
+  auto scc = make_decremental_scc(graph);
+
+  ASSERT_EQ(scc.members.size(), 2);
+  ASSERT_TRUE(scc.is_cyclic(0));
+  ASSERT_TRUE(scc.is_cyclic(1));
+
+  // Delete vertex 2 (Breaking the first cycle only)
+  const auto first = scc.remove_vertices({1});
+
+  // Assert the acyclic singleton 3 split off, and the component kept vertices 1, 4 and 5
+  ASSERT_EQ(first, (std::vector<std::size_t>{0, 2}));
+  ASSERT_EQ(scc.members.size(), 3);
+  ASSERT_EQ(scc.members[0], (std::vector<csr_index_t>{0, 3, 4}));
+  ASSERT_EQ(scc.members[2], (std::vector<csr_index_t>{2}));
+  ASSERT_TRUE(scc.is_cyclic(0));
+  ASSERT_FALSE(scc.is_cyclic(2));
+
+  // Assert the local graph is the remaining cycle
+  const auto local = scc.build_csr(0);
+  ASSERT_EQ(local.numbers, (std::vector<std::size_t>{1, 4, 5}));
+  ASSERT_EQ(local.out_targets, (std::vector<csr_index_t>{1, 2, 0}));
+  ASSERT_EQ(local.in_sources, (std::vector<csr_index_t>{2, 0, 1}));
+
+  // Assert deleting an already deleted vertex changes nothing
+  ASSERT_TRUE(scc.remove_vertices({1}).empty());
+}
+
+TEST(decremental_scc, matches_decompose)
+{
+  for (uint64_t seed = 0; seed < 8; seed++)
+  {
+    // Build a random graph (From mostly acyclic to one giant component)
+    const std::size_t numVertices = 500;
+    auto stream = make_random_stream(seed, 1, 0, 0);
+
+    std::vector<std::pair<csr_index_t, csr_index_t>> edges;
+    for (std::size_t edge = 0; edge < 500 * (1 + seed % 4); edge++)
+    {
+      edges.emplace_back(bounded_random(next_random(stream), (uint32_t)numVertices), bounded_random(next_random(stream), (uint32_t)numVertices));
+    }
+
+    const auto graph = build_direct(numVertices, edges);
+    auto scc = make_decremental_scc(graph);
+
+    // Delete random batches of vertices (Some large enough to split a component in half)
+    std::vector<uint8_t> alive(numVertices, 1);
+    for (std::size_t batch = 0; batch < 20; batch++)
+    {
+      std::vector<csr_index_t> removed;
+      for (std::size_t index = 0; index < (batch % 5 == 4 ? 40 : 1 + batch % 4); index++)
+      {
+        removed.push_back(bounded_random(next_random(stream), (uint32_t)numVertices));
+        alive[removed.back()] = 0;
+      }
+
+      scc.remove_vertices(removed);
+
+      // Decompose the remaining graph from scratch (Deleted vertices become isolated)
+      std::vector<std::pair<csr_index_t, csr_index_t>> remainingEdges;
+      for (const auto &[source, target] : edges)
+      {
+        if (alive[source] && alive[target])
+        {
+          remainingEdges.emplace_back(source, target);
+        }
+      }
+
+      const auto labels = label_components_iterative(build_direct(numVertices, remainingEdges));
+
+      // Assert the remaining vertices are partitioned the same way, and every member is alive
+      std::size_t members = 0;
+      for (const auto &component : scc.members)
+      {
+        members += component.size();
+      }
+
+      ASSERT_EQ(members, (std::size_t)std::count(alive.begin(), alive.end(), 1));
+
+      std::vector<std::size_t> expected;
+      std::vector<std::size_t> actual;
+      for (std::size_t vertex = 0; vertex < numVertices; vertex++)
+      {
+        if (alive[vertex])
+        {
+          expected.push_back(labels[vertex]);
+          actual.push_back(scc.component_of[vertex]);
+          ASSERT_TRUE(std::binary_search(scc.members[actual.back()].begin(), scc.members[actual.back()].end(), (csr_index_t)vertex));
+        }
+      }
+
+      ASSERT_EQ(canonical_labels(actual), canonical_labels(expected));
+    }
+  }
+}
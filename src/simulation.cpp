@@ -1,102 +1,374 @@
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <limits>
+#include <numeric>
+#include <optional>
 #include <stdexcept>
 #include <vector>
 
-#include "boost/random.hpp"
+#include "csr.hpp"
 #include "helpers.hpp"
+#include "reorder.hpp"
 #include "simulation.hpp"
+#include "walker.hpp"
 
-unnormalized_vertex_traffic_map_t simulate(const graph_t &component, const std::size_t agents, const std::size_t steps, const std::size_t batches, const double change_threshold)
+std::vector<std::size_t> simulate(const csr_graph_s &component, const simulation_options_s &options)
 {
-  // Initialize traffic
-  unnormalized_vertex_traffic_map_t unnormalizedTraffic;
-  for (const auto &vertexDescriptor : boost::make_iterator_range(boost::vertices(component)))
+  // Skip empty components
+  if (component.num_vertices() == 0)
   {
-    unnormalizedTraffic[vertexDescriptor] = 0;
+    return {};
   }
 
-  // Build a map from vertices to out-vertices
-  std::unordered_map<vertex_descriptor_t, std::vector<vertex_descriptor_t>> vertexToOutVertices;
-  std::unordered_map<std::size_t, vertex_descriptor_t> indexToVertex;
+  for (std::size_t index = 0; index < component.num_vertices(); index++)
+  {
+    if (component.out_offsets[index] == component.out_offsets[index + 1])
+    {
+      throw std::invalid_argument("The graph is not strongly connected");
+    }
+  }
 
-  for (const auto &vertexDescriptor : boost::make_iterator_range(boost::vertices(component)))
+  // Walk a relabeled copy whose rows keep their edge order, drawing start and teleport vertices through the new index
+  // of each old index, so that every agent follows the same path as on the component
+  const auto *walked = &component;
+  csr_graph_s reordered;
+  std::vector<csr_index_t> relabeling;
+  std::vector<csr_index_t> position;
+  if (options.reorder != reorder_e::none)
   {
-    indexToVertex.emplace(indexToVertex.size(), vertexDescriptor);
-    for (const auto &edgeDescriptor : boost::make_iterator_range(boost::out_edges(vertexDescriptor, component)))
+    relabeling = reorder_vertices(component, options.reorder);
+    reordered = permute_csr(component, relabeling);
+    walked = &reordered;
+
+    position.resize(relabeling.size());
+    for (csr_index_t index = 0; index < relabeling.size(); index++)
     {
-      vertexToOutVertices[vertexDescriptor].push_back(boost::target(edgeDescriptor, component));
+      position[relabeling[index]] = index;
     }
   }
 
+  const auto *labels = position.empty() ? nullptr : position.data();
+
+  // Walk a copy with 16-bit vertex indices when they fit (Halving the out-vertex array, which the walk reads at random)
+  std::optional<basic_csr_graph_s<uint16_t>> narrow;
+  if (walked->num_vertices() <= std::numeric_limits<uint16_t>::max())
+  {
+    narrow = convert_csr<uint16_t>(*walked);
+  }
+
+  // Split the agents across threads
+  const auto threads = std::max<std::size_t>(1, std::min(options.threads, options.agents));
+  std::vector<std::vector<std::size_t>> threadTraffic(threads, std::vector<std::size_t>(component.num_vertices(), 0));
+
+  // Start without traffic and with the identity as the ascending traffic order (Re-sorted after every batch in ranking mode)
+  simulation_checkpoint_s progress{options.component, 0, std::vector<std::size_t>(component.num_vertices(), 0), std::vector<std::size_t>(component.num_vertices()), 0};
+  std::iota(progress.order.begin(), progress.order.end(), 0);
+
+  // Or continue from the checkpoint of this component
+  const auto *resume = options.resume;
+  if (resume && resume->component == options.component && resume->traffic.size() == component.num_vertices() && resume->order.size() == component.num_vertices())
+  {
+    progress = *resume;
+  }
+
+  auto &traffic = progress.traffic;
+  auto &order = progress.order;
+  auto &stableBatches = progress.stable_batches;
+  const auto pairs = order.size() * (order.size() - 1) / 2;
+
+  // Recompute the previous normalized traffic of a resumed simulation
+  std::vector<double> previousNormalizedTraffic(component.num_vertices(), 0);
+  for (std::size_t index = 0; 0 < progress.batch && index < traffic.size(); index++)
+  {
+    previousNormalizedTraffic[index] = (double)traffic[index] / (double)(progress.batch * options.agents * options.steps);
+  }
+
   // Iterate over batches
-  normalized_vertex_traffic_map_t previousNormalizedTraffic{};
-  for (std::size_t batch = 0; batch < batches; batch++)
+  for (auto batch = progress.batch; batch < options.batches; batch++)
   {
-    // Iterate over agents
-    for (std::size_t agent = 0; agent < agents; agent++)
-    {
-      // Initialize the agent with a random start vertex
-      std::size_t currentVertexIndex = random_integer(0, boost::num_vertices(component));
-      vertex_descriptor_t currentVertex = indexToVertex[currentVertexIndex];
+    // Walk the agents
+    parallel_for(options.parallel, threads, [&](const std::size_t thread)
+                 {
+                   const auto firstAgent = options.agents * thread / threads;
+                   const auto lastAgent = options.agents * (thread + 1) / threads;
+
+                   if (narrow)
+                   {
+                     walk_agents<uint16_t>(*narrow, options, batch, firstAgent, lastAgent, threadTraffic[thread].data(), labels);
+                   }
+                   else
+                   {
+                     walk_agents<csr_index_t>(*walked, options, batch, firstAgent, lastAgent, threadTraffic[thread].data(), labels);
+                   }
+                 });
 
-      // Iterate over steps
-      for (std::size_t step = 0; step < steps; step++)
+    // Merge the traffic back onto the component's indices (Addition is order-independent, so the result does not depend
+    // on the number of threads)
+    for (auto &partialTraffic : threadTraffic)
+    {
+      for (std::size_t index = 0; index < traffic.size(); index++)
       {
-        // Get the out-edges of the current vertex
-        const auto outEdges = vertexToOutVertices[currentVertex];
-        const auto outDegree = outEdges.size();
+        traffic[labels ? relabeling[index] : index] += partialTraffic[index];
+        partialTraffic[index] = 0;
+      }
+    }
 
-        // Get the next vertex
-        vertex_descriptor_t nextVertex;
+    if (options.stop_mode == stop_mode_e::ranking)
+    {
+      // Compute the Kendall rank correlation between the previous and the new traffic order
+      const auto inversions = merge_rerank(order, traffic);
+      const auto rankCorrelation = pairs == 0 ? 1.0 : 1.0 - 2.0 * (double)inversions / (double)pairs;
+      stableBatches = options.rank_correlation <= rankCorrelation ? stableBatches + 1 : 0;
 
-        if (outDegree == 0)
-        {
-          throw std::invalid_argument("The graph is not strongly connected");
-        }
-        else if (outDegree == 1)
-        {
-          nextVertex = outEdges[0];
-        }
-        else
+      // Print the rank correlation
+      if (progress_enabled())
+      {
+        std::cout << "Processed batch " << batch + 1 << " of at most " << options.batches << " with rank correlation " << rankCorrelation << " (>=" << (batch + 1) * 100 / options.batches << "%, threshold: " << options.rank_correlation << ", stable batches: " << stableBatches << "/" << options.stable_batches << ", agents/batch: " << options.agents << ", steps/agent/batch: " << options.steps << ")" << std::endl;
+      }
+
+      // Terminate early if the order has been stable for long enough
+      if (options.stable_batches <= stableBatches)
+      {
+        if (progress_enabled())
         {
-          nextVertex = outEdges[random_integer(0, outDegree)];
+          std::cout << "Terminating early" << std::endl;
         }
 
-        // Update the traffic
-        unnormalizedTraffic[nextVertex]++;
+        break;
+      }
 
-        // Move to the next vertex
-        currentVertex = nextVertex;
+      // Record the progress
+      if (options.checkpoint)
+      {
+        progress.batch = batch + 1;
+        options.checkpoint(progress);
       }
+
+      continue;
     }
 
     // Compute the mean normalized traffic difference and update the previous normalized traffic
-    std::size_t totalTraffic = (batch + 1) * agents * steps;
+    std::size_t totalTraffic = (batch + 1) * options.agents * options.steps;
     double meanNormalizedTrafficDifference = 0;
 
-    for (const auto &[vertexDescriptor, traffic] : unnormalizedTraffic)
+    for (std::size_t index = 0; index < traffic.size(); index++)
     {
       // Get the normalized traffics
-      double oldNormalizedTraffic = previousNormalizedTraffic.contains(vertexDescriptor) ? previousNormalizedTraffic[vertexDescriptor] : 0;
-      double newNormalizedTraffic = (double)traffic / (double)totalTraffic;
+      double newNormalizedTraffic = (double)traffic[index] / (double)totalTraffic;
 
       // Update the mean normalized traffic difference
-      meanNormalizedTrafficDifference += std::abs(newNormalizedTraffic - oldNormalizedTraffic);
+      meanNormalizedTrafficDifference += std::abs(newNormalizedTraffic - previousNormalizedTraffic[index]);
 
       // Update the previous normalized traffic
-      previousNormalizedTraffic[vertexDescriptor] = newNormalizedTraffic;
+      previousNormalizedTraffic[index] = newNormalizedTraffic;
     }
 
     // Print the mean normalized traffic difference
-    std::cout << "Processed batch " << batch + 1 << " of at most " << batches << " with mean normalized traffic difference " << meanNormalizedTrafficDifference << " (>=" << (batch + 1) * 100 / batches << "%, threshold: " << change_threshold << ", agents/batch: " << agents << ", steps/agent/batch: " << steps << ")" << std::endl;
+    if (progress_enabled())
+    {
+      std::cout << "Processed batch " << batch + 1 << " of at most " << options.batches << " with mean normalized traffic difference " << meanNormalizedTrafficDifference << " (>=" << (batch + 1) * 100 / options.batches << "%, threshold: " << options.change_threshold << ", agents/batch: " << options.agents << ", steps/agent/batch: " << options.steps << ")" << std::endl;
+    }
 
     // Terminate early if the mean normalized traffic difference is below the proportionality change threshold
-    if (meanNormalizedTrafficDifference < change_threshold)
+    if (meanNormalizedTrafficDifference < options.change_threshold)
     {
-      std::cout << "Terminating early" << std::endl;
+      if (progress_enabled())
+      {
+        std::cout << "Terminating early" << std::endl;
+      }
+
       break;
     }
+
+    // Record the progress
+    if (options.checkpoint)
+    {
+      progress.batch = batch + 1;
+      options.checkpoint(progress);
+    }
+  }
+
+  return std::move(traffic);
+}
+
+unnormalized_vertex_traffic_map_t simulate(const graph_t &component, const simulation_options_s &options)
+{
+  // Skip empty components
+  if (boost::num_vertices(component) == 0)
+  {
+    return {};
+  }
+
+  // Simulate the compressed sparse row graph
+  ordered_vertex_descriptors_t indexToVertex;
+  const auto traffic = simulate(build_csr(component, indexToVertex), options);
+
+  // Build the traffic map
+  unnormalized_vertex_traffic_map_t unnormalizedTraffic;
+  for (std::size_t index = 0; index < indexToVertex.size(); index++)
+  {
+    unnormalizedTraffic[indexToVertex[index]] = traffic[index];
   }
 
   return unnormalizedTraffic;
 }
+
+/**
+ * @brief Walk a range of agents of a simulation state
+ * @param state The simulation state
+ * @param steps The number of steps per agent
+ * @param firstAgent The first agent
+ * @param lastAgent The agent after the last agent
+ * @param traffic The traffic to add to (One entry per vertex)
+ */
+static void advance_agents(simulation_state_s &state, const std::size_t steps, const std::size_t firstAgent, const std::size_t lastAgent, std::size_t *traffic)
+{
+  const auto threshold = (uint32_t)std::lround(std::clamp(state.options.teleport, 0.0, 1.0) * (double)(1 << WALKER_TELEPORT_BITS));
+  const auto liveCount = (uint32_t)state.live.size();
+
+  for (auto agent = firstAgent; agent < lastAgent; agent++)
+  {
+    auto &stream = state.streams[agent];
+    auto vertex = state.positions[agent];
+
+    for (std::size_t step = 0; step < steps; step++)
+    {
+      const auto word = next_random(stream);
+      const auto degree = state.live_degree[vertex];
+
+      // Teleport from dead ends (And with the teleport probability), else follow a live out-edge
+      if (degree == 0 || (word & ((1 << WALKER_TELEPORT_BITS) - 1)) < threshold)
+      {
+        vertex = state.live[bounded_random(word, liveCount)];
+      }
+      else
+      {
+        vertex = state.targets[state.graph.out_offsets[vertex] + bounded_random(word, degree)];
+      }
+
+      traffic[vertex]++;
+    }
+
+    state.positions[agent] = vertex;
+  }
+}
+
+simulation_state_s make_simulation_state(const csr_graph_s &component, const simulation_options_s &options)
+{
+  const auto numVertices = component.num_vertices();
+
+  simulation_state_s state{
+      component,
+      options,
+      component.out_targets,
+      std::vector<csr_index_t>(numVertices),
+      std::vector<csr_index_t>(numVertices),
+      std::vector<csr_index_t>(numVertices),
+      std::vector<uint8_t>(numVertices, 1),
+      std::vector<csr_index_t>(options.agents, 0),
+      {},
+      std::vector<std::size_t>(numVertices, 0),
+  };
+
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    state.live_degree[vertex] = component.out_offsets[vertex + 1] - component.out_offsets[vertex];
+    state.live[vertex] = vertex;
+    state.live_position[vertex] = vertex;
+  }
+
+  // Place each agent with the first word of its stream (Keyed past the simulation's last batch, so the walks do not
+  // replay ones the simulation already counted)
+  state.streams.reserve(options.agents);
+  for (std::size_t agent = 0; agent < options.agents; agent++)
+  {
+    state.streams.push_back(make_random_stream(options.seed, options.component, options.batches, agent));
+    const auto word = next_random(state.streams.back());
+    state.positions[agent] = numVertices == 0 ? 0 : bounded_random(word, (uint32_t)numVertices);
+  }
+
+  return state;
+}
+
+void simulation_state_s::advance(const std::size_t steps)
+{
+  if (live.empty())
+  {
+    return;
+  }
+
+  // Split the agents across threads
+  const auto threads = std::max<std::size_t>(1, std::min(options.threads, options.agents));
+  std::vector<std::vector<std::size_t>> threadTraffic(threads, std::vector<std::size_t>(traffic.size(), 0));
+
+  parallel_for(options.parallel, threads, [&](const std::size_t thread)
+               { advance_agents(*this, steps, options.agents * thread / threads, options.agents * (thread + 1) / threads, threadTraffic[thread].data()); });
+
+  // Merge the traffic
+  for (const auto &partialTraffic : threadTraffic)
+  {
+    for (std::size_t index = 0; index < traffic.size(); index++)
+    {
+      traffic[index] += partialTraffic[index];
+    }
+  }
+}
+
+void simulation_state_s::remove_vertices(const std::vector<csr_index_t> &vertices, const double decay)
+{
+  for (const auto vertex : vertices)
+  {
+    if (!alive[vertex])
+    {
+      continue;
+    }
+
+    // Drop the vertex from the live vertices
+    alive[vertex] = 0;
+    const auto position = live_position[vertex];
+    live[position] = live.back();
+    live_position[live[position]] = position;
+    live.pop_back();
+
+    // Move the vertex behind the live out-vertices of each in-vertex (Including removed ones, whose agents may still leave through them)
+    for (auto edge = graph.in_offsets[vertex]; edge < graph.in_offsets[vertex + 1]; edge++)
+    {
+      const auto source = graph.in_sources[edge];
+      const auto first = targets.begin() + graph.out_offsets[source];
+      const auto last = first + live_degree[source];
+      const auto found = std::find(first, last, vertex);
+
+      if (found != last)
+      {
+        std::iter_swap(found, last - 1);
+        live_degree[source]--;
+      }
+    }
+  }
+
+  // Decay the stale traffic
+  for (std::size_t index = 0; index < traffic.size(); index++)
+  {
+    traffic[index] = alive[index] ? (std::size_t)((double)traffic[index] * decay) : 0;
+  }
+
+  if (live.empty())
+  {
+    return;
+  }
+
+  // Move the agents off removed vertices
+  for (std::size_t agent = 0; agent < positions.size(); agent++)
+  {
+    auto &vertex = positions[agent];
+    if (alive[vertex])
+    {
+      continue;
+    }
+
+    const auto word = next_random(streams[agent]);
+    const auto degree = live_degree[vertex];
+    vertex = degree == 0 ? live[bounded_random(word, (uint32_t)live.size())] : targets[graph.out_offsets[vertex] + bounded_random(word, degree)];
+  }
+}
@@ -1,14 +1,312 @@
 #pragma once
 
+#include <cstdint>
+#include <functional>
+#include <vector>
+
 #include "common.hpp"
+#include "csr.hpp"
+#include "helpers.hpp"
+#include "random.hpp"
+#include "reorder.hpp"
+
+/**
+ * @brief The default number of agents
+ */
+#define SIMULATION_DEFAULT_AGENTS 1000
+
+/**
+ * @brief The default number of steps
+ */
+#define SIMULATION_DEFAULT_STEPS 1000
+
+/**
+ * @brief The default maximum number of batches
+ */
+#define SIMULATION_DEFAULT_BATCHES 250
+
+/**
+ * @brief The default normalized traffic change threshold
+ */
+#define SIMULATION_DEFAULT_CHANGE_THRESHOLD 0.001
+
+/**
+ * @brief Criterion for terminating the simulation early
+ */
+enum class stop_mode_e
+{
+  /**
+   * @brief Stop when the summed change in normalized traffic falls below the change threshold
+   */
+  threshold,
+
+  /**
+   * @brief Stop when the ascending traffic order is stable (By Kendall rank correlation) for several batches
+   */
+  ranking,
+};
+
+/**
+ * @brief Rule for choosing the agents' start vertices
+ */
+enum class start_mode_e
+{
+  /**
+   * @brief Start each agent at a uniformly random vertex
+   */
+  uniform,
+
+  /**
+   * @brief Start the agents round-robin over the vertices, continuing across batches (Agent a of batch b starts at
+   * vertex (b * agents + a) mod |V|)
+   */
+  stratified,
+};
+
+/**
+ * @brief Simulation progress at a batch boundary (Enough to continue exactly where the simulation stopped, since each
+ * batch's random streams are keyed by its index)
+ */
+struct simulation_checkpoint_s
+{
+  /**
+   * @brief The component key
+   */
+  std::size_t component;
+
+  /**
+   * @brief The number of completed batches
+   */
+  std::size_t batch;
+
+  /**
+   * @brief The traffic of each local index
+   */
+  std::vector<std::size_t> traffic;
+
+  /**
+   * @brief The incrementally maintained ascending traffic order (Ranking mode only)
+   */
+  std::vector<std::size_t> order;
+
+  /**
+   * @brief The number of consecutive stable batches (Ranking mode only)
+   */
+  std::size_t stable_batches;
+};
+
+/**
+ * @brief Simulation options
+ */
+struct simulation_options_s
+{
+  /**
+   * @brief The number of agents
+   */
+  std::size_t agents;
+
+  /**
+   * @brief The number of steps
+   */
+  std::size_t steps;
+
+  /**
+   * @brief The maximum number of batches (The number of steps per agent to simulate between normalized traffic change checks)
+   */
+  std::size_t batches;
+
+  /**
+   * @brief The normalized traffic change threshold (If the change in the normalized traffic between batches falls below this threshold, terminate the simulation early)
+   */
+  double change_threshold;
+
+  /**
+   * @brief The random seed
+   */
+  uint64_t seed;
+
+  /**
+   * @brief The component key (Mixed into every random stream so that components are sampled independently)
+   */
+  std::size_t component;
+
+  /**
+   * @brief The number of threads to split the agents across (Results are identical for any number of threads)
+   */
+  std::size_t threads;
+
+  /**
+   * @brief The early termination criterion
+   */
+  stop_mode_e stop_mode = stop_mode_e::threshold;
+
+  /**
+   * @brief The Kendall rank correlation between consecutive batches' traffic orders at or above which a batch counts as stable (Ranking mode only)
+   */
+  double rank_correlation = 0.999;
+
+  /**
+   * @brief The number of consecutive stable batches after which to terminate (Ranking mode only)
+   */
+  std::size_t stable_batches = 3;
+
+  /**
+   * @brief The rule for choosing the agents' start vertices
+   */
+  start_mode_e start_mode = start_mode_e::uniform;
+
+  /**
+   * @brief The number of uncounted steps each agent walks before the counted steps of every batch
+   */
+  std::size_t burn_in = 0;
+
+  /**
+   * @brief The probability of each step jumping to a uniformly random vertex instead of following an out-edge (Rounded
+   * to a multiple of 2^-WALKER_TELEPORT_BITS)
+   */
+  double teleport = 0.0;
+
+  /**
+   * @brief Whether odd agents reuse the random stream of the preceding even agent with every word complemented (So
+   * that each pair makes opposite choices)
+   */
+  bool antithetic = false;
+
+  /**
+   * @brief Called after every batch which does not end the simulation (Does not affect the traffic)
+   */
+  std::function<void(const simulation_checkpoint_s &)> checkpoint = nullptr;
+
+  /**
+   * @brief Progress to continue from, if it belongs to this component (Does not affect the traffic)
+   */
+  const simulation_checkpoint_s *resume = nullptr;
+
+  /**
+   * @brief Runs each batch's per-thread walks (If null, threads are started per batch; does not affect the traffic)
+   */
+  parallel_executor_t parallel = nullptr;
+
+  /**
+   * @brief The relabeling of the copy the agents walk, for memory locality (Does not affect the traffic)
+   */
+  reorder_e reorder = reorder_e::none;
+};
+
+/**
+ * @brief Run the automaton simulation on a compressed sparse row graph
+ * @param component The strongly connected component
+ * @param options The simulation options
+ * @return The traffic of each local index
+ * @note Agent a in batch b draws from the random stream keyed by (seed, component, b, a): the first word picks the start
+ * vertex and each step (Including burn-in steps) consumes exactly one further word, whose low WALKER_TELEPORT_BITS bits
+ * decide whether to teleport and whose value picks the out-edge or teleport target. A simulation resumed from a
+ * checkpoint therefore returns the same traffic as an uninterrupted one
+ */
+std::vector<std::size_t> simulate(const csr_graph_s &component, const simulation_options_s &options);
 
 /**
  * @brief Run the automaton simulation
  * @param component The strongly connected component
- * @param agents The number of agents
- * @param steps The number of steps
- * @param batches The maximum number of batches (The number of steps per agent to simulate between normalized traffic change checks)
- * @param change_threshold The normalized traffic change threshold (If the change in the normalized traffic between batches falls below this threshold, terminate the simulation early)
+ * @param options The simulation options
  * @return The traffic map
+ * @note Agent a in batch b draws from the random stream keyed by (seed, component, b, a): the first word picks the start
+ * vertex and each step consumes exactly one further word
+ */
+unnormalized_vertex_traffic_map_t simulate(const graph_t &component, const simulation_options_s &options);
+
+/**
+ * @brief Walk state kept between simulation rounds so that the traffic can be refreshed after vertex removals
+ * @note Each vertex's out-row lists its live out-vertices first (Removals swap the removed vertex behind them), so a
+ * removal only rewrites the rows of its in-vertices and walks keep drawing one word per step. Agent a draws from the
+ * random stream keyed by (seed, component, batches, a) for its whole life, a batch index simulate never uses. The
+ * agents, seed, component, threads and teleport options are honoured; the start mode, burn-in and antithetic options
+ * are not
+ */
+struct simulation_state_s
+{
+  /**
+   * @brief The strongly connected component
+   */
+  const csr_graph_s &graph;
+
+  /**
+   * @brief The simulation options
+   */
+  simulation_options_s options;
+
+  /**
+   * @brief The out-vertices of each vertex, live ones first (Indexed by the graph's out-offsets)
+   */
+  std::vector<csr_index_t> targets;
+
+  /**
+   * @brief The number of live out-vertices of each vertex
+   */
+  std::vector<csr_index_t> live_degree;
+
+  /**
+   * @brief The live vertices (Unordered)
+   */
+  std::vector<csr_index_t> live;
+
+  /**
+   * @brief The position of each live vertex in the live vertices
+   */
+  std::vector<csr_index_t> live_position;
+
+  /**
+   * @brief Whether each vertex is live
+   */
+  std::vector<uint8_t> alive;
+
+  /**
+   * @brief The vertex each agent is on
+   */
+  std::vector<csr_index_t> positions;
+
+  /**
+   * @brief The random stream of each agent
+   */
+  std::vector<random_stream_s> streams;
+
+  /**
+   * @brief The (Decayed) traffic of each vertex (Zero for removed vertices)
+   */
+  std::vector<std::size_t> traffic;
+
+  /**
+   * @brief Walk every agent and count the vertices it lands on
+   * @param steps The number of steps per agent
+   * @note Agents on a vertex without live out-vertices (Or teleporting) jump to a uniformly random live vertex
+   */
+  void advance(const std::size_t steps);
+
+  /**
+   * @brief Remove vertices, moving the agents on them and decaying the traffic counted so far
+   * @param vertices The vertices to remove (Already removed vertices are ignored)
+   * @param decay The factor the surviving traffic is multiplied by (In [0, 1])
+   * @note Agents on a removed vertex move to one of its live out-vertices if it has one, else to a random live vertex;
+   * agents next to a removed vertex stay put and simply stop drawing it. The cost is proportional to the removed
+   * vertices' in-rows plus one pass over the traffic and the agents
+   */
+  void remove_vertices(const std::vector<csr_index_t> &vertices, const double decay);
+
+  /**
+   * @brief Check if every vertex has been removed
+   * @return True if no vertex is live, false otherwise
+   */
+  bool empty() const
+  {
+    return live.empty();
+  }
+};
+
+/**
+ * @brief Create a simulation state with every agent on a uniformly random vertex and no traffic
+ * @param component The strongly connected component
+ * @param options The simulation options (The agents' streams are keyed by the batch index options.batches, which
+ * simulate never uses)
+ * @return The simulation state
  */
-unnormalized_vertex_traffic_map_t simulate(const graph_t &component, const std::size_t agents, const std::size_t steps, const std::size_t batches, const double change_threshold);
+simulation_state_s make_simulation_state(const csr_graph_s &component, const simulation_options_s &options);
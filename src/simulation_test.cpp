@@ -1,15 +1,40 @@
 #include <gtest/gtest.h>
-#include <tuple>
-#include <vector>
+#include <map>
+#include <numeric>
+#include <optional>
 
+#include "csr.hpp"
 #include "helpers.hpp"
 #include "simulation.hpp"
+#include "test_graphs.hpp"
+
+/**
+ * @brief Traffic keyed by vertex number
+ */
+typedef std::map<std::size_t, std::size_t> numbered_traffic_t;
+
+/**
+ * @brief Key the traffic by vertex number (Vertex descriptors are not stable across graph copies)
+ * @param graph The graph
+ * @param traffic The traffic map
+ * @return The traffic keyed by vertex number
+ */
+static numbered_traffic_t number_traffic(const graph_t &graph, const unnormalized_vertex_traffic_map_t &traffic)
+{
+  numbered_traffic_t numbered;
+  for (const auto &[vertexDescriptor, vertexTraffic] : traffic)
+  {
+    numbered[graph[vertexDescriptor].number] = vertexTraffic;
+  }
+
+  return numbered;
+}
 
 /**
  * @brief Build a graph with a single strongly connected component
- * @return The graph and the vertices
+ * @return The graph
  */
-static std::tuple<graph_t, std::vector<vertex_descriptor_t>> build_one_scc()
+static graph_t build_one_scc()
 {
   graph_t graph;
 
@@ -26,14 +51,14 @@ static std::tuple<graph_t, std::vector<vertex_descriptor_t>> build_one_scc()
   boost::add_edge(vertex1, vertex4, graph);
   boost::add_edge(vertex4, vertex5, graph);
 
-  return {graph, {vertex1, vertex2, vertex3, vertex4, vertex5}};
+  return graph;
 }
 
 /**
  * @brief Build a graph with two strongly connected components
- * @return The graph and the vertices
+ * @return The graph
  */
-static std::tuple<graph_t, std::vector<vertex_descriptor_t>> build_two_sccs()
+static graph_t build_two_sccs()
 {
   graph_t graph;
 
@@ -57,14 +82,14 @@ static std::tuple<graph_t, std::vector<vertex_descriptor_t>> build_two_sccs()
   boost::add_edge(vertex5, vertex6, graph);
   boost::add_edge(vertex6, vertex2, graph);
 
-  return {graph, {vertex1, vertex2, vertex3, vertex4, vertex5, vertex6}};
+  return graph;
 }
 
 /**
  * @brief Build a graph with a loop
- * @return The graph and the vertices
+ * @return The graph
  */
-static std::tuple<graph_t, std::vector<vertex_descriptor_t>> build_loop()
+static graph_t build_loop()
 {
   graph_t graph;
 
@@ -81,14 +106,14 @@ static std::tuple<graph_t, std::vector<vertex_descriptor_t>> build_loop()
   boost::add_edge(vertex3, vertex1, graph);
   boost::add_edge(vertex4, vertex1, graph);
 
-  return {graph, {vertex1, vertex2, vertex3, vertex4}};
+  return graph;
 }
 
 /**
  * @brief Build a fully connected graph
- * @return The graph and the vertices
+ * @return The graph
  */
-static std::tuple<graph_t, std::vector<vertex_descriptor_t>> build_fully_connected()
+static graph_t build_fully_connected()
 {
   graph_t graph;
 
@@ -135,233 +160,437 @@ static std::tuple<graph_t, std::vector<vertex_descriptor_t>> build_fully_connect
   boost::add_edge(vertex6, vertex4, graph);
   boost::add_edge(vertex6, vertex5, graph);
 
-  return {graph, {vertex1, vertex2, vertex3, vertex4, vertex5, vertex6}};
+  return graph;
 }
 
 TEST(simulate, one_scc_0)
 {
   // Build the graph
-  graph_t graph;
-  std::vector<vertex_descriptor_t> vertices;
-  std::tie(graph, vertices) = build_one_scc();
-
-  // Seed the RNG
-  set_seed(3);
+  const auto graph = build_one_scc();
 
   // Run the simulation
-  unnormalized_vertex_traffic_map_t traffic = simulate(graph, 2, 8, 1, 0.0);
+  unnormalized_vertex_traffic_map_t traffic = simulate(graph, simulation_options_s{2, 8, 1, 0.0, 3, 0, 1});
 
   // Assert the traffic
-  unnormalized_vertex_traffic_map_t expected = {
-      {vertices[0], 6},
-      {vertices[1], 3},
-      {vertices[2], 2},
-      {vertices[3], 2},
-      {vertices[4], 3},
+  numbered_traffic_t expected = {
+      {1, 6},
+      {2, 1},
+      {3, 1},
+      {4, 5},
+      {5, 3},
   };
 
-  ASSERT_EQ(traffic, expected);
+  ASSERT_EQ(number_traffic(graph, traffic), expected);
 }
 
 TEST(simulate, one_scc_1)
 {
   // Build the graph
-  graph_t graph;
-  std::vector<vertex_descriptor_t> vertices;
-  std::tie(graph, vertices) = build_one_scc();
-
-  // Seed the RNG
-  set_seed(8);
+  const auto graph = build_one_scc();
 
   // Run the simulation
-  unnormalized_vertex_traffic_map_t traffic = simulate(graph, 4, 20, 1, 0.0);
+  unnormalized_vertex_traffic_map_t traffic = simulate(graph, simulation_options_s{4, 20, 1, 0.0, 8, 0, 1});
 
   // Assert the traffic
-  unnormalized_vertex_traffic_map_t expected = {
-      {vertices[0], 27},
-      {vertices[1], 15},
-      {vertices[2], 15},
-      {vertices[3], 11},
-      {vertices[4], 12},
+  numbered_traffic_t expected = {
+      {1, 28},
+      {2, 16},
+      {3, 15},
+      {4, 10},
+      {5, 11},
   };
 
-  ASSERT_EQ(traffic, expected);
+  ASSERT_EQ(number_traffic(graph, traffic), expected);
 }
 
 TEST(simulate, two_sccs_0)
 {
   // Build the graph
-  graph_t graph;
-  std::vector<vertex_descriptor_t> vertices;
-  std::tie(graph, vertices) = build_two_sccs();
-
-  // Seed the RNG
-  set_seed(16);
+  const auto graph = build_two_sccs();
 
   // Run the simulation
-  unnormalized_vertex_traffic_map_t traffic = simulate(graph, 2, 10, 1, 0.0);
+  unnormalized_vertex_traffic_map_t traffic = simulate(graph, simulation_options_s{2, 10, 1, 0.0, 16, 0, 1});
 
   // Assert the traffic
-  unnormalized_vertex_traffic_map_t expected = {
-      {vertices[0], 1},
-      {vertices[1], 3},
-      {vertices[2], 3},
-      {vertices[3], 3},
-      {vertices[4], 5},
-      {vertices[5], 5},
+  numbered_traffic_t expected = {
+      {1, 3},
+      {2, 2},
+      {3, 3},
+      {4, 3},
+      {5, 4},
+      {6, 5},
   };
 
-  ASSERT_EQ(traffic, expected);
+  ASSERT_EQ(number_traffic(graph, traffic), expected);
 }
 
 TEST(simulate, two_sccs_1)
 {
   // Build the graph
-  graph_t graph;
-  std::vector<vertex_descriptor_t> vertices;
-  std::tie(graph, vertices) = build_two_sccs();
-
-  // Seed the RNG
-  set_seed(16);
+  const auto graph = build_two_sccs();
 
   // Run the simulation
-  unnormalized_vertex_traffic_map_t traffic = simulate(graph, 4, 30, 1, 0.0);
+  unnormalized_vertex_traffic_map_t traffic = simulate(graph, simulation_options_s{4, 30, 1, 0.0, 16, 0, 1});
 
   // Assert the traffic
-  unnormalized_vertex_traffic_map_t expected = {
-      {vertices[0], 12},
-      {vertices[1], 17},
-      {vertices[2], 19},
-      {vertices[3], 20},
-      {vertices[4], 24},
-      {vertices[5], 28},
+  numbered_traffic_t expected = {
+      {1, 15},
+      {2, 16},
+      {3, 19},
+      {4, 21},
+      {5, 22},
+      {6, 27},
   };
 
-  ASSERT_EQ(traffic, expected);
+  ASSERT_EQ(number_traffic(graph, traffic), expected);
 }
 
 TEST(simulate, two_sccs_2)
 {
   // Build the graph
-  graph_t graph;
-  std::vector<vertex_descriptor_t> vertices;
-  std::tie(graph, vertices) = build_two_sccs();
-
-  // Seed the RNG
-  set_seed(1286);
+  const auto graph = build_two_sccs();
 
   // Run the simulation
-  unnormalized_vertex_traffic_map_t traffic = simulate(graph, 10, 120, 1, 0.0);
+  unnormalized_vertex_traffic_map_t traffic = simulate(graph, simulation_options_s{10, 120, 1, 0.0, 1286, 0, 1});
 
   // Assert the traffic
-  unnormalized_vertex_traffic_map_t expected = {
-      {vertices[0], 121},
-      {vertices[1], 166},
-      {vertices[2], 191},
-      {vertices[3], 220},
-      {vertices[4], 243},
-      {vertices[5], 259},
+  numbered_traffic_t expected = {
+      {1, 127},
+      {2, 163},
+      {3, 190},
+      {4, 213},
+      {5, 241},
+      {6, 266},
   };
 
-  ASSERT_EQ(traffic, expected);
+  ASSERT_EQ(number_traffic(graph, traffic), expected);
 }
 
 TEST(simulate, loop_0)
 {
   // Build the graph
-  graph_t graph;
-  std::vector<vertex_descriptor_t> vertices;
-  std::tie(graph, vertices) = build_loop();
-
-  // Seed the RNG
-  set_seed(109237810);
+  const auto graph = build_loop();
 
   // Run the simulation
-  unnormalized_vertex_traffic_map_t traffic = simulate(graph, 1, 5, 1, 0.0);
+  unnormalized_vertex_traffic_map_t traffic = simulate(graph, simulation_options_s{1, 5, 1, 0.0, 109237810, 0, 1});
 
   // Assert the traffic
-  unnormalized_vertex_traffic_map_t expected = {
-      {vertices[0], 3},
-      {vertices[1], 1},
-      {vertices[2], 1},
-      {vertices[3], 0},
+  numbered_traffic_t expected = {
+      {1, 3},
+      {2, 1},
+      {3, 0},
+      {4, 1},
   };
 
-  ASSERT_EQ(traffic, expected);
+  ASSERT_EQ(number_traffic(graph, traffic), expected);
 }
 
 TEST(simulate, loop_1)
 {
   // Build the graph
-  graph_t graph;
-  std::vector<vertex_descriptor_t> vertices;
-  std::tie(graph, vertices) = build_loop();
-
-  // Seed the RNG
-  set_seed(109237810);
+  const auto graph = build_loop();
 
   // Run the simulation
-  unnormalized_vertex_traffic_map_t traffic = simulate(graph, 1000, 50, 1, 0.0);
+  unnormalized_vertex_traffic_map_t traffic = simulate(graph, simulation_options_s{1000, 50, 1, 0.0, 109237810, 0, 1});
 
   // Assert the traffic
-  unnormalized_vertex_traffic_map_t expected = {
-      {vertices[0], 25000},
-      {vertices[1], 8270},
-      {vertices[2], 8330},
-      {vertices[3], 8400},
+  numbered_traffic_t expected = {
+      {1, 25000},
+      {2, 8262},
+      {3, 8419},
+      {4, 8319},
   };
 
-  ASSERT_EQ(traffic, expected);
+  ASSERT_EQ(number_traffic(graph, traffic), expected);
 }
 
 TEST(simulate, fully_connected_0)
 {
   // Build the graph
-  graph_t graph;
-  std::vector<vertex_descriptor_t> vertices;
-  std::tie(graph, vertices) = build_fully_connected();
-
-  // Seed the RNG
-  set_seed(182736);
+  const auto graph = build_fully_connected();
 
   // Run the simulation
-  unnormalized_vertex_traffic_map_t traffic = simulate(graph, 2, 10, 1, 0.0);
+  unnormalized_vertex_traffic_map_t traffic = simulate(graph, simulation_options_s{2, 10, 1, 0.0, 182736, 0, 1});
 
   // Assert the traffic
-  unnormalized_vertex_traffic_map_t expected = {
-      {vertices[0], 5},
-      {vertices[1], 4},
-      {vertices[2], 1},
-      {vertices[3], 6},
-      {vertices[4], 1},
-      {vertices[5], 3},
+  numbered_traffic_t expected = {
+      {1, 3},
+      {2, 3},
+      {3, 2},
+      {4, 5},
+      {5, 4},
+      {6, 3},
   };
 
-  ASSERT_EQ(traffic, expected);
+  ASSERT_EQ(number_traffic(graph, traffic), expected);
 }
 
 TEST(simulate, fully_connected_1)
 {
   // Build the graph
-  graph_t graph;
-  std::vector<vertex_descriptor_t> vertices;
-  std::tie(graph, vertices) = build_fully_connected();
-
-  // Seed the RNG
-  set_seed(109237810);
+  const auto graph = build_fully_connected();
 
   // Run the simulation
-  unnormalized_vertex_traffic_map_t traffic = simulate(graph, 20, 100, 1, 0.0);
+  unnormalized_vertex_traffic_map_t traffic = simulate(graph, simulation_options_s{20, 100, 1, 0.0, 109237810, 0, 1});
 
   // Assert the traffic
-  unnormalized_vertex_traffic_map_t expected = {
-      {vertices[0], 348},
-      {vertices[1], 329},
-      {vertices[2], 345},
-      {vertices[3], 316},
-      {vertices[4], 329},
-      {vertices[5], 333},
+  numbered_traffic_t expected = {
+      {1, 343},
+      {2, 355},
+      {3, 327},
+      {4, 337},
+      {5, 319},
+      {6, 319},
   };
 
-  ASSERT_EQ(traffic, expected);
+  ASSERT_EQ(number_traffic(graph, traffic), expected);
+}
+
+TEST(simulate, thread_invariance)
+{
+  // Build the graph
+  const auto graph = build_fully_connected();
+
+  // Run the simulation with different numbers of threads
+  unnormalized_vertex_traffic_map_t expected = simulate(graph, simulation_options_s{37, 100, 3, 0.0, 42, 7, 1});
+
+  for (std::size_t threads = 2; threads <= 8; threads++)
+  {
+    unnormalized_vertex_traffic_map_t traffic = simulate(graph, simulation_options_s{37, 100, 3, 0.0, 42, 7, threads});
+
+    // Assert the traffic
+    ASSERT_EQ(traffic, expected);
+  }
+}
+
+TEST(simulate, reorder_invariance)
+{
+  // Build a large component (Walked with 16-bit indices) and simulate it with stratified starts and teleports
+  const auto component = build_random_component(600, 2400, 1);
+  simulation_options_s options{37, 100, 3, 0.0, 42, 7, 2};
+  options.teleport = 0.1;
+
+  for (const auto startMode : {start_mode_e::uniform, start_mode_e::stratified})
+  {
+    options.start_mode = startMode;
+    options.reorder = reorder_e::none;
+    const auto expected = simulate(component, options);
+
+    for (const auto reorder : {reorder_e::bfs, reorder_e::rcm, reorder_e::degree})
+    {
+      // Run the simulation on a relabeled copy
+      options.reorder = reorder;
+      const auto traffic = simulate(component, options);
+
+      // Assert the traffic
+      ASSERT_EQ(traffic, expected);
+    }
+  }
+}
+
+TEST(simulate, total_traffic)
+{
+  // Build the graph
+  const auto graph = build_two_sccs();
+
+  // Run the simulation
+  unnormalized_vertex_traffic_map_t traffic = simulate(graph, simulation_options_s{13, 17, 4, 0.0, 5, 0, 3});
+
+  // Assert the traffic (Every step of every agent in every batch is counted once)
+  std::size_t total = 0;
+  for (const auto &[vertexDescriptor, vertexTraffic] : traffic)
+  {
+    total += vertexTraffic;
+  }
+
+  ASSERT_EQ(total, 13 * 17 * 4);
+}
+
+TEST(simulate, ranking_stops_early)
+{
+  // Build the graph (The traffic order of a loop settles quickly: the hub first, then the spokes)
+  const auto graph = build_loop();
+
+  // Run the simulation
+  simulation_options_s options{1000, 50, 100, 0.0, 109237810, 0, 1};
+  options.stop_mode = stop_mode_e::ranking;
+  options.rank_correlation = 0.5;
+  options.stable_batches = 2;
+
+  unnormalized_vertex_traffic_map_t traffic = simulate(graph, options);
+
+  // Assert the simulation terminated before running every batch
+  std::size_t total = 0;
+  for (const auto &[vertexDescriptor, vertexTraffic] : traffic)
+  {
+    total += vertexTraffic;
+  }
+
+  ASSERT_LT(total, 1000 * 50 * 100);
+  ASSERT_EQ(total % (1000 * 50), 0);
+}
+
+TEST(simulate, ranking_stops_early_large)
+{
+  // Build the graph (A large component, whose consecutive traffic orders are far from identical)
+  const auto component = build_random_component(10000, 40000, 6);
+  ASSERT_LT(5000, component.num_vertices());
+
+  // Run the simulation
+  simulation_options_s options{100, 100, 40, 0.0, 1, 0, 1};
+  options.stop_mode = stop_mode_e::ranking;
+  options.rank_correlation = 0.5;
+  options.stable_batches = 2;
+
+  const auto traffic = simulate(component, options);
+
+  // Assert the simulation terminated before running every batch
+  const auto total = std::accumulate(traffic.begin(), traffic.end(), (std::size_t)0);
+  ASSERT_LT(total, 100 * 100 * 40);
+  ASSERT_EQ(total % (100 * 100), 0);
+}
+
+TEST(simulate, ranking_never_stable)
+{
+  // Build the graph
+  const auto graph = build_fully_connected();
+
+  // Run the simulation (A perfect correlation is unreachable for symmetric vertices with noisy traffic)
+  simulation_options_s options{10, 10, 20, 0.0, 1, 0, 1};
+  options.stop_mode = stop_mode_e::ranking;
+  options.rank_correlation = 1.0;
+  options.stable_batches = 20;
+
+  unnormalized_vertex_traffic_map_t traffic = simulate(graph, options);
+
+  // Assert every batch ran
+  std::size_t total = 0;
+  for (const auto &[vertexDescriptor, vertexTraffic] : traffic)
+  {
+    total += vertexTraffic;
+  }
+
+  ASSERT_EQ(total, 10 * 10 * 20);
+}
+
+TEST(simulate, dense_matches_map)
+{
+  // Build the graph
+  const auto graph = build_fully_connected();
+  ordered_vertex_descriptors_t indexToVertex;
+  const auto csr = build_csr(graph, indexToVertex);
+
+  // Run the simulation on both graphs
+  const auto traffic = simulate(graph, simulation_options_s{37, 100, 3, 0.0, 42, 7, 2});
+  const auto dense = simulate(csr, simulation_options_s{37, 100, 3, 0.0, 42, 7, 2});
+
+  // Assert the traffic of each local index matches its vertex's
+  ASSERT_EQ(dense.size(), indexToVertex.size());
+  for (std::size_t index = 0; index < dense.size(); index++)
+  {
+    ASSERT_EQ(dense[index], traffic.at(indexToVertex[index]));
+  }
+}
+
+TEST(simulation_state, removal)
+{
+  // Build the graph
+  ordered_vertex_descriptors_t indexToVertex;
+  const auto csr = build_csr(build_fully_connected(), indexToVertex);
+
+  // Walk, remove two vertices without keeping their traffic, then walk again
+  auto state = make_simulation_state(csr, simulation_options_s{20, 50, 1, 0.0, 3, 0, 2});
+  state.advance(50);
+  state.remove_vertices({1, 4, 1}, 0.0);
+  state.advance(30);
+
+  // Assert only the live vertices were visited after the removal
+  ASSERT_EQ(state.traffic[1], 0);
+  ASSERT_EQ(state.traffic[4], 0);
+  ASSERT_EQ(std::accumulate(state.traffic.begin(), state.traffic.end(), (std::size_t)0), 20 * 30);
+
+  for (const auto position : state.positions)
+  {
+    ASSERT_TRUE(state.alive[position]);
+  }
+}
+
+TEST(simulation_state, independent_streams)
+{
+  // Build the graph
+  ordered_vertex_descriptors_t indexToVertex;
+  const auto csr = build_csr(build_fully_connected(), indexToVertex);
+  const simulation_options_s options{37, 100, 4, 0.0, 42, 7, 1};
+  const auto state = make_simulation_state(csr, options);
+
+  // Place the agents the way the simulation's first batch does
+  std::vector<csr_index_t> firstBatch;
+  for (std::size_t agent = 0; agent < options.agents; agent++)
+  {
+    auto stream = make_random_stream(options.seed, options.component, 0, agent);
+    firstBatch.push_back(bounded_random(next_random(stream), (uint32_t)csr.num_vertices()));
+  }
+
+  // Assert the state does not replay the first batch's walks
+  ASSERT_NE(state.positions, firstBatch);
+}
+
+TEST(simulation_state, thread_invariance)
+{
+  // Build the graph
+  ordered_vertex_descriptors_t indexToVertex;
+  const auto csr = build_csr(build_fully_connected(), indexToVertex);
+
+  // Run the same rounds with different numbers of threads
+  std::vector<std::size_t> expected;
+  for (std::size_t threads = 1; threads <= 4; threads++)
+  {
+    auto state = make_simulation_state(csr, simulation_options_s{37, 100, 1, 0.0, 42, 7, threads});
+    state.advance(100);
+    state.remove_vertices({0, 2}, 0.5);
+    state.advance(40);
+
+    if (threads == 1)
+    {
+      expected = state.traffic;
+    }
+
+    // Assert the traffic
+    ASSERT_EQ(state.traffic, expected);
+  }
+}
+
+TEST(simulate, resume)
+{
+  // Build the graph
+  ordered_vertex_descriptors_t indexToVertex;
+  const auto csr = build_csr(build_fully_connected(), indexToVertex);
+
+  for (const auto stopMode : {stop_mode_e::threshold, stop_mode_e::ranking})
+  {
+    // Run the simulation without interruption, keeping the progress after the third batch
+    simulation_options_s options{20, 30, 8, 0.0, 5, 2, 2};
+    options.stop_mode = stopMode;
+    options.rank_correlation = 0.9;
+
+    std::optional<simulation_checkpoint_s> progress;
+    options.checkpoint = [&progress](const simulation_checkpoint_s &batchProgress)
+    {
+      if (batchProgress.batch == 3)
+      {
+        progress = batchProgress;
+      }
+    };
+
+    const auto expected = simulate(csr, options);
+    ASSERT_TRUE(progress);
+
+    // Resume the simulation from the progress
+    options.checkpoint = nullptr;
+    options.resume = &*progress;
+    const auto traffic = simulate(csr, options);
+
+    // Assert the traffic
+    ASSERT_EQ(traffic, expected);
+  }
 }
@@ -0,0 +1,437 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <numeric>
+
+#include "bound.hpp"
+#include "cache.hpp"
+#include "cycles.hpp"
+#include "degree.hpp"
+#include "exact.hpp"
+#include "filter.hpp"
+#include "helpers.hpp"
+#include "scc.hpp"
+#include "solve.hpp"
+
+/**
+ * @brief Get the key of a component's random streams
+ * @param component The component
+ * @return The hash of the local edge structure (Which does not depend on the vertex numbers, so the same structure is
+ * simulated the same way in any input and its cache entry matches an uncached solve)
+ */
+static std::size_t component_key(const csr_graph_s &component)
+{
+  return structure_hash(component);
+}
+
+/**
+ * @brief Simulate the traffic of each vertex (Or count the sampled cycles through it)
+ * @param component The component
+ * @param options The solver options
+ * @return The traffic of each local index
+ */
+static std::vector<std::size_t> component_traffic(const csr_graph_s &component, const solver_options_s &options)
+{
+  if (options.traffic_engine == traffic_engine_e::cycles)
+  {
+    return cycle_traffic(component, options.cycle_samples, options.simulation.seed, component_key(component), options.simulation.threads, options.simulation.parallel);
+  }
+
+  auto simulationOptions = options.simulation;
+  simulationOptions.component = component_key(component);
+  simulationOptions.reorder = options.reorder;
+  return simulate(component, simulationOptions);
+}
+
+/**
+ * @brief Order the vertices by local index
+ * @param component The component
+ * @return The local indices of the vertices in ascending order
+ */
+static std::vector<csr_index_t> identity_order(const csr_graph_s &component)
+{
+  std::vector<csr_index_t> order(component.num_vertices());
+  std::iota(order.begin(), order.end(), 0);
+
+  return order;
+}
+
+/**
+ * @brief Improve an initial cut by trying to keep its vertices again, after every vertex it already keeps
+ * @param component The component
+ * @param initial The local indices of the initial cut (Must leave the component acyclic)
+ * @param order The local indices of all vertices in the order to try keeping them
+ * @return The local indices of the vertices to cut in ascending order (A subset of the initial cut)
+ */
+static std::vector<csr_index_t> warm_start(const csr_graph_s &component, const std::vector<csr_index_t> &initial, const std::vector<csr_index_t> &order)
+{
+  std::vector<uint8_t> cut(component.num_vertices(), 0);
+  for (const auto vertex : initial)
+  {
+    cut[vertex] = 1;
+  }
+
+  // Keep the initially kept vertices first, then the initially cut vertices
+  std::vector<csr_index_t> warmOrder;
+  warmOrder.reserve(order.size());
+  for (const auto vertex : order)
+  {
+    if (!cut[vertex])
+    {
+      warmOrder.push_back(vertex);
+    }
+  }
+
+  const auto trusted = warmOrder.size();
+  for (const auto vertex : order)
+  {
+    if (cut[vertex])
+    {
+      warmOrder.push_back(vertex);
+    }
+  }
+
+  return filter_acyclic(component, warmOrder, trusted);
+}
+
+/**
+ * @brief Sort an initial cut and check that it leaves the component acyclic
+ * @param component The component
+ * @param initial The local indices of the initial cut
+ * @return The local indices of the initial cut in ascending order, or nothing if one is out of range or the cut leaves a
+ * cycle
+ */
+static std::optional<std::vector<csr_index_t>> checked_initial(const csr_graph_s &component, const std::optional<std::vector<csr_index_t>> &initial)
+{
+  if (!initial)
+  {
+    return std::nullopt;
+  }
+
+  auto cut = *initial;
+  std::sort(cut.begin(), cut.end());
+  cut.erase(std::unique(cut.begin(), cut.end()), cut.end());
+  if ((!cut.empty() && component.num_vertices() <= cut.back()) || !is_acyclic_without(component, cut))
+  {
+    return std::nullopt;
+  }
+
+  return cut;
+}
+
+/**
+ * @brief Find the vertices to cut from a piece of a divided component (Solved exactly if small enough, otherwise simulated
+ * and filtered, or divided again)
+ * @param piece The piece
+ * @param options The solver options
+ * @return The local indices of the vertices to cut in ascending order
+ */
+static std::vector<csr_index_t> piece_cut(const csr_graph_s &piece, const solver_options_s &options);
+
+/**
+ * @brief Cut the highest-traffic vertices, solve the remaining strongly connected components as pieces, then keep
+ * every cut vertex again in ascending traffic order where possible
+ * @param component The component
+ * @param options The solver options
+ * @param traffic The traffic of each local index
+ * @return The local indices of the vertices to cut in ascending order
+ */
+static std::vector<csr_index_t> divide_cut(const csr_graph_s &component, const solver_options_s &options, const std::vector<std::size_t> &traffic)
+{
+  const auto numVertices = component.num_vertices();
+
+  // Cut the highest-traffic vertices
+  const auto removedCount = std::clamp<std::size_t>((std::size_t)std::ceil(options.divide_fraction * (double)numVertices), 1, numVertices);
+  const auto removed = rank_top(traffic, removedCount);
+
+  std::vector<uint8_t> cut(numVertices, 0);
+  for (const auto vertex : removed)
+  {
+    cut[vertex] = 1;
+  }
+
+  // Build the graph without the cut vertices' edges (They become acyclic singletons)
+  csr_graph_s remaining;
+  remaining.numbers = component.numbers;
+  remaining.out_offsets.push_back(0);
+  remaining.in_offsets.push_back(0);
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    for (auto edge = component.out_offsets[vertex]; edge < component.out_offsets[vertex + 1] && !cut[vertex]; edge++)
+    {
+      if (!cut[component.out_targets[edge]])
+      {
+        remaining.out_targets.push_back(component.out_targets[edge]);
+      }
+    }
+    remaining.out_offsets.push_back((csr_index_t)remaining.out_targets.size());
+
+    for (auto edge = component.in_offsets[vertex]; edge < component.in_offsets[vertex + 1] && !cut[vertex]; edge++)
+    {
+      if (!cut[component.in_sources[edge]])
+      {
+        remaining.in_sources.push_back(component.in_sources[edge]);
+      }
+    }
+    remaining.in_offsets.push_back((csr_index_t)remaining.in_sources.size());
+  }
+
+  // Re-split the rest into strongly connected components (One batch of deletions, so a one-shot decomposition is cheapest)
+  const auto decomposition = decompose(remaining, 1, nullptr);
+  std::vector<component_view_s> pieces;
+  for (std::size_t piece = 0; piece < decomposition.num_components(); piece++)
+  {
+    const component_view_s view{remaining, decomposition, piece};
+    if (view.is_cyclic())
+    {
+      pieces.push_back(view);
+    }
+  }
+
+  // Solve the pieces in parallel, splitting the threads between them (The cuts do not depend on the number of threads;
+  // the pieces' simulations start their own threads, so an executor never runs inside its own tasks)
+  const auto workers = std::max<std::size_t>(1, std::min(options.simulation.threads, pieces.size()));
+  auto pieceOptions = options;
+  pieceOptions.simulation.threads = std::max<std::size_t>(1, options.simulation.threads / workers);
+  pieceOptions.simulation.checkpoint = nullptr;
+  pieceOptions.simulation.resume = nullptr;
+  pieceOptions.simulation.parallel = nullptr;
+
+  std::atomic<std::size_t> next = 0;
+  parallel_for(options.simulation.parallel, workers, [&](const std::size_t)
+               {
+                 for (auto piece = next++; piece < pieces.size(); piece = next++)
+                 {
+                   const auto pieceCut = piece_cut(pieces[piece].build_csr(), pieceOptions);
+
+                   // Pieces are disjoint, so their vertices' flags are written by one thread each
+                   const auto vertices = pieces[piece].vertices();
+                   for (const auto index : pieceCut)
+                   {
+                     cut[vertices[index]] = 1;
+                   }
+                 } });
+
+  // Try every cut vertex again in ascending traffic order
+  std::vector<csr_index_t> cutIndices;
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    if (cut[vertex])
+    {
+      cutIndices.push_back(vertex);
+    }
+  }
+
+  return warm_start(component, cutIndices, rank_ascending(traffic));
+}
+
+/**
+ * @brief Cut the highest-traffic live vertices in rounds, refreshing the traffic of the rest incrementally between
+ * rounds, until the live vertices are acyclic, then keep every cut vertex again in reverse removal order where possible
+ * @param component The component
+ * @param options The solver options
+ * @param traffic The traffic of each local index (The initial traffic of the rounds)
+ * @return The local indices of the vertices to cut in ascending order
+ */
+static std::vector<csr_index_t> peel_cut(const csr_graph_s &component, const solver_options_s &options, const std::vector<std::size_t> &traffic)
+{
+  auto simulationOptions = options.simulation;
+  simulationOptions.component = component_key(component);
+  auto state = make_simulation_state(component, simulationOptions);
+  state.traffic = traffic;
+
+  // Track which strongly connected components of the live vertices are still cyclic (Each round's deletions only
+  // re-split the components they hit)
+  auto scc = make_decremental_scc(component);
+  std::vector<uint8_t> cyclic(scc.members.size(), 0);
+  std::size_t cyclicCount = 0;
+  for (std::size_t piece = 0; piece < scc.members.size(); piece++)
+  {
+    cyclic[piece] = scc.is_cyclic(piece);
+    cyclicCount += cyclic[piece];
+  }
+
+  const auto refreshSteps = std::max<std::size_t>(1, options.simulation.steps / SOLVE_PEEL_STEPS_DIVISOR);
+  std::vector<csr_index_t> removalOrder;
+  while (cyclicCount != 0)
+  {
+    // Cut the highest-traffic live vertices
+    const auto removedCount = std::clamp<std::size_t>((std::size_t)std::ceil(options.divide_fraction * (double)state.live.size()), 1, state.live.size());
+    const auto order = rank_ascending(state.traffic);
+
+    std::vector<csr_index_t> removed;
+    for (auto vertex = order.rbegin(); vertex != order.rend() && removed.size() < removedCount; vertex++)
+    {
+      if (state.alive[*vertex])
+      {
+        removed.push_back(*vertex);
+      }
+    }
+
+    removalOrder.insert(removalOrder.end(), removed.begin(), removed.end());
+
+    // Re-split the components which lost a vertex (A component left empty is not among the changed ones)
+    for (const auto vertex : removed)
+    {
+      cyclicCount -= cyclic[scc.component_of[vertex]];
+      cyclic[scc.component_of[vertex]] = 0;
+    }
+
+    for (const auto piece : scc.remove_vertices(removed))
+    {
+      cyclic.resize(std::max(cyclic.size(), piece + 1), 0);
+      cyclic[piece] = scc.is_cyclic(piece);
+      cyclicCount += cyclic[piece];
+    }
+
+    // Refresh the traffic of the rest
+    state.remove_vertices(removed, SOLVE_PEEL_DECAY);
+    state.advance(refreshSteps);
+  }
+
+  // Try every cut vertex again, most recently cut first
+  std::vector<csr_index_t> order(state.live.begin(), state.live.end());
+  order.insert(order.end(), removalOrder.rbegin(), removalOrder.rend());
+
+  return warm_start(component, removalOrder, order);
+}
+
+static std::vector<csr_index_t> piece_cut(const csr_graph_s &piece, const solver_options_s &options)
+{
+  // Solve small pieces exactly
+  if (piece.num_vertices() <= std::min<std::size_t>(options.exact_threshold, EXACT_MAX_VERTICES))
+  {
+    auto cut = solve_exact(piece, options.exact_node_limit);
+    if (cut)
+    {
+      return std::move(*cut);
+    }
+  }
+
+  // Simulate the piece, then divide it again or filter it
+  const auto traffic = component_traffic(piece, options);
+  return options.divide_threshold < piece.num_vertices() ? divide_cut(piece, options, traffic) : filter_acyclic(piece, rank_ascending(traffic), 0);
+}
+
+/**
+ * @brief Find the vertices to cut from a strongly connected component which is not solved exactly
+ * @param component The component
+ * @param options The solver options
+ * @param unchecked The local indices of a known cut of the component to improve on (Ignored unless it leaves the
+ * component acyclic)
+ * @return The solution
+ */
+static component_solution_s solve_heuristic(const csr_graph_s &component, const solver_options_s &options, const std::optional<std::vector<csr_index_t>> &unchecked)
+{
+  // Sort and check the initial cut (So that an unsorted or infeasible one never reaches the solution)
+  const auto initial = checked_initial(component, unchecked);
+
+  // Look up the cache (An entry holds the chosen cut and lower bound, so a hit skips all of their work)
+  const auto useCache = options.traffic_engine != traffic_engine_e::degree && !options.cache_directory.empty();
+  std::string key;
+  std::optional<cache_entry_s> cached;
+
+  if (useCache)
+  {
+    key = cache_key(component, options);
+    cached = load_cached_cut(options.cache_directory, key, component);
+  }
+
+  // Compute the lower bound (An initial cut which meets it is optimal)
+  const auto lowerBound = cached ? cached->lower_bound : cycle_packing_bound(component);
+  if (initial && initial->size() == lowerBound)
+  {
+    return component_solution_s{*initial, lowerBound};
+  }
+
+  std::vector<csr_index_t> cut;
+  std::vector<csr_index_t> order;
+  std::size_t walkSteps = 0;
+  double walkSeconds = 0;
+
+  if (cached)
+  {
+    cut = std::move(cached->cut);
+    order = std::move(cached->order);
+  }
+  else
+  {
+    // Find a fast initial solution
+    cut = degree_cut(component, options.degree_score);
+
+    // Run the random walk or cycles engine unless the degree cut already meets the lower bound
+    if (options.traffic_engine != traffic_engine_e::degree && lowerBound < cut.size())
+    {
+      // Run the simulation and keep vertices in ascending traffic order while the kept vertices stay acyclic (Or divide or peel the component)
+      std::vector<csr_index_t> walkCut;
+      const auto walkTime = std::chrono::steady_clock::now();
+      const auto traffic = component_traffic(component, options);
+      const auto walkDuration = std::chrono::duration<double>(std::chrono::steady_clock::now() - walkTime).count();
+      order = rank_ascending(traffic);
+
+      // Count the steps (Every counted step adds one to the traffic of the vertex it reaches)
+      if (options.traffic_engine == traffic_engine_e::walk)
+      {
+        walkSteps = std::accumulate(traffic.begin(), traffic.end(), (std::size_t)0);
+        walkSeconds = walkDuration;
+      }
+
+      if (options.strategy == solve_strategy_e::divide && options.divide_threshold < component.num_vertices())
+      {
+        walkCut = divide_cut(component, options, traffic);
+      }
+      else if (options.strategy == solve_strategy_e::peel && options.divide_threshold < component.num_vertices())
+      {
+        walkCut = peel_cut(component, options, traffic);
+      }
+      else
+      {
+        walkCut = filter_acyclic(component, order, 0);
+      }
+
+      // Try the degree cut's vertices again in traffic order, and keep it unless the walk cut is no larger
+      auto degreeCut = warm_start(component, cut, order);
+      cut = walkCut.size() <= degreeCut.size() ? std::move(walkCut) : std::move(degreeCut);
+    }
+
+    // Store the cut with the lower bound and order, so a cache hit warm starts the initial cut the same way
+    if (useCache)
+    {
+      store_cached_cut(options.cache_directory, key, component, cache_entry_s{cut, order, lowerBound});
+    }
+  }
+
+  // Improve the initial cut unless the new cut already meets the lower bound, and keep it unless the new cut is strictly smaller
+  if (initial && lowerBound < cut.size())
+  {
+    if (order.empty())
+    {
+      order = identity_order(component);
+    }
+
+    auto warmCut = warm_start(component, *initial, order);
+    if (warmCut.size() <= cut.size())
+    {
+      cut = std::move(warmCut);
+    }
+  }
+
+  return component_solution_s{std::move(cut), lowerBound, walkSteps, walkSeconds};
+}
+
+component_solution_s solve_component(const csr_graph_s &component, const solver_options_s &options, const std::optional<std::vector<csr_index_t>> &initial)
+{
+  // Solve small components exactly
+  if (component.num_vertices() <= std::min<std::size_t>(options.exact_threshold, EXACT_MAX_VERTICES))
+  {
+    auto cut = solve_exact(component, options.exact_node_limit);
+    if (cut)
+    {
+      const auto size = cut->size();
+      return component_solution_s{std::move(*cut), size};
+    }
+  }
+
+  return solve_heuristic(component, options, initial);
+}
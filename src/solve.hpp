@@ -0,0 +1,178 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "csr.hpp"
+#include "degree.hpp"
+#include "reorder.hpp"
+#include "simulation.hpp"
+
+/**
+ * @brief Engine which ranks the vertices of a component
+ */
+enum class traffic_engine_e
+{
+  /**
+   * @brief Keep vertices in ascending random walk traffic order (Improved with the degree engine's cut)
+   */
+  walk,
+
+  /**
+   * @brief Only use the degree engine's greedy cut
+   */
+  degree,
+
+  /**
+   * @brief Keep vertices in ascending order of the number of sampled short cycles through them (Improved with the
+   * degree engine's cut)
+   */
+  cycles,
+};
+
+/**
+ * @brief The factor the traffic is decayed by after each peel round
+ */
+#define SOLVE_PEEL_DECAY 0.5
+
+/**
+ * @brief Each peel round walks every agent for the simulation's steps per batch divided by this
+ */
+#define SOLVE_PEEL_STEPS_DIVISOR 4
+
+/**
+ * @brief Strategy for solving a large component
+ */
+enum class solve_strategy_e
+{
+  /**
+   * @brief Simulate the whole component once and filter it vertex by vertex
+   */
+  direct,
+
+  /**
+   * @brief Cut the highest-traffic fraction of the vertices, re-split the rest into strongly connected components,
+   * solve those recursively in parallel, then try the cut vertices again (Much slower than direct, and on the test
+   * inputs the degree cut it is compared with is smaller, so the cut does not change)
+   */
+  divide,
+
+  /**
+   * @brief Repeatedly cut the highest-traffic fraction of the live vertices and refresh the traffic incrementally until
+   * the rest is acyclic, then try the cut vertices again
+   */
+  peel,
+};
+
+/**
+ * @brief Solver options
+ */
+struct solver_options_s
+{
+  /**
+   * @brief The simulation options (The component key is set per component)
+   */
+  simulation_options_s simulation;
+
+  /**
+   * @brief The number of vertices at or below which a component is solved exactly (At most EXACT_MAX_VERTICES)
+   */
+  std::size_t exact_threshold = 64;
+
+  /**
+   * @brief The maximum number of exact search nodes per component (If exceeded, the component falls back to the
+   * simulation)
+   */
+  std::size_t exact_node_limit = 1000000;
+
+  /**
+   * @brief The directory to cache the cuts of components solved by the walk or cycles engine in (Empty to disable)
+   */
+  std::string cache_directory = "";
+
+  /**
+   * @brief The engine which ranks the vertices
+   */
+  traffic_engine_e traffic_engine = traffic_engine_e::walk;
+
+  /**
+   * @brief The number of pivots the cycles engine samples per component
+   */
+  std::size_t cycle_samples = 4096;
+
+  /**
+   * @brief The score maximized by the degree engine
+   */
+  degree_score_e degree_score = degree_score_e::product;
+
+  /**
+   * @brief The strategy for components larger than divide_threshold (Walk and cycles engines; peel rounds always
+   * refresh the traffic with random walks)
+   */
+  solve_strategy_e strategy = solve_strategy_e::direct;
+
+  /**
+   * @brief The number of vertices above which the divide or peel strategy is used
+   */
+  std::size_t divide_threshold = 1024;
+
+  /**
+   * @brief The fraction of the highest-traffic vertices cut before each re-split or peel round (At least one vertex)
+   */
+  double divide_fraction = 0.05;
+
+  /**
+   * @brief The relabeling of the copy each component's random walks run on, for memory locality (Does not change the
+   * cut)
+   */
+  reorder_e reorder = reorder_e::none;
+};
+
+/**
+ * @brief Solution of a single strongly connected component
+ */
+struct component_solution_s
+{
+  /**
+   * @brief The local indices of the vertices to cut in ascending order
+   */
+  std::vector<csr_index_t> cut;
+
+  /**
+   * @brief A lower bound on the size of any cut (Equal to the size of the cut when it is known to be optimal)
+   */
+  std::size_t lower_bound;
+
+  /**
+   * @brief The number of counted random walk steps the component's simulation took (0 if the component was not
+   * simulated; the divide strategy's piece simulations and the peel strategy's refresh rounds are not counted)
+   */
+  std::size_t walk_steps = 0;
+
+  /**
+   * @brief The number of seconds the component's counted simulation took (0 if the component was not simulated)
+   */
+  double walk_seconds = 0;
+};
+
+/**
+ * @brief Find the vertices to cut from a strongly connected component
+ * @param component The component
+ * @param options The solver options
+ * @param initial The local indices of a known cut of the component to improve on (Ignored unless it leaves the component
+ * acyclic)
+ * @return The solution (The cut is never larger than a valid initial cut)
+ * @note Components of at most exact_threshold vertices are solved exactly. Larger ones (Or ones whose exact search is
+ * abandoned) start from the degree engine's cut. The walk engine ranks the vertices by simulated traffic (Walked on a
+ * copy relabeled with the reorder option, with the traffic mapped back); the cycles engine ranks them by sampled short cycles. The
+ * direct strategy keeps vertices in ascending traffic order while the kept vertices stay acyclic. The divide strategy
+ * cuts the highest-traffic vertices of components above divide_threshold, solves the remaining components recursively,
+ * then keeps every cut vertex it can again in traffic order. The peel strategy cuts the highest-traffic live vertices
+ * in rounds, refreshing the traffic on the remaining graph with SOLVE_PEEL_STEPS_DIVISOR-th simulations. The smaller of
+ * the engine's cut and the degree cut improved in traffic order is kept. With a cache directory, the kept cut is stored
+ * with the lower bound and traffic order, and a hit skips the bound, the degree cut and the engine. The initial cut is
+ * improved by keeping everything it keeps, then trying its vertices again. Work stops as soon as a cut meets the cycle
+ * packing bound
+ */
+component_solution_s solve_component(const csr_graph_s &component, const solver_options_s &options, const std::optional<std::vector<csr_index_t>> &initial);
@@ -0,0 +1,236 @@
+#include <filesystem>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+
+#include "filter.hpp"
+#include "solve.hpp"
+#include "test_graphs.hpp"
+
+TEST(solve_component, exact)
+{
+  // Solve the component exactly
+  const auto solution = solve_component(build_sample_csr(), solver_options_s{simulation_options_s{16, 16, 4, 0.0, 0, 0, 1}, 64, 1000}, std::nullopt);
+
+  // Assert only vertex 1 (On both cycles) is cut, which is optimal
+  ASSERT_EQ(solution.cut, (std::vector<csr_index_t>{0}));
+  ASSERT_EQ(solution.lower_bound, 1);
+}
+
+TEST(solve_component, simulation)
+{
+  // Solve the component with the simulation
+  const auto graph = build_sample_csr();
+  const auto solution = solve_component(graph, solver_options_s{simulation_options_s{16, 16, 4, 0.0, 0, 0, 1}, 0, 1000}, std::nullopt);
+
+  // Assert the cut breaks both cycles (1 -> 2 -> 3 -> 1 and 1 -> 4 -> 5 -> 1)
+  const auto &cut = solution.cut;
+  ASSERT_FALSE(cut.empty());
+  ASSERT_EQ(solution.lower_bound, 1);
+  const auto cuts = [&cut](const csr_index_t vertex)
+  { return std::find(cut.begin(), cut.end(), vertex) != cut.end(); };
+  ASSERT_TRUE(cuts(0) || cuts(1) || cuts(2));
+  ASSERT_TRUE(cuts(0) || cuts(3) || cuts(4));
+}
+
+TEST(solve_component, exact_fallback)
+{
+  // Solve the component with an exact node limit too small to finish
+  const auto solution = solve_component(build_sample_csr(), solver_options_s{simulation_options_s{16, 16, 4, 0.0, 0, 0, 1}, 64, 0}, std::nullopt);
+
+  // Assert the simulation still produced a cut
+  ASSERT_FALSE(solution.cut.empty());
+}
+
+TEST(solve_component, warm_start)
+{
+  // Solve the component with the simulation, starting from a redundant cut
+  const auto solution = solve_component(build_sample_csr(), solver_options_s{simulation_options_s{16, 16, 4, 0.0, 0, 0, 1}, 0, 1000}, std::vector<csr_index_t>{0, 1, 3});
+
+  // Assert the redundant vertices are kept again
+  ASSERT_EQ(solution.cut, (std::vector<csr_index_t>{0}));
+}
+
+TEST(solve_component, optimal_initial)
+{
+  // Solve the component with the simulation, starting from a cut which meets the lower bound
+  const auto solution = solve_component(build_sample_csr(), solver_options_s{simulation_options_s{16, 16, 4, 0.0, 0, 0, 1}, 0, 1000}, std::vector<csr_index_t>{0});
+
+  // Assert the initial cut is kept
+  ASSERT_EQ(solution.cut, (std::vector<csr_index_t>{0}));
+  ASSERT_EQ(solution.lower_bound, 1);
+}
+
+TEST(solve_component, checked_initial)
+{
+  // Build two 2-cycles linked into one component (A lower bound of two)
+  const auto component = build_graph(4, {{1, 2}, {2, 1}, {3, 4}, {4, 3}, {2, 3}, {4, 1}});
+  const auto options = solver_options_s{simulation_options_s{16, 16, 4, 0.0, 0, 0, 1}, 0, 1000};
+
+  // Assert an unsorted initial cut which meets the lower bound is returned sorted
+  const auto unsorted = solve_component(component, options, std::vector<csr_index_t>{2, 0});
+  ASSERT_EQ(unsorted.cut, (std::vector<csr_index_t>{0, 2}));
+  ASSERT_EQ(unsorted.lower_bound, 2);
+
+  // Assert an initial cut which leaves a cycle is ignored
+  const auto infeasible = solve_component(component, options, std::vector<csr_index_t>{0, 1});
+  ASSERT_TRUE(std::is_sorted(infeasible.cut.begin(), infeasible.cut.end()));
+  ASSERT_TRUE(is_acyclic_without(component, infeasible.cut));
+}
+
+TEST(solve_component, divide)
+{
+  // Solve a large component with the divide strategy on one and four threads
+  const auto component = build_random_component(600, 2400, 0);
+  ASSERT_LT(200, component.num_vertices());
+
+  const auto solve = [&component](const std::size_t threads)
+  { return solve_component(component, solver_options_s{simulation_options_s{16, 16, 4, 0.0, 0, 0, threads}, 0, 1000, "", traffic_engine_e::walk, 4096, degree_score_e::product, solve_strategy_e::divide, 100, 0.1}, std::nullopt); };
+  const auto single = solve(1);
+  const auto parallel = solve(4);
+
+  // Assert the cut is feasible, minimal and does not depend on the number of threads
+  ASSERT_TRUE(is_acyclic_without(component, single.cut));
+  ASSERT_LE(single.lower_bound, single.cut.size());
+  ASSERT_EQ(single.cut, parallel.cut);
+
+  for (std::size_t index = 0; index < single.cut.size(); index++)
+  {
+    auto smaller = single.cut;
+    smaller.erase(smaller.begin() + (std::ptrdiff_t)index);
+    ASSERT_FALSE(is_acyclic_without(component, smaller));
+  }
+}
+
+TEST(solve_component, peel)
+{
+  // Solve a large component with the peel strategy on one and four threads
+  const auto component = build_random_component(600, 2400, 1);
+  ASSERT_LT(200, component.num_vertices());
+
+  const auto solve = [&component](const std::size_t threads)
+  { return solve_component(component, solver_options_s{simulation_options_s{16, 16, 4, 0.0, 0, 0, threads}, 0, 1000, "", traffic_engine_e::walk, 4096, degree_score_e::product, solve_strategy_e::peel, 100, 0.1}, std::nullopt); };
+  const auto single = solve(1);
+  const auto parallel = solve(4);
+
+  // Assert the cut is feasible, minimal and does not depend on the number of threads
+  ASSERT_TRUE(is_acyclic_without(component, single.cut));
+  ASSERT_LE(single.lower_bound, single.cut.size());
+  ASSERT_EQ(single.cut, parallel.cut);
+
+  for (std::size_t index = 0; index < single.cut.size(); index++)
+  {
+    auto smaller = single.cut;
+    smaller.erase(smaller.begin() + (std::ptrdiff_t)index);
+    ASSERT_FALSE(is_acyclic_without(component, smaller));
+  }
+}
+
+TEST(solve_component, cycles)
+{
+  // Solve a large component with the cycles engine on one and four threads
+  const auto component = build_random_component(600, 2400, 2);
+  ASSERT_LT(200, component.num_vertices());
+
+  const auto solve = [&component](const std::size_t threads)
+  { return solve_component(component, solver_options_s{simulation_options_s{16, 16, 4, 0.0, 0, 0, threads}, 0, 1000, "", traffic_engine_e::cycles, 2000, degree_score_e::product}, std::nullopt); };
+  const auto single = solve(1);
+  const auto parallel = solve(4);
+
+  // Assert the cut is feasible, minimal and does not depend on the number of threads
+  ASSERT_TRUE(is_acyclic_without(component, single.cut));
+  ASSERT_LE(single.lower_bound, single.cut.size());
+  ASSERT_EQ(single.cut, parallel.cut);
+
+  for (std::size_t index = 0; index < single.cut.size(); index++)
+  {
+    auto smaller = single.cut;
+    smaller.erase(smaller.begin() + (std::ptrdiff_t)index);
+    ASSERT_FALSE(is_acyclic_without(component, smaller));
+  }
+}
+
+TEST(solve_component, reorder)
+{
+  // Solve a large component without relabeling, with an initial cut and teleports
+  const auto component = build_random_component(600, 2400, 3);
+  ASSERT_LT(200, component.num_vertices());
+
+  std::vector<csr_index_t> initial(component.num_vertices());
+  std::iota(initial.begin(), initial.end(), 0);
+
+  auto options = solver_options_s{simulation_options_s{16, 16, 4, 0.0, 0, 0, 2}, 0, 1000};
+  options.simulation.teleport = 0.05;
+  const auto expected = solve_component(component, options, initial);
+
+  for (const auto reorder : {reorder_e::bfs, reorder_e::rcm, reorder_e::degree})
+  {
+    // Solve the component with its walks relabeled
+    options.reorder = reorder;
+    const auto solution = solve_component(component, options, initial);
+
+    // Assert the relabeling only changes the memory layout
+    ASSERT_EQ(solution.cut, expected.cut);
+    ASSERT_EQ(solution.lower_bound, expected.lower_bound);
+    ASSERT_EQ(solution.walk_steps, expected.walk_steps);
+  }
+}
+
+TEST(solve_component, cache_hit)
+{
+  // Build a component, an initial cut of every vertex and an empty cache directory
+  const auto component = build_random_component(40, 80, 0);
+  ASSERT_LT(10, component.num_vertices());
+
+  std::vector<csr_index_t> initial(component.num_vertices());
+  std::iota(initial.begin(), initial.end(), 0);
+
+  const auto directory = std::filesystem::temp_directory_path() / "algobowl-solve-cache-test";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+
+  // Solve the component twice with a short simulation (The second solve is served from the cache)
+  auto options = solver_options_s{simulation_options_s{4, 8, 2, 0.0, 0, 0, 2}, 0, 1000};
+  options.cache_directory = directory.string();
+  const auto miss = solve_component(component, options, initial);
+  const auto hit = solve_component(component, options, initial);
+
+  // Assert the cache hit was not simulated and warm started the initial cut in the same traffic order
+  ASSERT_LT(0, miss.walk_steps);
+  ASSERT_EQ(hit.walk_steps, 0);
+  ASSERT_EQ(hit.cut, miss.cut);
+
+  std::filesystem::remove_all(directory);
+}
+
+TEST(solve_component, cache_hit_renumbered)
+{
+  // Build a component, a copy of it at other vertex numbers, an initial cut of every vertex and an empty cache directory
+  const auto component = build_random_component(40, 80, 0);
+  auto renumbered = component;
+  for (auto &number : renumbered.numbers)
+  {
+    number += 1000;
+  }
+
+  std::vector<csr_index_t> initial(component.num_vertices());
+  std::iota(initial.begin(), initial.end(), 0);
+
+  const auto directory = std::filesystem::temp_directory_path() / "algobowl-solve-cache-renumbered-test";
+  std::filesystem::remove_all(directory);
+  std::filesystem::create_directories(directory);
+
+  // Solve the copy without the cache, then the component and the copy with it (The copy is served from the cache)
+  auto options = solver_options_s{simulation_options_s{4, 8, 2, 0.0, 0, 0, 2}, 0, 1000};
+  const auto uncached = solve_component(renumbered, options, initial);
+
+  options.cache_directory = directory.string();
+  solve_component(component, options, initial);
+  const auto hit = solve_component(renumbered, options, initial);
+
+  // Assert the cache hit matches the uncached solve
+  ASSERT_EQ(hit.walk_steps, 0);
+  ASSERT_EQ(hit.cut, uncached.cut);
+
+  std::filesystem::remove_all(directory);
+}
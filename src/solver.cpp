@@ -1,29 +1,22 @@
+#include <algorithm>
 #include <chrono>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
-#include <unordered_map>
+#include <thread>
 
-#include "boost/graph/adjacency_list.hpp"
 #include "boost/program_options.hpp"
-#include "helpers.hpp"
+#include "budget.hpp"
+#include "checkpoint.hpp"
+#include "cluster.hpp"
+#include "compression.hpp"
+#include "csr.hpp"
+#include "exact.hpp"
+#include "filter.hpp"
 #include "input.hpp"
 #include "output.hpp"
-#include "simulation.hpp"
-
-/**
- * @brief The stide between progress updates for vertex processing
- */
-#define VERTEX_PROCESSING_PROGRESS_STRIDE 250
-
-/**
- * @brief Compare two integers such that they are sorted in ascending order
- * @param a The first integer
- * @param b The second integer
- */
-static inline bool trafficCompare(std::size_t a, std::size_t b)
-{
-  return a < b;
-}
+#include "scc.hpp"
+#include "solve.hpp"
 
 int main(int argc, char *argv[])
 {
@@ -32,15 +25,46 @@ int main(int argc, char *argv[])
   positional.add("input", 1);
   positional.add("output", 1);
 
-  // Options
+  // Options (Defaulting to the solver's defaults, which the library shares)
+  const solver_options_s defaults{};
   boost::program_options::options_description description("Allowed options");
-  description.add_options()                                                                                                                                                                                                                           // Force wrap
-      ("input", boost::program_options::value<std::string>(), "Input file")                                                                                                                                                                           // Force wrap
-      ("output", boost::program_options::value<std::string>(), "Output file")                                                                                                                                                                         // Force wrap
-      ("agents", boost::program_options::value<std::size_t>()->default_value(1000), "Number of agents")                                                                                                                                               // Force wrap
-      ("steps", boost::program_options::value<std::size_t>()->default_value(1000), "Number of steps")                                                                                                                                                 // Force wrap
-      ("batches", boost::program_options::value<std::size_t>()->default_value(250), "Maximum number of batches (Number of steps per agent to simulate between normalized traffic change checks)")                                                     // Force wrap                                                                    // Force wrap
-      ("change-threshold", boost::program_options::value<double>()->default_value(0.001), "Normalized traffic change threshold (If the change in the normalized traffic between batches falls below this threshold, terminate the simulation early)") // Force wrap
+  description.add_options()                                                                                                                                                                                                                                                                                                                                // Force wrap
+      ("input", boost::program_options::value<std::string>(), "Input file")                                                                                                                                                                                                                                                                                // Force wrap
+      ("output", boost::program_options::value<std::string>(), "Output file")                                                                                                                                                                                                                                                                              // Force wrap
+      ("agents", boost::program_options::value<std::size_t>()->default_value(SIMULATION_DEFAULT_AGENTS), "Number of agents")                                                                                                                                                                                                                               // Force wrap
+      ("steps", boost::program_options::value<std::size_t>()->default_value(SIMULATION_DEFAULT_STEPS), "Number of steps")                                                                                                                                                                                                                                  // Force wrap
+      ("batches", boost::program_options::value<std::size_t>()->default_value(SIMULATION_DEFAULT_BATCHES), "Maximum number of batches (Number of steps per agent to simulate between normalized traffic change checks)")                                                                                                                                   // Force wrap
+      ("change-threshold", boost::program_options::value<double>()->default_value(SIMULATION_DEFAULT_CHANGE_THRESHOLD), "Normalized traffic change threshold (If the change in the normalized traffic between batches falls below this threshold, terminate the simulation early)")                                                                        // Force wrap
+      ("stop-mode", boost::program_options::value<std::string>()->default_value("threshold"), "Early termination criterion (threshold: stop when the normalized traffic change falls below --change-threshold, ranking: stop when the traffic order is stable)")                                                                                           // Force wrap
+      ("rank-correlation", boost::program_options::value<double>()->default_value(0.999), "Kendall rank correlation between consecutive batches' traffic orders at or above which a batch counts as stable (Ranking mode only)")                                                                                                                           // Force wrap
+      ("stable-batches", boost::program_options::value<std::size_t>()->default_value(3), "Number of consecutive stable batches after which to terminate (Ranking mode only)")                                                                                                                                                                              // Force wrap
+      ("start-mode", boost::program_options::value<std::string>()->default_value("uniform"), "Agent start vertices (uniform: uniformly random, stratified: round-robin over the vertices)")                                                                                                                                                                // Force wrap
+      ("burn-in", boost::program_options::value<std::size_t>()->default_value(0), "Number of uncounted steps each agent walks before the counted steps of every batch")                                                                                                                                                                                    // Force wrap
+      ("teleport", boost::program_options::value<double>()->default_value(0.0), "Probability of each step jumping to a uniformly random vertex instead of following an out-edge")                                                                                                                                                                          // Force wrap
+      ("antithetic", boost::program_options::bool_switch()->default_value(false), "Pair agents so that odd agents complement the random words of the preceding even agent")                                                                                                                                                                                // Force wrap
+      ("seed", boost::program_options::value<uint64_t>()->default_value(0), "Random seed (The output is identical for a given seed regardless of the number of threads)")                                                                                                                                                                                  // Force wrap
+      ("threads", boost::program_options::value<std::size_t>()->default_value(std::thread::hardware_concurrency()), "Number of simulation threads")                                                                                                                                                                                                        // Force wrap
+      ("exact-threshold", boost::program_options::value<std::size_t>()->default_value(defaults.exact_threshold), "Number of vertices at or below which a component is solved exactly instead of simulated (At most 256, 0 to disable)")                                                                                                                    // Force wrap
+      ("exact-node-limit", boost::program_options::value<std::size_t>()->default_value(defaults.exact_node_limit), "Maximum number of exact search nodes per component (If exceeded, the component is simulated instead)")                                                                                                                                 // Force wrap
+      ("cache", boost::program_options::value<std::string>()->default_value(""), "Directory to cache the cuts of simulated components in, keyed by their structure and the options (Empty to disable)")                                                                                                                                                    // Force wrap
+      ("initial", boost::program_options::value<std::string>()->default_value(""), "Previous output file to improve on (The output is only written if the new cut is strictly smaller; otherwise the initial cut is kept)")                                                                                                                                // Force wrap
+      ("traffic-engine", boost::program_options::value<std::string>()->default_value("walk"), "Vertex ranking engine (walk: random walk traffic, improved with the degree engine's cut, degree: greedy degree engine only, cycles: sampled short cycle counts, improved with the degree engine's cut)")                                                    // Force wrap
+      ("cycle-samples", boost::program_options::value<std::size_t>()->default_value(defaults.cycle_samples), "Number of pivot vertices the cycles engine samples per component (More samples rank the vertices more accurately but take longer)")                                                                                                          // Force wrap
+      ("degree-score", boost::program_options::value<std::string>()->default_value("product"), "Score maximized by the degree engine (product: in-degree x out-degree, sum: in-degree + out-degree)")                                                                                                                                                      // Force wrap
+      ("strategy", boost::program_options::value<std::string>()->default_value("direct"), "Strategy for large components (direct: simulate and filter once, divide: cut the highest-traffic vertices, re-split and recurse in parallel, peel: cut them in rounds with refreshed traffic instead; both then try the cut vertices again; divide gives the same cut as direct on the test inputs, only much slower)")      // Force wrap
+      ("divide-threshold", boost::program_options::value<std::size_t>()->default_value(defaults.divide_threshold), "Number of vertices above which the divide or peel strategy is used")                                                                                                                                                                   // Force wrap
+      ("divide-fraction", boost::program_options::value<double>()->default_value(defaults.divide_fraction), "Fraction of the highest-traffic vertices cut before each re-split or peel round")                                                                                                                                                             // Force wrap
+      ("reorder", boost::program_options::value<std::string>()->default_value("none"), "Vertex relabeling of the copy each component's random walks run on, for memory locality; the cut is unchanged (none, bfs: breadth-first search order, rcm: reverse Cuthill-McKee order, degree: descending degree)")                                                                           // Force wrap
+      ("budget", boost::program_options::value<std::size_t>()->default_value(0), "Total number of counted random walk steps, split across the components by vertex and edge count instead of using --batches (Steps a component leaves unused after terminating early go to the components after it; walk engine and direct strategy only, 0 to disable)") // Force wrap
+      ("budget-seconds", boost::program_options::value<double>()->default_value(0), "Number of seconds to split across the components like --budget, converted to steps at the observed simulation rate (0 to disable)")                                                                                                                                   // Force wrap
+      ("cheap-threshold", boost::program_options::value<std::size_t>()->default_value(256), "Number of vertices at or below which a component takes the degree engine instead of a share of the budget (Budget only)")                                                                                                                                     // Force wrap
+      ("coordinator", boost::program_options::value<std::string>()->default_value(""), "Address to hand components out to worker processes on (unix:PATH or tcp:HOST:PORT, empty to solve locally)")                                                                                                                                                       // Force wrap
+      ("workers", boost::program_options::value<std::size_t>()->default_value(0), "Number of local worker processes the coordinator starts, splitting the threads between them (0 to wait for external workers)")                                                                                                                                          // Force wrap
+      ("worker", boost::program_options::value<std::string>()->default_value(""), "Solve components for the coordinator at this address instead of reading the input (The options come from the coordinator)")                                                                                                                                             // Force wrap
+      ("checkpoint", boost::program_options::value<std::string>()->default_value(""), "File to save the progress to between components and simulation batches (Empty to disable)")                                                                                                                                                                         // Force wrap
+      ("checkpoint-interval", boost::program_options::value<double>()->default_value(60), "Minimum number of seconds between checkpoints")                                                                                                                                                                                                                 // Force wrap
+      ("resume", boost::program_options::value<std::string>()->default_value(""), "Checkpoint to continue from (Requires the same input, initial cut and options except the threads; the result matches an uninterrupted run)")                                                                                                                            // Force wrap
+      ("compress", boost::program_options::value<std::string>()->default_value("auto"), "Output compression (auto: by the output file's extension, .gz for gzip or .zst for zstd, none, gzip, zstd; compressed inputs are detected automatically)")                                                                                                        // Force wrap
       ("help", "Print this help message");
 
   // Parse the arguments and options
@@ -54,6 +78,12 @@ int main(int argc, char *argv[])
     std::cout << description << std::endl;
     return 1;
   }
+  // Run as a worker
+  else if (!options["worker"].as<std::string>().empty())
+  {
+    run_worker(options["worker"].as<std::string>(), options["threads"].as<std::size_t>());
+    return 0;
+  }
   // Validate the input and output
   else if (!options.contains("input") || !options.contains("output"))
   {
@@ -68,140 +98,536 @@ int main(int argc, char *argv[])
   std::size_t steps = options["steps"].as<std::size_t>();
   std::size_t batches = options["batches"].as<std::size_t>();
   double changeThreshold = options["change-threshold"].as<double>();
+  std::string stopModeName = options["stop-mode"].as<std::string>();
+  double rankCorrelation = options["rank-correlation"].as<double>();
+  std::size_t stableBatches = options["stable-batches"].as<std::size_t>();
+  std::string startModeName = options["start-mode"].as<std::string>();
+  std::size_t burnIn = options["burn-in"].as<std::size_t>();
+  double teleport = options["teleport"].as<double>();
+  bool antithetic = options["antithetic"].as<bool>();
+  uint64_t seed = options["seed"].as<uint64_t>();
+  std::size_t threads = options["threads"].as<std::size_t>();
+  std::size_t exactThreshold = options["exact-threshold"].as<std::size_t>();
+  std::size_t exactNodeLimit = options["exact-node-limit"].as<std::size_t>();
+  std::string cacheDirectory = options["cache"].as<std::string>();
+  std::string initialFilename = options["initial"].as<std::string>();
+  std::string trafficEngineName = options["traffic-engine"].as<std::string>();
+  std::size_t cycleSamples = options["cycle-samples"].as<std::size_t>();
+  std::string degreeScoreName = options["degree-score"].as<std::string>();
+  std::string strategyName = options["strategy"].as<std::string>();
+  std::size_t divideThreshold = options["divide-threshold"].as<std::size_t>();
+  double divideFraction = options["divide-fraction"].as<double>();
+  std::string reorderName = options["reorder"].as<std::string>();
+  std::size_t budget = options["budget"].as<std::size_t>();
+  double budgetSeconds = options["budget-seconds"].as<double>();
+  std::size_t cheapThreshold = options["cheap-threshold"].as<std::size_t>();
+  std::string coordinatorAddress = options["coordinator"].as<std::string>();
+  std::size_t workers = options["workers"].as<std::size_t>();
+  std::string checkpointFilename = options["checkpoint"].as<std::string>();
+  double checkpointInterval = options["checkpoint-interval"].as<double>();
+  std::string resumeFilename = options["resume"].as<std::string>();
+  std::string compressName = options["compress"].as<std::string>();
+
+  // Validate the stop mode
+  stop_mode_e stopMode;
+  if (stopModeName == "threshold")
+  {
+    stopMode = stop_mode_e::threshold;
+  }
+  else if (stopModeName == "ranking")
+  {
+    stopMode = stop_mode_e::ranking;
+  }
+  else
+  {
+    std::cerr << "Error: invalid stop mode: " << stopModeName << std::endl;
+    return 1;
+  }
 
-  // Get the time
-  auto startTime = std::chrono::steady_clock::now();
+  // Validate the start mode
+  start_mode_e startMode;
+  if (startModeName == "uniform")
+  {
+    startMode = start_mode_e::uniform;
+  }
+  else if (startModeName == "stratified")
+  {
+    startMode = start_mode_e::stratified;
+  }
+  else
+  {
+    std::cerr << "Error: invalid start mode: " << startModeName << std::endl;
+    return 1;
+  }
 
-  // Open the files
-  std::ifstream input;
-  input.open(inputFilename);
+  // Validate the teleport probability
+  if (!(0 <= teleport && teleport <= 1))
+  {
+    std::cerr << "Error: teleport probability must be between 0 and 1" << std::endl;
+    return 1;
+  }
 
-  if (!input.is_open())
+  // Validate the traffic engine
+  traffic_engine_e trafficEngine;
+  if (trafficEngineName == "walk")
   {
-    std::cerr << "Error: failed to open input file: " << inputFilename << std::endl;
+    trafficEngine = traffic_engine_e::walk;
+  }
+  else if (trafficEngineName == "degree")
+  {
+    trafficEngine = traffic_engine_e::degree;
+  }
+  else if (trafficEngineName == "cycles")
+  {
+    trafficEngine = traffic_engine_e::cycles;
+  }
+  else
+  {
+    std::cerr << "Error: invalid traffic engine: " << trafficEngineName << std::endl;
     return 1;
   }
 
-  std::ofstream output;
-  output.open(outputFilename);
+  // Validate the degree score
+  degree_score_e degreeScore;
+  if (degreeScoreName == "product")
+  {
+    degreeScore = degree_score_e::product;
+  }
+  else if (degreeScoreName == "sum")
+  {
+    degreeScore = degree_score_e::sum;
+  }
+  else
+  {
+    std::cerr << "Error: invalid degree score: " << degreeScoreName << std::endl;
+    return 1;
+  }
 
-  if (!output.is_open())
+  // Validate the strategy
+  solve_strategy_e strategy;
+  if (strategyName == "direct")
   {
-    std::cerr << "Error: failed to open output file:" << outputFilename << std::endl;
+    strategy = solve_strategy_e::direct;
+  }
+  else if (strategyName == "divide")
+  {
+    strategy = solve_strategy_e::divide;
+  }
+  else if (strategyName == "peel")
+  {
+    strategy = solve_strategy_e::peel;
+  }
+  else
+  {
+    std::cerr << "Error: invalid strategy: " << strategyName << std::endl;
     return 1;
   }
 
-  // Deserialize the input
-  auto graph = deserialize_input(input);
+  // Validate the divide fraction
+  if (!(0 < divideFraction && divideFraction < 1))
+  {
+    std::cerr << "Error: divide fraction must be between 0 and 1" << std::endl;
+    return 1;
+  }
 
-  // Run Tarjans
-  const auto subgraphs = tarjans_subgraphs(graph);
+  // Validate the reordering
+  reorder_e reorder;
+  if (reorderName == "none")
+  {
+    reorder = reorder_e::none;
+  }
+  else if (reorderName == "bfs")
+  {
+    reorder = reorder_e::bfs;
+  }
+  else if (reorderName == "rcm")
+  {
+    reorder = reorder_e::rcm;
+  }
+  else if (reorderName == "degree")
+  {
+    reorder = reorder_e::degree;
+  }
+  else
+  {
+    std::cerr << "Error: invalid reordering: " << reorderName << std::endl;
+    return 1;
+  }
 
-  // Get vertices to remove
-  unordered_vertex_properties_t cutVertices;
-  std::size_t subgraphsSize = subgraphs.size();
-  std::size_t subgraphIndex = 0;
+  // Validate the exact threshold
+  if (EXACT_MAX_VERTICES < exactThreshold)
+  {
+    std::cerr << "Error: exact threshold must be at most " << EXACT_MAX_VERTICES << std::endl;
+    return 1;
+  }
+
+  // Validate the output compression
+  compression_e compression;
+  if (compressName == "auto")
+  {
+    compression = compression_from_extension(outputFilename);
+  }
+  else if (compressName == "none")
+  {
+    compression = compression_e::none;
+  }
+  else if (compressName == "gzip")
+  {
+    compression = compression_e::gzip;
+  }
+  else if (compressName == "zstd")
+  {
+    compression = compression_e::zstd;
+  }
+  else
+  {
+    std::cerr << "Error: invalid output compression: " << compressName << std::endl;
+    return 1;
+  }
+
+  if (!compression_supported(compression))
+  {
+    std::cerr << "Error: this build does not support zstd compression" << std::endl;
+    return 1;
+  }
+
+  // Validate the checkpoints
+  if (!coordinatorAddress.empty() && (!checkpointFilename.empty() || !resumeFilename.empty()))
+  {
+    std::cerr << "Error: checkpoints cannot be combined with a coordinator" << std::endl;
+    return 1;
+  }
+
+  // Validate the budget
+  const auto budgeted = budget != 0 || budgetSeconds != 0;
+  if (budgetSeconds < 0)
+  {
+    std::cerr << "Error: budget seconds must not be negative" << std::endl;
+    return 1;
+  }
 
-  for (const auto &subgraph : subgraphs)
+  if (budgeted && (trafficEngine != traffic_engine_e::walk || strategy != solve_strategy_e::direct))
   {
-    std::size_t subgraphVertices = boost::num_vertices(subgraph);
+    std::cerr << "Error: a budget requires the walk traffic engine and the direct strategy" << std::endl;
+    return 1;
+  }
 
-    // Skip if the subgraph is just a single vertex
-    if (subgraphVertices == 1)
+  if (budgeted && (!coordinatorAddress.empty() || !checkpointFilename.empty() || !resumeFilename.empty()))
+  {
+    std::cerr << "Error: a budget cannot be combined with a coordinator or checkpoints" << std::endl;
+    return 1;
+  }
+
+  // Check that the output file can be written before solving, without truncating it (It is only written once solving
+  // has finished, and an initial file which is also the output is left untouched unless the cut improves)
+  if (initialFilename.empty() || std::filesystem::weakly_canonical(initialFilename) != std::filesystem::weakly_canonical(outputFilename))
+  {
+    const auto existed = std::filesystem::exists(outputFilename);
+    const auto writable = std::ofstream(outputFilename, std::ios::app).is_open();
+
+    if (!writable)
     {
-      continue;
+      std::cerr << "Error: failed to open output file: " << outputFilename << std::endl;
+      return 1;
     }
 
-    // Run the simulation
-    const auto traffic = simulate(subgraph, agents, steps, batches, changeThreshold);
-
-    // Sort by traffic
-    const auto sorted = mapsort<vertex_descriptor_t, std::size_t>(traffic, trafficCompare);
+    // Do not leave an empty output behind if solving fails
+    if (!existed)
+    {
+      std::filesystem::remove(outputFilename);
+    }
+  }
 
-    // Build the acyclic graph vertex by vertex
-    graph_t acyclicGraph;
-    std::unordered_map<vertex_properties_s, vertex_descriptor_t> acyclicVertices;
-    std::size_t vertexProgressIndex = 0;
+  // Create the cache directory
+  if (!cacheDirectory.empty())
+  {
+    std::error_code error;
+    std::filesystem::create_directories(cacheDirectory, error);
 
-    for (const auto &subgraphVertexDescriptor : sorted)
+    if (error)
     {
-      // Get the vertex
-      const auto vertexProperties = subgraph[subgraphVertexDescriptor];
+      std::cerr << "Error: failed to create cache directory: " << cacheDirectory << std::endl;
+      return 1;
+    }
+  }
 
-      // Add the vertex
-      const auto cloneVertexDescriptor = boost::add_vertex(vertexProperties, acyclicGraph);
-      acyclicVertices[vertexProperties] = cloneVertexDescriptor;
+  const solver_options_s solverOptions{simulation_options_s{agents, steps, batches, changeThreshold, seed, 0, threads, stopMode, rankCorrelation, stableBatches, startMode, burnIn, teleport, antithetic}, exactThreshold, exactNodeLimit, cacheDirectory, trafficEngine, cycleSamples, degreeScore, strategy, divideThreshold, divideFraction, reorder};
 
-      // Add in edges
-      for (const auto &edgeDescriptor : boost::make_iterator_range(boost::in_edges(subgraphVertexDescriptor, subgraph)))
-      {
-        // Get the source vertex properties
-        const auto sourceProperties = subgraph[boost::source(edgeDescriptor, subgraph)];
+  // Get the time
+  auto startTime = std::chrono::steady_clock::now();
 
-        // Skip if the source vertex is not in the acyclic graph
-        if (!acyclicVertices.contains(sourceProperties))
-        {
-          continue;
-        }
+  // Open the files (Compressed files are decompressed on a separate thread while they are parsed)
+  const auto input = open_input(inputFilename);
 
-        // Get the source vertex descriptor
-        const auto cloneSourceDescriptor = acyclicVertices[sourceProperties];
+  if (input == nullptr)
+  {
+    std::cerr << "Error: failed to open input file: " << inputFilename << std::endl;
+    return 1;
+  }
 
-        // Add the edge
-        boost::add_edge(cloneSourceDescriptor, cloneVertexDescriptor, acyclicGraph);
-      }
+  // Deserialize the input
+  auto graph = deserialize_input(*input);
 
-      // Add out edges
-      for (const auto &edgeDescriptor : boost::make_iterator_range(boost::out_edges(subgraphVertexDescriptor, subgraph)))
-      {
-        // Get the target vertex properties
-        const auto targetProperties = subgraph[boost::target(edgeDescriptor, subgraph)];
+  // Decompose the graph into strongly connected components
+  ordered_vertex_descriptors_t indexToVertex;
+  const auto csr = build_csr(graph, indexToVertex);
+  const auto decomposition = decompose(csr, threads, nullptr);
 
-        // Skip if the target vertex is not in the acyclic graph
-        if (!acyclicVertices.contains(targetProperties))
-        {
-          continue;
-        }
+  // Load the initial cut
+  unordered_vertex_properties_t initialVertices;
+  std::vector<uint8_t> initialCut;
 
-        // Get the target vertex descriptor
-        const auto cloneTargetDescriptor = acyclicVertices[targetProperties];
+  if (!initialFilename.empty())
+  {
+    const auto initial = open_input(initialFilename);
 
-        // Add the edge
-        boost::add_edge(cloneVertexDescriptor, cloneTargetDescriptor, acyclicGraph);
-      }
+    if (initial == nullptr)
+    {
+      std::cerr << "Error: failed to open initial file: " << initialFilename << std::endl;
+      return 1;
+    }
 
-      // Revert changes if the graph is cyclic
-      if (detect_cycles(acyclicGraph))
+    initialVertices = deserialize_output(*initial);
+
+    // Map the vertices to indices (The numbers are in ascending order)
+    std::vector<csr_index_t> initialIndices;
+    initialCut.assign(csr.num_vertices(), 0);
+    for (const auto &vertex : initialVertices)
+    {
+      const auto number = std::lower_bound(csr.numbers.begin(), csr.numbers.end(), vertex.number);
+      if (number == csr.numbers.end() || *number != vertex.number)
       {
-        acyclicVertices.erase(vertexProperties);
-        boost::clear_vertex(cloneVertexDescriptor, acyclicGraph);
-        boost::remove_vertex(cloneVertexDescriptor, acyclicGraph);
+        std::cerr << "Error: initial file contains unknown vertex: " << vertex.number << std::endl;
+        return 1;
       }
 
-      // Update and print progress
-      vertexProgressIndex++;
-      if (vertexProgressIndex % VERTEX_PROCESSING_PROGRESS_STRIDE == 0)
+      initialIndices.push_back((csr_index_t)(number - csr.numbers.begin()));
+      initialCut[initialIndices.back()] = 1;
+    }
+
+    // Validate the initial cut
+    if (!is_acyclic_without(csr, initialIndices))
+    {
+      std::cerr << "Error: initial cut leaves a cycle: " << initialFilename << std::endl;
+      return 1;
+    }
+  }
+
+  // Get the components which contain a cycle (Acyclic singletons are never materialized)
+  std::vector<component_view_s> components;
+  for (std::size_t component = 0; component < decomposition.num_components(); component++)
+  {
+    const component_view_s view{csr, decomposition, component};
+    if (view.is_cyclic())
+    {
+      components.push_back(view);
+    }
+  }
+
+  // Split the budget by the weight of the components (Ones at most the cheap threshold weigh nothing)
+  std::vector<std::size_t> weights;
+  std::optional<budget_planner_s> planner;
+
+  if (budgeted)
+  {
+    planner = make_budget_planner(budget, budgetSeconds, 0, cheapThreshold);
+    for (const auto &component : components)
+    {
+      weights.push_back(component.size() == 1 ? 0 : planner->weight(component.size(), component.num_edges()));
+      planner->remaining_weight += weights.back();
+    }
+  }
+
+  // Restrict the initial cut to a component
+  const auto component_initial = [&initialCut](const component_view_s &component)
+  {
+    std::optional<std::vector<csr_index_t>> initial;
+    if (!initialCut.empty())
+    {
+      initial.emplace();
+      const auto vertices = component.vertices();
+      for (std::size_t index = 0; index < vertices.size(); index++)
       {
-        std::cout << "Processed vertex " << vertexProgressIndex << " of " << sorted.size() << " (" << vertexProgressIndex * 100 / sorted.size() << "%)" << std::endl;
+        if (initialCut[vertices[index]])
+        {
+          initial->push_back((csr_index_t)index);
+        }
       }
     }
 
-    // Add all vertices to remove which are not in the acyclic graph
-    for (const auto &vertexDescriptor : sorted)
+    return initial;
+  };
+
+  // Solve the components with more than one vertex on worker processes
+  std::vector<component_solution_s> remoteSolutions;
+  if (!coordinatorAddress.empty())
+  {
+    std::vector<const component_view_s *> remoteComponents;
+    std::vector<std::size_t> sizes;
+    for (const auto &component : components)
     {
-      if (acyclicVertices.find(subgraph[vertexDescriptor]) == acyclicVertices.end())
+      if (component.size() != 1)
       {
-        cutVertices.insert(subgraph[vertexDescriptor]);
+        remoteComponents.push_back(&component);
+        sizes.push_back(component.size());
       }
     }
 
+    std::cout << "Handing out " << sizes.size() << " components on " << coordinatorAddress << std::endl;
+    remoteSolutions = coordinate(
+        coordinatorAddress, solverOptions, sizes, [&](const std::size_t task)
+        { return cluster_task_s{remoteComponents[task]->build_csr(), component_initial(*remoteComponents[task])}; },
+        argv[0], workers, threads);
+  }
+
+  // Get vertices to remove
+  unordered_vertex_properties_t cutVertices;
+  std::size_t lowerBound = 0;
+  std::size_t subgraphsSize = components.size();
+  std::size_t subgraphIndex = 0;
+  std::size_t remoteIndex = 0;
+
+  // Continue from the checkpoint
+  const auto fingerprint = checkpoint_fingerprint(csr, solverOptions, initialCut);
+  std::optional<checkpoint_s> resumed;
+
+  if (!resumeFilename.empty())
+  {
+    try
+    {
+      resumed = load_checkpoint(resumeFilename);
+    }
+    catch (const std::runtime_error &error)
+    {
+      std::cerr << "Error: failed to load checkpoint: " << error.what() << std::endl;
+      return 1;
+    }
+
+    if (resumed->fingerprint != fingerprint || components.size() < resumed->components)
+    {
+      std::cerr << "Error: checkpoint was saved for another input, initial cut or options: " << resumeFilename << std::endl;
+      return 1;
+    }
+
+    for (const auto number : resumed->cut)
+    {
+      cutVertices.insert(vertex_properties_s{number});
+    }
+
+    lowerBound = resumed->lower_bound;
+    subgraphIndex = resumed->components;
+    std::cout << "Resuming after component " << subgraphIndex << " of " << subgraphsSize << std::endl;
+  }
+
+  // Save the progress if the checkpoint interval has elapsed
+  auto checkpointTime = std::chrono::steady_clock::now();
+  const auto save_progress = [&](const simulation_checkpoint_s *simulation)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    if (checkpointFilename.empty() || std::chrono::duration<double>(now - checkpointTime).count() < checkpointInterval)
+    {
+      return;
+    }
+
+    checkpoint_s checkpoint{fingerprint, subgraphIndex, lowerBound, {}, std::nullopt};
+    for (const auto &vertex : cutVertices)
+    {
+      checkpoint.cut.push_back(vertex.number);
+    }
+
+    if (simulation)
+    {
+      checkpoint.simulation = *simulation;
+    }
+
+    // Keep solving if the save fails (It is retried after the next interval)
+    save_checkpoint(checkpointFilename, checkpoint);
+    checkpointTime = now;
+  };
+
+  for (; subgraphIndex < components.size(); save_progress(nullptr))
+  {
+    const auto &component = components[subgraphIndex];
+
+    // Cut singletons with a self-loop
+    if (component.size() == 1)
+    {
+      cutVertices.insert(vertex_properties_s{component.key()});
+
+      lowerBound++;
+      subgraphIndex++;
+      continue;
+    }
+
+    // Save the progress between simulation batches, and continue the interrupted simulation
+    auto componentOptions = solverOptions;
+    componentOptions.simulation.checkpoint = [&save_progress](const simulation_checkpoint_s &progress)
+    { save_progress(&progress); };
+
+    if (resumed && resumed->components == subgraphIndex && resumed->simulation)
+    {
+      componentOptions.simulation.resume = &*resumed->simulation;
+    }
+
+    // Size the simulation from the component's share of the budget
+    if (planner)
+    {
+      componentOptions = planner->plan(component.size(), weights[subgraphIndex], componentOptions);
+    }
+
+    // Solve the component (Or take its remote solution)
+    const auto solveTime = std::chrono::steady_clock::now();
+    const auto solution = coordinatorAddress.empty() ? solve_component(component.build_csr(), componentOptions, component_initial(component)) : std::move(remoteSolutions[remoteIndex++]);
+
+    if (planner)
+    {
+      planner->record(weights[subgraphIndex], solution.walk_steps, solution.walk_seconds, std::chrono::duration<double>(std::chrono::steady_clock::now() - solveTime).count());
+    }
+
+    const auto vertices = component.vertices();
+    for (const auto index : solution.cut)
+    {
+      cutVertices.insert(vertex_properties_s{csr.numbers[vertices[index]]});
+    }
+
+    lowerBound += solution.lower_bound;
+
     // Update and print progress
     subgraphIndex++;
-    std::cout << "Processed component " << subgraphIndex << " of " << subgraphsSize << " (" << subgraphIndex * 100 / subgraphsSize << "%)" << std::endl;
+    std::cout << "Processed component " << subgraphIndex << " of " << subgraphsSize << " (" << subgraphIndex * 100 / subgraphsSize << "%) with " << component.size() << " vertices: cut " << solution.cut.size() << ", lower bound " << solution.lower_bound << ", gap " << solution.cut.size() - solution.lower_bound << (planner ? ", walk steps " + std::to_string(solution.walk_steps) : "") << std::endl;
+  }
+
+  // Print the optimality gap
+  std::cout << "Cut " << cutVertices.size() << " vertices with lower bound " << lowerBound << " (Gap " << cutVertices.size() - lowerBound << ")" << std::endl;
+
+  // Keep the initial cut unless the new cut is strictly smaller
+  if (!initialFilename.empty() && initialVertices.size() <= cutVertices.size())
+  {
+    std::cout << "No improvement on the initial cut of " << initialVertices.size() << " vertices" << std::endl;
+
+    if (std::filesystem::weakly_canonical(initialFilename) == std::filesystem::weakly_canonical(outputFilename))
+    {
+      return 0;
+    }
+
+    cutVertices = initialVertices;
+  }
+  else if (!initialFilename.empty())
+  {
+    std::cout << "Improved the initial cut from " << initialVertices.size() << " to " << cutVertices.size() << " vertices" << std::endl;
   }
 
   // Serialize the output
-  serialize_output(output, cutVertices);
+  const auto output = open_output(outputFilename, compression);
+
+  if (output == nullptr)
+  {
+    std::cerr << "Error: failed to open output file:" << outputFilename << std::endl;
+    return 1;
+  }
+
+  serialize_output(*output, cutVertices);
+  close_output(*output);
 
   // Get the time
   auto endTime = std::chrono::steady_clock::now();
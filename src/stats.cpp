@@ -0,0 +1,222 @@
+#include <algorithm>
+#include <bit>
+#include <iomanip>
+
+#include "exact.hpp"
+#include "scc.hpp"
+#include "stats.hpp"
+
+/**
+ * @brief Count values into power-of-two buckets
+ * @param values The values
+ * @param zero Whether the first bucket holds 0 (Otherwise it holds 1)
+ * @return The buckets up to the largest value
+ */
+static std::vector<histogram_bucket_s> build_histogram(const std::vector<std::size_t> &values, const bool zero)
+{
+  std::vector<histogram_bucket_s> buckets;
+  for (const auto value : values)
+  {
+    // Bucket b holds 2^(b-1) to 2^b - 1, and bucket 0 holds 0
+    const auto bucket = (std::size_t)std::bit_width(value) - (zero ? 0 : 1);
+    while (buckets.size() <= bucket)
+    {
+      const auto index = buckets.size() + (zero ? 0 : 1);
+      buckets.push_back(histogram_bucket_s{index == 0 ? 0 : (std::size_t)1 << (index - 1), index == 0 ? 0 : ((std::size_t)1 << index) - 1, 0});
+    }
+
+    buckets[bucket].count++;
+  }
+
+  return buckets;
+}
+
+/**
+ * @brief Check if a graph has an edge
+ * @param graph The graph
+ * @param source The source vertex
+ * @param target The target vertex
+ * @return True if the edge exists, false otherwise
+ */
+static bool has_edge(const csr_graph_s &graph, const csr_index_t source, const csr_index_t target)
+{
+  const auto first = graph.out_targets.begin() + graph.out_offsets[source];
+  const auto last = graph.out_targets.begin() + graph.out_offsets[source + 1];
+  return std::binary_search(first, last, target);
+}
+
+graph_stats_s profile_graph(const csr_graph_s &graph, const solver_options_s &options)
+{
+  const auto numVertices = graph.num_vertices();
+
+  graph_stats_s stats{};
+  stats.num_vertices = numVertices;
+  stats.num_edges = graph.num_edges();
+
+  // Count the degrees, self-loops and 2-cycles
+  std::vector<std::size_t> inDegrees(numVertices);
+  std::vector<std::size_t> outDegrees(numVertices);
+  for (csr_index_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    inDegrees[vertex] = graph.in_offsets[vertex + 1] - graph.in_offsets[vertex];
+    outDegrees[vertex] = graph.out_offsets[vertex + 1] - graph.out_offsets[vertex];
+
+    for (auto edge = graph.out_offsets[vertex]; edge < graph.out_offsets[vertex + 1]; edge++)
+    {
+      const auto target = graph.out_targets[edge];
+      if (target == vertex)
+      {
+        stats.self_loops++;
+      }
+      else if (vertex < target && has_edge(graph, target, vertex))
+      {
+        stats.two_cycles++;
+      }
+    }
+  }
+
+  stats.max_in_degree = numVertices == 0 ? 0 : *std::max_element(inDegrees.begin(), inDegrees.end());
+  stats.max_out_degree = numVertices == 0 ? 0 : *std::max_element(outDegrees.begin(), outDegrees.end());
+  stats.in_degrees = build_histogram(inDegrees, true);
+  stats.out_degrees = build_histogram(outDegrees, true);
+
+  // Size the strongly connected components and the work on them
+  const auto decomposition = decompose(graph, options.simulation.threads, nullptr);
+  const auto &simulation = options.simulation;
+  std::vector<std::size_t> sizes;
+
+  stats.num_components = decomposition.num_components();
+  for (std::size_t component = 0; component < decomposition.num_components(); component++)
+  {
+    const component_view_s view{graph, decomposition, component};
+    stats.largest_component = std::max(stats.largest_component, view.size());
+
+    if (!view.is_cyclic())
+    {
+      continue;
+    }
+
+    sizes.push_back(view.size());
+    if (view.size() <= std::min<std::size_t>(options.exact_threshold, EXACT_MAX_VERTICES))
+    {
+      stats.exact_components++;
+    }
+    else
+    {
+      stats.simulated_components++;
+      stats.simulated_vertices += view.size();
+      stats.max_walk_steps += simulation.agents * simulation.steps * simulation.batches;
+    }
+  }
+
+  stats.cyclic_components = sizes.size();
+  stats.component_sizes = build_histogram(sizes, false);
+
+  // Apply the reductions
+  stats.reduction = degree_reduce(graph);
+
+  return stats;
+}
+
+/**
+ * @brief Print the non-empty buckets of a histogram for humans
+ * @param output The output stream
+ * @param title The title
+ * @param buckets The buckets
+ */
+static void print_histogram(std::ostream &output, const std::string &title, const std::vector<histogram_bucket_s> &buckets)
+{
+  output << "  " << title << ":" << std::endl;
+  for (const auto &bucket : buckets)
+  {
+    if (bucket.count == 0)
+    {
+      continue;
+    }
+
+    const auto range = bucket.min == bucket.max ? std::to_string(bucket.min) : std::to_string(bucket.min) + "-" + std::to_string(bucket.max);
+    output << "    " << std::setw(13) << std::left << range << std::right << " " << bucket.count << std::endl;
+  }
+}
+
+void print_stats(std::ostream &output, const std::string &name, const graph_stats_s &stats)
+{
+  const auto &reduction = stats.reduction;
+
+  output << name << std::endl;
+  output << "  Vertices: " << stats.num_vertices << std::endl;
+  output << "  Edges: " << stats.num_edges << std::endl;
+  output << "  Self-loops: " << stats.self_loops << std::endl;
+  output << "  2-cycles: " << stats.two_cycles << std::endl;
+  output << "  Max in-degree: " << stats.max_in_degree << std::endl;
+  output << "  Max out-degree: " << stats.max_out_degree << std::endl;
+  print_histogram(output, "In-degrees", stats.in_degrees);
+  print_histogram(output, "Out-degrees", stats.out_degrees);
+  output << "  Strongly connected components: " << stats.num_components << " (" << stats.cyclic_components << " cyclic, largest " << stats.largest_component << " vertices)" << std::endl;
+  print_histogram(output, "Cyclic component sizes", stats.component_sizes);
+  output << "  Reductions: " << reduction.forced << " forced cuts, " << reduction.acyclic << " sources/sinks, " << reduction.bypassed << " bypassed (" << reduction.remaining_vertices << " vertices and " << reduction.remaining_edges << " edges left)" << std::endl;
+  output << "  Estimate: " << stats.exact_components << " exact components, " << stats.simulated_components << " simulated components (" << stats.simulated_vertices << " vertices, at most " << stats.max_walk_steps << " walk steps)" << std::endl;
+}
+
+/**
+ * @brief Print a JSON string
+ * @param output The output stream
+ * @param value The string
+ */
+static void print_json_string(std::ostream &output, const std::string &value)
+{
+  output << '"';
+  for (const auto character : value)
+  {
+    if (character == '"' || character == '\\')
+    {
+      output << '\\' << character;
+    }
+    else if ((unsigned char)character < 0x20)
+    {
+      output << "\\u" << std::hex << std::setw(4) << std::setfill('0') << (int)character << std::dec << std::setfill(' ');
+    }
+    else
+    {
+      output << character;
+    }
+  }
+
+  output << '"';
+}
+
+/**
+ * @brief Print a histogram as a JSON array
+ * @param output The output stream
+ * @param buckets The buckets
+ */
+static void print_json_histogram(std::ostream &output, const std::vector<histogram_bucket_s> &buckets)
+{
+  output << '[';
+  for (std::size_t bucket = 0; bucket < buckets.size(); bucket++)
+  {
+    output << (bucket == 0 ? "" : ",") << "{\"min\":" << buckets[bucket].min << ",\"max\":" << buckets[bucket].max << ",\"count\":" << buckets[bucket].count << '}';
+  }
+
+  output << ']';
+}
+
+void print_stats_json(std::ostream &output, const std::string &name, const graph_stats_s &stats)
+{
+  const auto &reduction = stats.reduction;
+
+  output << "{\"file\":";
+  print_json_string(output, name);
+  output << ",\"vertices\":" << stats.num_vertices << ",\"edges\":" << stats.num_edges << ",\"self_loops\":" << stats.self_loops << ",\"two_cycles\":" << stats.two_cycles;
+
+  output << ",\"in_degree\":{\"max\":" << stats.max_in_degree << ",\"histogram\":";
+  print_json_histogram(output, stats.in_degrees);
+  output << "},\"out_degree\":{\"max\":" << stats.max_out_degree << ",\"histogram\":";
+  print_json_histogram(output, stats.out_degrees);
+
+  output << "},\"components\":{\"count\":" << stats.num_components << ",\"cyclic\":" << stats.cyclic_components << ",\"largest\":" << stats.largest_component << ",\"histogram\":";
+  print_json_histogram(output, stats.component_sizes);
+
+  output << "},\"reductions\":{\"forced\":" << reduction.forced << ",\"acyclic\":" << reduction.acyclic << ",\"bypassed\":" << reduction.bypassed << ",\"remaining_vertices\":" << reduction.remaining_vertices << ",\"remaining_edges\":" << reduction.remaining_edges;
+  output << "},\"estimate\":{\"exact_components\":" << stats.exact_components << ",\"simulated_components\":" << stats.simulated_components << ",\"simulated_vertices\":" << stats.simulated_vertices << ",\"max_walk_steps\":" << stats.max_walk_steps << "}}" << std::endl;
+}
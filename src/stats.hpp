@@ -0,0 +1,147 @@
+#pragma once
+
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "csr.hpp"
+#include "degree.hpp"
+#include "solve.hpp"
+
+/**
+ * @brief Bucket of a power-of-two histogram
+ */
+struct histogram_bucket_s
+{
+  /**
+   * @brief The smallest value in the bucket
+   */
+  std::size_t min;
+
+  /**
+   * @brief The largest value in the bucket
+   */
+  std::size_t max;
+
+  /**
+   * @brief The number of values in the bucket
+   */
+  std::size_t count;
+};
+
+/**
+ * @brief Structure of a graph and the work the solver would do on it
+ */
+struct graph_stats_s
+{
+  /**
+   * @brief The number of vertices
+   */
+  std::size_t num_vertices;
+
+  /**
+   * @brief The number of edges
+   */
+  std::size_t num_edges;
+
+  /**
+   * @brief The number of vertices with a self-loop
+   */
+  std::size_t self_loops;
+
+  /**
+   * @brief The number of vertex pairs with an edge in each direction
+   */
+  std::size_t two_cycles;
+
+  /**
+   * @brief The largest in-degree
+   */
+  std::size_t max_in_degree;
+
+  /**
+   * @brief The largest out-degree
+   */
+  std::size_t max_out_degree;
+
+  /**
+   * @brief The number of vertices per in-degree bucket (0, 1, 2-3, 4-7, ...; up to the largest in-degree)
+   */
+  std::vector<histogram_bucket_s> in_degrees;
+
+  /**
+   * @brief The number of vertices per out-degree bucket (0, 1, 2-3, 4-7, ...; up to the largest out-degree)
+   */
+  std::vector<histogram_bucket_s> out_degrees;
+
+  /**
+   * @brief The number of strongly connected components
+   */
+  std::size_t num_components;
+
+  /**
+   * @brief The number of strongly connected components which contain a cycle
+   */
+  std::size_t cyclic_components;
+
+  /**
+   * @brief The number of vertices in the largest strongly connected component
+   */
+  std::size_t largest_component;
+
+  /**
+   * @brief The number of cyclic strongly connected components per size bucket (1, 2-3, 4-7, ...)
+   */
+  std::vector<histogram_bucket_s> component_sizes;
+
+  /**
+   * @brief The effect of the degree engine's reductions on the whole graph
+   */
+  degree_reduction_s reduction;
+
+  /**
+   * @brief The number of cyclic components at or below the exact threshold (Solved exactly unless the node limit is hit)
+   */
+  std::size_t exact_components;
+
+  /**
+   * @brief The number of cyclic components above the exact threshold (Simulated)
+   */
+  std::size_t simulated_components;
+
+  /**
+   * @brief The number of vertices in simulated components
+   */
+  std::size_t simulated_vertices;
+
+  /**
+   * @brief The most random walk steps the simulations take (Agents x steps x batches per simulated component, without
+   * early termination or burn-in)
+   */
+  std::size_t max_walk_steps;
+};
+
+/**
+ * @brief Profile a graph
+ * @param graph The graph
+ * @param options The solver options to estimate the work for
+ * @return The statistics
+ * @note Runs in O(|V| + |E| log |E|) apart from the reductions' bypasses
+ */
+graph_stats_s profile_graph(const csr_graph_s &graph, const solver_options_s &options);
+
+/**
+ * @brief Print the statistics for humans
+ * @param output The output stream
+ * @param name The name of the graph (Printed as a heading)
+ * @param stats The statistics
+ */
+void print_stats(std::ostream &output, const std::string &name, const graph_stats_s &stats);
+
+/**
+ * @brief Print the statistics as a single-line JSON object
+ * @param output The output stream
+ * @param name The name of the graph (The "file" field)
+ * @param stats The statistics
+ */
+void print_stats_json(std::ostream &output, const std::string &name, const graph_stats_s &stats);
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <vector>
+
+#include "stats.hpp"
+#include "test_graphs.hpp"
+
+/**
+ * @brief Get the counts of a histogram
+ * @param buckets The buckets
+ * @return The count of each bucket
+ */
+static std::vector<std::size_t> counts(const std::vector<histogram_bucket_s> &buckets)
+{
+  std::vector<std::size_t> result;
+  for (const auto &bucket : buckets)
+  {
+    result.push_back(bucket.count);
+  }
+
+  return result;
+}
+
+/**
+ * @brief Build a self-loop into a triangle with a 2-cycle and a sink hanging off it
+ * @return The compressed sparse row graph
+ */
+static csr_graph_s build_sample()
+{
+  return build_graph(5, {{1, 1}, {1, 2}, {2, 3}, {3, 2}, {3, 4}, {4, 2}, {2, 5}});
+}
+
+TEST(profile_graph, structure)
+{
+  // Profile the graph
+  auto options = solver_options_s{simulation_options_s{10, 20, 3, 0.0, 0, 0, 1}, 2, 1000};
+  const auto stats = profile_graph(build_sample(), options);
+
+  // Assert the counts
+  ASSERT_EQ(stats.num_vertices, 5);
+  ASSERT_EQ(stats.num_edges, 7);
+  ASSERT_EQ(stats.self_loops, 1);
+  ASSERT_EQ(stats.two_cycles, 1);
+  ASSERT_EQ(stats.max_in_degree, 3);
+  ASSERT_EQ(stats.max_out_degree, 2);
+
+  // Assert the histograms (0, 1, 2-3)
+  ASSERT_EQ(counts(stats.in_degrees), (std::vector<std::size_t>{0, 4, 1}));
+  ASSERT_EQ(counts(stats.out_degrees), (std::vector<std::size_t>{1, 1, 3}));
+  ASSERT_EQ(stats.out_degrees[2].min, 2);
+  ASSERT_EQ(stats.out_degrees[2].max, 3);
+
+  // Assert the components (1, 2-3)
+  ASSERT_EQ(stats.num_components, 3);
+  ASSERT_EQ(stats.cyclic_components, 2);
+  ASSERT_EQ(stats.largest_component, 3);
+  ASSERT_EQ(counts(stats.component_sizes), (std::vector<std::size_t>{1, 1}));
+  ASSERT_EQ(stats.component_sizes[0].min, 1);
+
+  // Assert the reductions and the estimate
+  ASSERT_EQ(stats.reduction.remaining_vertices, 0);
+  ASSERT_EQ(stats.exact_components, 1);
+  ASSERT_EQ(stats.simulated_components, 1);
+  ASSERT_EQ(stats.simulated_vertices, 3);
+  ASSERT_EQ(stats.max_walk_steps, 10 * 20 * 3);
+}
+
+TEST(print_stats_json, fields)
+{
+  // Profile the graph
+  const auto stats = profile_graph(build_sample(), solver_options_s{simulation_options_s{10, 20, 3, 0.0, 0, 0, 1}, 2, 1000});
+
+  std::ostringstream output;
+  print_stats_json(output, "a \"b\"\n.txt", stats);
+  const auto json = output.str();
+
+  // Assert the file name is escaped and the fields are present on one line
+  ASSERT_EQ(json.rfind("{\"file\":\"a \\\"b\\\"\\u000a.txt\",\"vertices\":5,\"edges\":7,\"self_loops\":1,\"two_cycles\":1,", 0), 0);
+  ASSERT_NE(json.find("\"components\":{\"count\":3,\"cyclic\":2,\"largest\":3,\"histogram\":[{\"min\":1,\"max\":1,\"count\":1},{\"min\":2,\"max\":3,\"count\":1}]}"), std::string::npos);
+  ASSERT_NE(json.find("\"max_walk_steps\":600}}"), std::string::npos);
+  ASSERT_EQ(json.find('\n'), json.size() - 1);
+}
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <algorithm>
+#include <fstream>
+#include <utility>
+#include <vector>
+
+#include "csr.hpp"
+#include "input.hpp"
+#include "random.hpp"
+#include "scc.hpp"
+
+/**
+ * @brief Build the compressed sparse row graph from an edge list (Shared by the tests)
+ * @param numVertices The number of vertices (Numbered 1 to numVertices)
+ * @param edges The edges (1-indexed)
+ * @return The compressed sparse row graph
+ */
+inline csr_graph_s build_graph(const std::size_t numVertices, const std::vector<std::pair<std::size_t, std::size_t>> &edges)
+{
+  graph_t graph;
+
+  std::vector<vertex_descriptor_t> vertices;
+  for (std::size_t number = 1; number <= numVertices; number++)
+  {
+    vertices.push_back(boost::add_vertex(vertex_properties_s{number}, graph));
+  }
+
+  for (const auto &[source, target] : edges)
+  {
+    boost::add_edge(vertices[source - 1], vertices[target - 1], graph);
+  }
+
+  ordered_vertex_descriptors_t indexToVertex;
+  return build_csr(graph, indexToVertex);
+}
+
+/**
+ * @brief Build the sample graph (A single strongly connected component)
+ * @return The compressed sparse row graph
+ */
+inline csr_graph_s build_sample_csr()
+{
+  std::ifstream file("test/0-sample-in.txt");
+
+  ordered_vertex_descriptors_t indexToVertex;
+  return build_csr(deserialize_input(file), indexToVertex);
+}
+
+/**
+ * @brief Build the compressed sparse row graph directly from 0-indexed edges (Without an adjacency list graph)
+ * @param numVertices The number of vertices (Numbered 1 to numVertices)
+ * @param edges The edges (Duplicates are removed)
+ * @return The compressed sparse row graph
+ */
+inline csr_graph_s build_direct(const std::size_t numVertices, std::vector<std::pair<csr_index_t, csr_index_t>> edges)
+{
+  csr_graph_s graph;
+  graph.numbers.resize(numVertices);
+  graph.out_offsets.assign(numVertices + 1, 0);
+  graph.in_offsets.assign(numVertices + 1, 0);
+
+  for (std::size_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    graph.numbers[vertex] = vertex + 1;
+  }
+
+  // Build the out-rows
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+  for (const auto &[source, target] : edges)
+  {
+    graph.out_offsets[source + 1]++;
+    graph.out_targets.push_back(target);
+  }
+
+  // Build the in-rows
+  std::sort(edges.begin(), edges.end(), [](const auto &a, const auto &b)
+            { return std::make_pair(a.second, a.first) < std::make_pair(b.second, b.first); });
+  for (const auto &[source, target] : edges)
+  {
+    graph.in_offsets[target + 1]++;
+    graph.in_sources.push_back(source);
+  }
+
+  for (std::size_t vertex = 0; vertex < numVertices; vertex++)
+  {
+    graph.out_offsets[vertex + 1] += graph.out_offsets[vertex];
+    graph.in_offsets[vertex + 1] += graph.in_offsets[vertex];
+  }
+
+  return graph;
+}
+
+/**
+ * @brief Build random 0-indexed edges (With duplicates and self-loops)
+ * @param numVertices The number of vertices
+ * @param numEdges The number of edges
+ * @param seed The random seed
+ * @return The edges
+ */
+inline std::vector<std::pair<csr_index_t, csr_index_t>> build_random_edges(const std::size_t numVertices, const std::size_t numEdges, const uint64_t seed)
+{
+  auto stream = make_random_stream(seed, numVertices, 0, 0);
+
+  std::vector<std::pair<csr_index_t, csr_index_t>> edges;
+  for (std::size_t edge = 0; edge < numEdges; edge++)
+  {
+    const auto source = bounded_random(next_random(stream), (uint32_t)numVertices);
+    const auto target = bounded_random(next_random(stream), (uint32_t)numVertices);
+    edges.emplace_back(source, target);
+  }
+
+  return edges;
+}
+
+/**
+ * @brief Build a random graph
+ * @param numVertices The number of vertices
+ * @param numEdges The number of edges (Before removing duplicates)
+ * @param seed The random seed
+ * @return The compressed sparse row graph
+ */
+inline csr_graph_s build_random(const std::size_t numVertices, const std::size_t numEdges, const uint64_t seed)
+{
+  return build_direct(numVertices, build_random_edges(numVertices, numEdges, seed));
+}
+
+/**
+ * @brief Build a random adjacency list graph (The same edges as build_random)
+ * @param numVertices The number of vertices (Numbered 1 to numVertices)
+ * @param numEdges The number of edges (Before removing duplicates)
+ * @param seed The random seed
+ * @return The graph
+ */
+inline graph_t build_random_graph(const std::size_t numVertices, const std::size_t numEdges, const uint64_t seed)
+{
+  graph_t graph;
+
+  std::vector<vertex_descriptor_t> vertices;
+  for (std::size_t number = 1; number <= numVertices; number++)
+  {
+    vertices.push_back(boost::add_vertex(vertex_properties_s{number}, graph));
+  }
+
+  for (const auto &[source, target] : build_random_edges(numVertices, numEdges, seed))
+  {
+    boost::add_edge(vertices[source], vertices[target], graph);
+  }
+
+  return graph;
+}
+
+/**
+ * @brief Build the largest strongly connected component of a random graph
+ * @param numVertices The number of vertices
+ * @param numEdges The number of edges
+ * @param seed The random seed
+ * @return The compressed sparse row graph of the component
+ */
+inline csr_graph_s build_random_component(const std::size_t numVertices, const std::size_t numEdges, const uint64_t seed)
+{
+  const auto csr = build_random(numVertices, numEdges, seed);
+  const auto decomposition = decompose(csr, 1, nullptr);
+
+  std::size_t largest = 0;
+  for (std::size_t component = 0; component < decomposition.num_components(); component++)
+  {
+    if (component_view_s{csr, decomposition, largest}.size() < component_view_s{csr, decomposition, component}.size())
+    {
+      largest = component;
+    }
+  }
+
+  return component_view_s{csr, decomposition, largest}.build_csr();
+}
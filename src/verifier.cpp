@@ -4,6 +4,7 @@
 
 #include "boost/graph/adjacency_list.hpp"
 #include "boost/program_options.hpp"
+#include "compression.hpp"
 #include "helpers.hpp"
 #include "input.hpp"
 #include "output.hpp"
@@ -47,28 +48,26 @@ int main(int argc, char *argv[])
   // Get the time
   auto startTime = std::chrono::steady_clock::now();
 
-  // Open the files
-  std::ifstream input;
-  input.open(inputFilename);
+  // Open the files (Compressed files are detected and decompressed automatically)
+  const auto input = open_input(inputFilename);
 
-  if (!input.is_open())
+  if (input == nullptr)
   {
     std::cerr << "Error: failed to open input file: " << inputFilename << std::endl;
     return 1;
   }
 
-  std::ifstream output;
-  output.open(outputFilename);
+  const auto output = open_input(outputFilename);
 
-  if (!output.is_open())
+  if (output == nullptr)
   {
     std::cerr << "Error: failed to open output file:" << outputFilename << std::endl;
     return 1;
   }
 
   // Deserialize the input and output
-  auto graph = deserialize_input(input);
-  const auto vertices = deserialize_output(output);
+  auto graph = deserialize_input(*input);
+  const auto vertices = deserialize_output(*output);
 
   // Remove vertices (See https://stackoverflow.com/a/7210986)
   vertex_iterator_t start, end, next;
@@ -0,0 +1,366 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include "random.hpp"
+#include "walker.hpp"
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+
+/**
+ * @brief Whether the AVX2 kernel is compiled (It is selected at runtime based on the CPU)
+ */
+#define WALKER_AVX2 1
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+/**
+ * @brief Prefetch the cache line containing the address
+ */
+#define WALKER_PREFETCH(address) __builtin_prefetch(address)
+#else
+#define WALKER_PREFETCH(address)
+#endif
+
+/**
+ * @brief The number of lanes in an AVX2 vector of 32-bit integers
+ */
+#define WALKER_LANES 8
+
+/**
+ * @brief Prefetch the out-vertex row of a vertex
+ * @param graph The graph
+ * @param vertex The vertex index
+ */
+template <typename Index>
+static inline void prefetch_row(const basic_csr_graph_s<Index> &graph, const std::size_t vertex)
+{
+  WALKER_PREFETCH(graph.out_targets.data() + graph.out_offsets[vertex]);
+}
+
+/**
+ * @brief Get the teleport threshold (A step teleports if the low WALKER_TELEPORT_BITS bits of its word are below it)
+ * @param options The simulation options
+ * @return The threshold
+ */
+static inline uint32_t teleport_threshold(const simulation_options_s &options)
+{
+  return (uint32_t)std::lround(std::clamp(options.teleport, 0.0, 1.0) * (1 << WALKER_TELEPORT_BITS));
+}
+
+/**
+ * @brief Get the stratified start vertex of an agent
+ * @param options The simulation options
+ * @param batch The batch index
+ * @param agent The agent index
+ * @param numVertices The number of vertices
+ * @return The start vertex
+ */
+static inline uint32_t stratified_start(const simulation_options_s &options, const std::size_t batch, const std::size_t agent, const uint32_t numVertices)
+{
+  return (uint32_t)((batch * options.agents + agent) % numVertices);
+}
+
+template <typename Index>
+void walk_agents_scalar(const basic_csr_graph_s<Index> &graph, const simulation_options_s &options, const std::size_t batch, const std::size_t first_agent, const std::size_t last_agent, std::size_t *traffic, const csr_index_t *labels)
+{
+  const auto numVertices = (uint32_t)graph.num_vertices();
+  const auto *offsets = graph.out_offsets.data();
+  const auto *targets = graph.out_targets.data();
+
+  const auto teleportThreshold = teleport_threshold(options);
+  const auto teleportMask = ((uint32_t)1 << WALKER_TELEPORT_BITS) - 1;
+
+  std::array<random_stream_s, WALKER_BLOCK_AGENTS> streams;
+  std::array<uint32_t, WALKER_BLOCK_AGENTS> flips;
+  std::array<Index, WALKER_BLOCK_AGENTS> current;
+
+  for (std::size_t blockStart = first_agent; blockStart < last_agent; blockStart += WALKER_BLOCK_AGENTS)
+  {
+    const auto blockAgents = std::min<std::size_t>(WALKER_BLOCK_AGENTS, last_agent - blockStart);
+
+    // Initialize the agents' streams (Odd antithetic agents complement the preceding agent's words) and start vertices
+    for (std::size_t lane = 0; lane < blockAgents; lane++)
+    {
+      const auto agent = blockStart + lane;
+      streams[lane] = make_random_stream(options.seed, options.component, batch, options.antithetic ? agent & ~(std::size_t)1 : agent);
+      flips[lane] = options.antithetic && (agent & 1) ? ~(uint32_t)0 : 0;
+
+      const auto word = next_random(streams[lane]) ^ flips[lane];
+      const auto start = options.start_mode == start_mode_e::stratified ? stratified_start(options, batch, agent, numVertices) : bounded_random(word, numVertices);
+      current[lane] = (Index)(labels ? labels[start] : start);
+    }
+
+    // Advance every agent in the block by one step at a time (Burn-in steps are walked but not counted)
+    for (std::size_t step = 0; step < options.burn_in + options.steps; step++)
+    {
+      for (std::size_t lane = 0; lane < blockAgents; lane++)
+      {
+        // Get the next vertex (A word is always consumed, even for a single out-edge, to keep the streams aligned)
+        const auto vertex = current[lane];
+        const auto word = next_random(streams[lane]) ^ flips[lane];
+        const auto outDegree = (uint32_t)(offsets[vertex + 1] - offsets[vertex]);
+        const auto teleportTarget = bounded_random(word, numVertices);
+        const auto nextVertex = (word & teleportMask) < teleportThreshold ? (Index)(labels ? labels[teleportTarget] : teleportTarget) : targets[offsets[vertex] + bounded_random(word, outDegree)];
+
+        // Start loading the row needed by the next step while the other agents are advanced
+        prefetch_row(graph, nextVertex);
+
+        // Update the traffic
+        if (options.burn_in <= step)
+        {
+          traffic[nextVertex]++;
+        }
+
+        // Move to the next vertex
+        current[lane] = nextVertex;
+      }
+    }
+  }
+}
+
+#ifdef WALKER_AVX2
+/**
+ * @brief Multiply the 32-bit lanes of two vectors into 64-bit products
+ * @param a The first vector
+ * @param b The second vector
+ * @param high The high halves of the products (Output)
+ * @return The low halves of the products
+ */
+__attribute__((target("avx2"))) static inline __m256i multiply_high_low(const __m256i a, const __m256i b, __m256i &high)
+{
+  const auto even = _mm256_mul_epu32(a, b);
+  const auto odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+
+  high = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+  return _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+}
+
+/**
+ * @brief Run the Philox4x32-10 bijection on eight counters at once (Lane-wise identical to philox4x32)
+ * @param counter The counters (Overwritten with the random blocks)
+ * @param key The key
+ */
+__attribute__((target("avx2"))) static inline void philox4x32_avx2(__m256i counter[4], const philox_key_t key)
+{
+  auto key0 = _mm256_set1_epi32((int)key[0]);
+  auto key1 = _mm256_set1_epi32((int)key[1]);
+  const auto multiplier0 = _mm256_set1_epi32((int)PHILOX_M0);
+  const auto multiplier1 = _mm256_set1_epi32((int)PHILOX_M1);
+  const auto weyl0 = _mm256_set1_epi32((int)PHILOX_W0);
+  const auto weyl1 = _mm256_set1_epi32((int)PHILOX_W1);
+
+  for (std::size_t round = 0; round < PHILOX_ROUNDS; round++)
+  {
+    // Multiply
+    __m256i high0, high1;
+    const auto low0 = multiply_high_low(counter[0], multiplier0, high0);
+    const auto low1 = multiply_high_low(counter[2], multiplier1, high1);
+
+    // Mix
+    counter[0] = _mm256_xor_si256(_mm256_xor_si256(high1, counter[1]), key0);
+    counter[1] = low1;
+    counter[2] = _mm256_xor_si256(_mm256_xor_si256(high0, counter[3]), key1);
+    counter[3] = low0;
+
+    // Bump the key
+    key0 = _mm256_add_epi32(key0, weyl0);
+    key1 = _mm256_add_epi32(key1, weyl1);
+  }
+}
+
+/**
+ * @brief Generate the next block of random words for vectors of agents
+ * @param agents The stream agent index of each lane
+ * @param flips The mask each lane's words are XORed with (All ones for odd antithetic agents)
+ * @param vectors The number of vectors
+ * @param options The simulation options
+ * @param batch The batch index
+ * @param blockIndex The index of the block within each stream
+ * @param words The four words of each lane (Output)
+ */
+__attribute__((target("avx2"))) static inline void refill_words(const __m256i *agents, const __m256i *flips, const std::size_t vectors, const simulation_options_s &options, const std::size_t batch, const uint32_t blockIndex, __m256i (*words)[4])
+{
+  const philox_key_t key = {(uint32_t)options.seed, (uint32_t)(options.seed >> 32)};
+
+  for (std::size_t vector = 0; vector < vectors; vector++)
+  {
+    words[vector][0] = _mm256_set1_epi32((int)blockIndex);
+    words[vector][1] = agents[vector];
+    words[vector][2] = _mm256_set1_epi32((int)batch);
+    words[vector][3] = _mm256_set1_epi32((int)options.component);
+    philox4x32_avx2(words[vector], key);
+
+    for (auto &word : words[vector])
+    {
+      word = _mm256_xor_si256(word, flips[vector]);
+    }
+  }
+}
+
+/**
+ * @brief Gather the targets of eight edges
+ * @param targets The out-vertices of every vertex
+ * @param edges The edge of each lane
+ * @return The target of each lane
+ */
+template <typename Index>
+__attribute__((target("avx2"))) static inline __m256i gather_targets(const Index *targets, const __m256i edges)
+{
+  if constexpr (sizeof(Index) == sizeof(uint32_t))
+  {
+    return _mm256_i32gather_epi32((const int *)targets, edges, 4);
+  }
+  else
+  {
+    // Load narrow targets lane by lane (A 32-bit gather could read past the end of the array)
+    alignas(32) uint32_t lanes[WALKER_LANES];
+    _mm256_store_si256((__m256i *)lanes, edges);
+    return _mm256_setr_epi32(targets[lanes[0]], targets[lanes[1]], targets[lanes[2]], targets[lanes[3]], targets[lanes[4]], targets[lanes[5]], targets[lanes[6]], targets[lanes[7]]);
+  }
+}
+
+/**
+ * @brief Walk a contiguous range of agents for one batch using AVX2 gathers
+ * @param graph The strongly connected component
+ * @param options The simulation options
+ * @param batch The batch index
+ * @param first_agent The first agent (inclusive)
+ * @param last_agent The last agent (exclusive)
+ * @param traffic The traffic of each vertex index to accumulate into
+ * @param labels The index walked for each uniformly drawn start or teleport vertex (Null for the identity)
+ */
+template <typename Index>
+__attribute__((target("avx2"))) static void walk_agents_avx2(const basic_csr_graph_s<Index> &graph, const simulation_options_s &options, const std::size_t batch, const std::size_t first_agent, const std::size_t last_agent, std::size_t *traffic, const csr_index_t *labels)
+{
+  static_assert(sizeof(csr_offset_t<Index>) == sizeof(uint32_t), "The AVX2 walker gathers 32-bit offsets");
+
+  constexpr std::size_t VECTORS = WALKER_BLOCK_AGENTS / WALKER_LANES;
+  const auto *offsets = (const int *)graph.out_offsets.data();
+  const auto *targets = graph.out_targets.data();
+  const auto numVertices = _mm256_set1_epi32((int)graph.num_vertices());
+  const auto one = _mm256_set1_epi32(1);
+  const auto laneOffsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+
+  const auto teleportThreshold = teleport_threshold(options);
+  const auto teleportThresholds = _mm256_set1_epi32((int)teleportThreshold);
+  const auto teleportMask = _mm256_set1_epi32((1 << WALKER_TELEPORT_BITS) - 1);
+  const auto evenMask = _mm256_set1_epi32(~1);
+
+  // Agent state (Structure of arrays: lane l of vector v is agent blockStart + v * WALKER_LANES + l)
+  __m256i agents[VECTORS];
+  __m256i flips[VECTORS];
+  __m256i current[VECTORS];
+  __m256i words[VECTORS][4];
+  alignas(32) uint32_t nextVertices[WALKER_LANES];
+
+  for (std::size_t blockStart = first_agent; blockStart < last_agent; blockStart += WALKER_BLOCK_AGENTS)
+  {
+    const auto blockAgents = std::min<std::size_t>(WALKER_BLOCK_AGENTS, last_agent - blockStart);
+    const auto vectors = (blockAgents + WALKER_LANES - 1) / WALKER_LANES;
+
+    // Initialize the agents' streams (Lanes past the last agent are walked but not counted)
+    for (std::size_t vector = 0; vector < vectors; vector++)
+    {
+      const auto lanes = _mm256_add_epi32(_mm256_set1_epi32((int)(blockStart + vector * WALKER_LANES)), laneOffsets);
+      agents[vector] = options.antithetic ? _mm256_and_si256(lanes, evenMask) : lanes;
+      flips[vector] = options.antithetic ? _mm256_sub_epi32(_mm256_setzero_si256(), _mm256_and_si256(lanes, one)) : _mm256_setzero_si256();
+    }
+
+    // Pick the start vertices
+    refill_words(agents, flips, vectors, options, batch, 0, words);
+    for (std::size_t vector = 0; vector < vectors; vector++)
+    {
+      if (options.start_mode == start_mode_e::stratified)
+      {
+        for (std::size_t lane = 0; lane < WALKER_LANES; lane++)
+        {
+          nextVertices[lane] = stratified_start(options, batch, blockStart + vector * WALKER_LANES + lane, (uint32_t)graph.num_vertices());
+        }
+
+        current[vector] = _mm256_load_si256((const __m256i *)nextVertices);
+      }
+      else
+      {
+        multiply_high_low(words[vector][0], numVertices, current[vector]);
+      }
+
+      if (labels)
+      {
+        current[vector] = gather_targets(labels, current[vector]);
+      }
+    }
+
+    // Advance every agent in the block by one step at a time (Burn-in steps are walked but not counted)
+    for (std::size_t step = 0; step < options.burn_in + options.steps; step++)
+    {
+      // Word 0 of each stream is the start vertex, so step s consumes word s + 1
+      const auto draw = step + 1;
+      if (draw % 4 == 0)
+      {
+        refill_words(agents, flips, vectors, options, batch, (uint32_t)(draw / 4), words);
+      }
+
+      for (std::size_t vector = 0; vector < vectors; vector++)
+      {
+        // Gather the rows of the current vertices
+        const auto rowStart = _mm256_i32gather_epi32(offsets, current[vector], 4);
+        const auto rowEnd = _mm256_i32gather_epi32(offsets, _mm256_add_epi32(current[vector], one), 4);
+        const auto outDegree = _mm256_sub_epi32(rowEnd, rowStart);
+
+        // Pick the out-edges and gather the next vertices
+        const auto word = words[vector][draw % 4];
+        __m256i choice;
+        multiply_high_low(word, outDegree, choice);
+        current[vector] = gather_targets(targets, _mm256_add_epi32(rowStart, choice));
+
+        // Replace the next vertices of teleporting lanes with uniformly random ones
+        if (teleportThreshold != 0)
+        {
+          __m256i teleportTargets;
+          multiply_high_low(word, numVertices, teleportTargets);
+          if (labels)
+          {
+            teleportTargets = gather_targets(labels, teleportTargets);
+          }
+
+          const auto teleporting = _mm256_cmpgt_epi32(teleportThresholds, _mm256_and_si256(word, teleportMask));
+          current[vector] = _mm256_blendv_epi8(current[vector], teleportTargets, teleporting);
+        }
+
+        // Update the traffic and start loading the rows needed by the next step
+        _mm256_store_si256((__m256i *)nextVertices, current[vector]);
+        const auto lanes = std::min<std::size_t>(WALKER_LANES, blockAgents - vector * WALKER_LANES);
+        for (std::size_t lane = 0; lane < lanes; lane++)
+        {
+          prefetch_row(graph, nextVertices[lane]);
+          if (options.burn_in <= step)
+          {
+            traffic[nextVertices[lane]]++;
+          }
+        }
+      }
+    }
+  }
+}
+#endif
+
+template <typename Index>
+void walk_agents(const basic_csr_graph_s<Index> &graph, const simulation_options_s &options, const std::size_t batch, const std::size_t first_agent, const std::size_t last_agent, std::size_t *traffic, const csr_index_t *labels)
+{
+#ifdef WALKER_AVX2
+  if (__builtin_cpu_supports("avx2"))
+  {
+    walk_agents_avx2(graph, options, batch, first_agent, last_agent, traffic, labels);
+    return;
+  }
+#endif
+
+  walk_agents_scalar(graph, options, batch, first_agent, last_agent, traffic, labels);
+}
+
+template void walk_agents_scalar<uint16_t>(const basic_csr_graph_s<uint16_t> &, const simulation_options_s &, const std::size_t, const std::size_t, const std::size_t, std::size_t *, const csr_index_t *);
+template void walk_agents_scalar<uint32_t>(const basic_csr_graph_s<uint32_t> &, const simulation_options_s &, const std::size_t, const std::size_t, const std::size_t, std::size_t *, const csr_index_t *);
+template void walk_agents<uint16_t>(const basic_csr_graph_s<uint16_t> &, const simulation_options_s &, const std::size_t, const std::size_t, const std::size_t, std::size_t *, const csr_index_t *);
+template void walk_agents<uint32_t>(const basic_csr_graph_s<uint32_t> &, const simulation_options_s &, const std::size_t, const std::size_t, const std::size_t, std::size_t *, const csr_index_t *);
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+
+#include "csr.hpp"
+#include "simulation.hpp"
+
+/**
+ * @brief The number of agents the walker advances in lockstep (Enough independent walks to overlap many cache misses)
+ */
+#define WALKER_BLOCK_AGENTS 64
+
+/**
+ * @brief The number of low bits of each step's random word which decide whether the step teleports
+ */
+#define WALKER_TELEPORT_BITS 16
+
+/**
+ * @brief Walk a contiguous range of agents for one batch, advancing a block of agents one step at a time
+ * @param graph The strongly connected component
+ * @param options The simulation options
+ * @param batch The batch index
+ * @param first_agent The first agent (inclusive)
+ * @param last_agent The last agent (exclusive)
+ * @param traffic The traffic of each vertex index to accumulate into
+ * @param labels The index walked for each uniformly drawn start or teleport vertex (Null for the identity, so that a
+ * relabeled copy whose rows keep their edge order is walked along the same paths as the original)
+ * @note Uses AVX2 gathers and vectorized random streams when the CPU supports them; the result is bit-identical to
+ * walk_agents_scalar. Instantiated for 16-bit and 32-bit vertex indices (Narrower indices halve the out-vertex array,
+ * which the walk reads at random)
+ */
+template <typename Index>
+void walk_agents(const basic_csr_graph_s<Index> &graph, const simulation_options_s &options, const std::size_t batch, const std::size_t first_agent, const std::size_t last_agent, std::size_t *traffic, const csr_index_t *labels = nullptr);
+
+/**
+ * @brief Walk a contiguous range of agents for one batch without SIMD (Reference implementation)
+ * @param graph The strongly connected component
+ * @param options The simulation options
+ * @param batch The batch index
+ * @param first_agent The first agent (inclusive)
+ * @param last_agent The last agent (exclusive)
+ * @param traffic The traffic of each vertex index to accumulate into
+ * @param labels The index walked for each uniformly drawn start or teleport vertex (Null for the identity)
+ */
+template <typename Index>
+void walk_agents_scalar(const basic_csr_graph_s<Index> &graph, const simulation_options_s &options, const std::size_t batch, const std::size_t first_agent, const std::size_t last_agent, std::size_t *traffic, const csr_index_t *labels = nullptr);
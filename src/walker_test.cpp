@@ -0,0 +1,179 @@
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <vector>
+
+#include "random.hpp"
+#include "walker.hpp"
+
+/**
+ * @brief Build a strongly connected graph with irregular out-degrees (A ring plus random chords)
+ * @param numVertices The number of vertices
+ * @param chords The number of chords
+ * @return The compressed sparse row graph
+ */
+static csr_graph_s build_ring_with_chords(const std::size_t numVertices, const std::size_t chords)
+{
+  graph_t graph;
+
+  std::vector<vertex_descriptor_t> vertices;
+  for (std::size_t number = 1; number <= numVertices; number++)
+  {
+    vertices.push_back(boost::add_vertex(vertex_properties_s{number}, graph));
+  }
+
+  for (std::size_t index = 0; index < numVertices; index++)
+  {
+    boost::add_edge(vertices[index], vertices[(index + 1) % numVertices], graph);
+  }
+
+  auto stream = make_random_stream(99, 0, 0, 0);
+  for (std::size_t chord = 0; chord < chords; chord++)
+  {
+    const auto source = bounded_random(next_random(stream), (uint32_t)numVertices);
+    const auto target = bounded_random(next_random(stream), (uint32_t)numVertices);
+    boost::add_edge(vertices[source], vertices[target], graph);
+  }
+
+  ordered_vertex_descriptors_t indexToVertex;
+  return build_csr(graph, indexToVertex);
+}
+
+TEST(walk_agents, matches_scalar)
+{
+  // Build the graph
+  const auto graph = build_ring_with_chords(97, 400);
+
+  // Walk a range of agents which does not fill the last block or vector
+  for (std::size_t batch = 0; batch < 3; batch++)
+  {
+    const simulation_options_s options{0, 37, 3, 0.0, 12345, 17, 1};
+
+    std::vector<std::size_t> expected(graph.num_vertices(), 0);
+    walk_agents_scalar(graph, options, batch, 3, 150, expected.data());
+
+    std::vector<std::size_t> traffic(graph.num_vertices(), 0);
+    walk_agents(graph, options, batch, 3, 150, traffic.data());
+
+    // Assert the traffic
+    ASSERT_EQ(traffic, expected);
+  }
+}
+
+TEST(walk_agents, matches_scalar_labels)
+{
+  // Build the graph and a labeling (Reversed indices)
+  const auto graph = build_ring_with_chords(97, 400);
+  std::vector<csr_index_t> labels(graph.num_vertices());
+  std::iota(labels.rbegin(), labels.rend(), 0);
+
+  // Walk agents which start and teleport through the labeling
+  simulation_options_s options{0, 37, 3, 0.0, 12345, 17, 1};
+  options.teleport = 0.25;
+
+  std::vector<std::size_t> expected(graph.num_vertices(), 0);
+  walk_agents_scalar(graph, options, 1, 3, 150, expected.data(), labels.data());
+
+  std::vector<std::size_t> traffic(graph.num_vertices(), 0);
+  walk_agents(graph, options, 1, 3, 150, traffic.data(), labels.data());
+
+  // Assert the traffic
+  ASSERT_EQ(traffic, expected);
+}
+
+TEST(walk_agents, matches_single_agent)
+{
+  // Build the graph
+  const auto graph = build_ring_with_chords(31, 50);
+  const simulation_options_s options{0, 21, 1, 0.0, 7, 0, 1};
+
+  // Walk the agents together
+  std::vector<std::size_t> together(graph.num_vertices(), 0);
+  walk_agents(graph, options, 0, 0, 70, together.data());
+
+  // Walk the agents one at a time
+  std::vector<std::size_t> separately(graph.num_vertices(), 0);
+  for (std::size_t agent = 0; agent < 70; agent++)
+  {
+    walk_agents(graph, options, 0, agent, agent + 1, separately.data());
+  }
+
+  // Assert the traffic
+  ASSERT_EQ(together, separately);
+}
+
+TEST(walk_agents, matches_narrow)
+{
+  // Build the graph and narrow its indices
+  const auto graph = build_ring_with_chords(97, 400);
+  const auto narrow = convert_csr<uint16_t>(graph);
+  const simulation_options_s options{0, 37, 3, 0.0, 12345, 17, 1};
+
+  // Walk the agents on both graphs
+  std::vector<std::size_t> expected(graph.num_vertices(), 0);
+  walk_agents(graph, options, 1, 3, 150, expected.data());
+
+  std::vector<std::size_t> traffic(graph.num_vertices(), 0);
+  walk_agents(narrow, options, 1, 3, 150, traffic.data());
+
+  std::vector<std::size_t> scalar(graph.num_vertices(), 0);
+  walk_agents_scalar(narrow, options, 1, 3, 150, scalar.data());
+
+  // Assert the traffic
+  ASSERT_EQ(traffic, expected);
+  ASSERT_EQ(scalar, expected);
+}
+
+TEST(walk_agents, sampling_matches_scalar)
+{
+  // Build the graph
+  const auto graph = build_ring_with_chords(97, 400);
+  const auto narrow = convert_csr<uint16_t>(graph);
+
+  // Walk with every combination of the sampling options
+  for (const auto startMode : {start_mode_e::uniform, start_mode_e::stratified})
+  {
+    for (const bool antithetic : {false, true})
+    {
+      simulation_options_s options{300, 37, 3, 0.0, 12345, 17, 1};
+      options.start_mode = startMode;
+      options.burn_in = 5;
+      options.teleport = 0.2;
+      options.antithetic = antithetic;
+
+      std::vector<std::size_t> expected(graph.num_vertices(), 0);
+      walk_agents_scalar(graph, options, 2, 3, 150, expected.data());
+
+      std::vector<std::size_t> traffic(graph.num_vertices(), 0);
+      walk_agents(graph, options, 2, 3, 150, traffic.data());
+
+      std::vector<std::size_t> narrowTraffic(graph.num_vertices(), 0);
+      walk_agents(narrow, options, 2, 3, 150, narrowTraffic.data());
+
+      // Assert the traffic (Burn-in steps are not counted)
+      ASSERT_EQ(traffic, expected);
+      ASSERT_EQ(narrowTraffic, expected);
+      ASSERT_EQ(std::accumulate(traffic.begin(), traffic.end(), (std::size_t)0), 147 * 37);
+    }
+  }
+}
+
+TEST(walk_agents, antithetic_pairs)
+{
+  // Build a ring (So an agent's single step counts the vertex after its start vertex)
+  const auto graph = build_ring_with_chords(31, 0);
+  simulation_options_s options{0, 1, 1, 0.0, 7, 0, 1};
+  options.antithetic = true;
+
+  // Walk an even agent and its odd partner separately
+  std::vector<std::size_t> even(graph.num_vertices(), 0);
+  walk_agents(graph, options, 0, 10, 11, even.data());
+
+  std::vector<std::size_t> odd(graph.num_vertices(), 0);
+  walk_agents(graph, options, 0, 11, 12, odd.data());
+
+  // Assert the partner starts from the mirrored vertex (Its start word is complemented)
+  const auto evenVertex = std::find(even.begin(), even.end(), 1) - even.begin();
+  const auto oddVertex = std::find(odd.begin(), odd.end(), 1) - odd.begin();
+  ASSERT_EQ((evenVertex - 1 + 31) % 31 + (oddVertex - 1 + 31) % 31, 30);
+}